@@ -28,6 +28,7 @@
 
 #include "sx_node.hpp"
 #include "serializing_stream.hpp"
+#include "global_options.hpp"
 
 /// \cond INTERNAL
 namespace casadi {
@@ -45,7 +46,7 @@ class BinarySX : public SXNode {
 
         \identifier{116} */
     BinarySX(unsigned char op, const SXElem& dep0, const SXElem& dep1) :
-        op_(op), dep0_(dep0), dep1_(dep1) {}
+        op_(op), cached_(false), dep0_(dep0), dep1_(dep1) {}
 
   public:
 
@@ -60,6 +61,19 @@ class BinarySX : public SXNode {
         double ret_val;
         casadi_math<double>::fun(op, dep0_val, dep1_val, ret_val);
         return ret_val;
+      } else if (GlobalOptions::hash_consing) {
+        // Reuse a structurally identical node, if any
+        SXNodeKey key = {op, dep0.get(), dep1.get()};
+        auto it = cached_nodes_.find(key);
+        if (it==cached_nodes_.end() && operation_checker<CommChecker>(op)) {
+          it = cached_nodes_.find(SXNodeKey{op, dep1.get(), dep0.get()});
+        }
+        if (it!=cached_nodes_.end()) return SXElem::create(it->second);
+        // Allocate and add to table
+        BinarySX* n = new BinarySX(op, dep0, dep1);
+        n->cached_ = true;
+        cached_nodes_.insert(std::make_pair(key, n));
+        return SXElem::create(n);
       } else {
         // Expression containing free variables
         return SXElem::create(new BinarySX(op, dep0, dep1));
@@ -73,6 +87,7 @@ class BinarySX : public SXNode {
 
         \identifier{118} */
     ~BinarySX() override {
+      uncache();
       safe_delete(dep0_.assignNoDelete(casadi_limits<SXElem>::nan));
       safe_delete(dep1_.assignNoDelete(casadi_limits<SXElem>::nan));
     }
@@ -80,6 +95,14 @@ class BinarySX : public SXNode {
     // Class name
     std::string class_name() const override {return "BinarySX";}
 
+    void uncache() override {
+      if (cached_) {
+        size_t num_erased = cached_nodes_.erase(SXNodeKey{op_, dep0_.get(), dep1_.get()});
+        casadi_assert_dev(num_erased==1);
+        cached_ = false;
+      }
+    }
+
     bool is_smooth() const override { return operation_checker<SmoothChecker>(op_);}
 
     bool is_op(casadi_int op) const override { return op_==op; }
@@ -127,6 +150,9 @@ class BinarySX : public SXNode {
         \identifier{11e} */
     unsigned char op_;
 
+    /// Is the node in the hash-consing table
+    bool cached_;
+
     /** \brief  The dependencies of the node
 
         \identifier{11f} */
@@ -146,6 +172,13 @@ class BinarySX : public SXNode {
       s.unpack("UnarySX::dep1", dep1);
       return new BinarySX(op, dep0, dep1);
     }
+
+  protected:
+    /** \brief Hash-consing table of binary nodes currently allocated
+
+     * (storage is allocated for it in sx_elem.cpp)
+     */
+    static SXNodeTable<BinarySX> cached_nodes_;
 };
 
 } // namespace casadi
@@ -1401,6 +1401,10 @@ namespace casadi {
     case AUX_LDL:
       this->auxiliaries << sanitize_source(casadi_ldl_str, inst);
       break;
+    case AUX_BLOCKTRIDIAG:
+      add_auxiliary(AUX_FABS);
+      this->auxiliaries << sanitize_source(casadi_blocktridiag_str, inst);
+      break;
     case AUX_NEWTON:
       add_auxiliary(AUX_COPY);
       add_auxiliary(AUX_AXPY);
@@ -2283,6 +2287,16 @@ namespace casadi {
            + d + ", " + p + ", " + w + ");";
   }
 
+  std::string CodeGenerator::
+  ldl_super(const std::string& sp_a, const std::string& a,
+            const std::string& sn, const std::string& lmap,
+            const std::string& lt, const std::string& d,
+            const std::string& p, const std::string& iw, const std::string& w) {
+    add_auxiliary(CodeGenerator::AUX_LDL);
+    return "casadi_ldl_super(" + sp_a + ", " + a + ", " + sn + ", " + lmap + ", "
+           + lt + ", " + d + ", " + p + ", " + iw + ", " + w + ");";
+  }
+
   std::string CodeGenerator::
   ldl_solve(const std::string& x, casadi_int nrhs,
     const std::string& sp_lt, const std::string& lt, const std::string& d,
@@ -2292,6 +2306,24 @@ namespace casadi {
            + lt + ", " + d + ", " + p + ", " + w + ");";
   }
 
+  std::string CodeGenerator::
+  blocktridiag(const std::string& sp_a, const std::string& a, const std::string& amap,
+               const std::string& blk, casadi_int nb, const std::string& f,
+               const std::string& ipiv) {
+    add_auxiliary(CodeGenerator::AUX_BLOCKTRIDIAG);
+    return "casadi_blocktridiag(" + sp_a + ", " + a + ", " + amap + ", " + blk + ", "
+           + str(nb) + ", " + f + ", " + ipiv + ");";
+  }
+
+  std::string CodeGenerator::
+  blocktridiag_solve(const std::string& x, casadi_int nrhs, bool tr,
+                     const std::string& blk, casadi_int nb,
+                     const std::string& f, const std::string& ipiv) {
+    add_auxiliary(CodeGenerator::AUX_BLOCKTRIDIAG);
+    return "casadi_blocktridiag_solve(" + x + ", " + str(nrhs) + ", " + (tr ? "1" : "0") + ", "
+           + blk + ", " + str(nb) + ", " + f + ", " + ipiv + ");";
+  }
+
   std::string CodeGenerator::
   fmax(const std::string& x, const std::string& y) {
     add_auxiliary(CodeGenerator::AUX_FMAX);
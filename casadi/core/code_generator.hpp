@@ -406,6 +406,13 @@ namespace casadi {
                    const std::string& d, const std::string& p,
                    const std::string& w);
 
+    /** \brief Supernodal LDL factorization */
+    std::string ldl_super(const std::string& sp_a, const std::string& a,
+                          const std::string& sn, const std::string& lmap,
+                          const std::string& lt, const std::string& d,
+                          const std::string& p, const std::string& iw,
+                          const std::string& w);
+
     /** \brief LDL solve
 
         \identifier{t3} */
@@ -414,6 +421,16 @@ namespace casadi {
                          const std::string& d, const std::string& p,
                          const std::string& w);
 
+    /** \brief Block tridiagonal LU factorization */
+    std::string blocktridiag(const std::string& sp_a, const std::string& a,
+                             const std::string& amap, const std::string& blk,
+                             casadi_int nb, const std::string& f, const std::string& ipiv);
+
+    /** \brief Block tridiagonal solve */
+    std::string blocktridiag_solve(const std::string& x, casadi_int nrhs, bool tr,
+                                   const std::string& blk, casadi_int nb,
+                                   const std::string& f, const std::string& ipiv);
+
     /** \brief fmax
 
         \identifier{t4} */
@@ -578,6 +595,7 @@ namespace casadi {
       AUX_SQPMETHOD,
       AUX_FEASIBLESQPMETHOD,
       AUX_LDL,
+      AUX_BLOCKTRIDIAG,
       AUX_NEWTON,
       AUX_TO_DOUBLE,
       AUX_TO_INT,
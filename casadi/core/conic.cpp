@@ -397,7 +397,18 @@ namespace casadi {
         "Indicates which of the variables are discrete, i.e. integer-valued"}},
       {"print_problem",
        {OT_BOOL,
-        "Print a numeric description of the problem"}}
+        "Print a numeric description of the problem"}},
+      {"presolve",
+       {OT_BOOL,
+        "Remove fixed variables, empty, singleton and duplicate constraints and "
+        "dominated constraint bounds before each solve. The reduced problem is solved "
+        "by the same plugin, with the remaining options. An explicit stage structure "
+        "(N, nx, nu, ng) is not passed on, the solver detects the structure of the "
+        "reduced problem instead. Cannot be combined with SOS constraints [default: false]"}},
+      {"presolve_max_solvers",
+       {OT_INT,
+        "Maximum number of solvers for reduced problems kept by the presolve. "
+        "The least recently used one is discarded first [default: 16]"}}
      }
   };
 
@@ -406,6 +417,8 @@ namespace casadi {
     FunctionInternal::init(opts);
 
     print_problem_ = false;
+    presolve_ = false;
+    presolve_max_solvers_ = 16;
 
     // Read options
     for (auto&& op : opts) {
@@ -413,7 +426,29 @@ namespace casadi {
         discrete_ = op.second;
       } else if (op.first=="print_problem") {
         print_problem_ = op.second;
+      } else if (op.first=="presolve") {
+        presolve_ = op.second;
+      } else if (op.first=="presolve_max_solvers") {
+        presolve_max_solvers_ = op.second;
+      }
+    }
+
+    // Options of the solver for the reduced problem
+    if (presolve_) {
+      casadi_assert(np_==0, "Presolve not supported for psd constraints");
+      presolve_opts_ = opts;
+      casadi_assert(presolve_max_solvers_>=1, "presolve_max_solvers must be positive");
+      // Options sized to the original problem: discrete is sliced before each solve,
+      // the stage structure is detected anew for the reduced problem
+      for (const char* op : {"presolve", "presolve_max_solvers", "discrete",
+                             "N", "nx", "nu", "ng"}) {
+        presolve_opts_.erase(op);
+      }
+      for (const char* op : {"sos_groups", "sos_weights", "sos_types"}) {
+        casadi_assert(opts.find(op)==opts.end(),
+          "Option 'presolve' cannot be combined with option '" + std::string(op) + "'");
       }
+      presolve_opts_["error_on_fail"] = false;
     }
 
     // Check options
@@ -511,12 +546,13 @@ namespace casadi {
   int Conic::
   eval(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const {
     if (print_problem_) {
+      // Inputs are in the original order, also when H_ and A_ are permuted
       uout() << "H:";
-      DM::print_dense(uout(), H_, arg[CONIC_H], false);
+      DM::print_dense(uout(), sparsity_in_.at(CONIC_H), arg[CONIC_H], false);
       uout() << std::endl;
       uout() << "G:" << std::vector<double>(arg[CONIC_G], arg[CONIC_G]+nx_) << std::endl;
       uout() << "A:";
-      DM::print_dense(uout(), A_, arg[CONIC_A], false);
+      DM::print_dense(uout(), sparsity_in_.at(CONIC_A), arg[CONIC_A], false);
       uout() << std::endl;
       uout() << "lba:" << std::vector<double>(arg[CONIC_LBA], arg[CONIC_LBA]+na_) << std::endl;
       uout() << "uba:" << std::vector<double>(arg[CONIC_UBA], arg[CONIC_UBA]+na_) << std::endl;
@@ -529,9 +565,17 @@ namespace casadi {
       check_inputs(arg[CONIC_LBX], arg[CONIC_UBX], arg[CONIC_LBA], arg[CONIC_UBA]);
     }
 
-    setup(mem, arg, res, iw, w);
-
-    int ret = solve(arg, res, iw, w, mem);
+    int ret;
+    if (perm_x_.empty()) {
+      if (presolve_) {
+        ret = solve_presolved(arg, res, iw, w, mem);
+      } else {
+        setup(mem, arg, res, iw, w);
+        ret = solve(arg, res, iw, w, mem);
+      }
+    } else {
+      ret = solve_permuted(arg, res, iw, w, mem);
+    }
 
     if (error_on_fail_ && !m->d_qp.success)
       casadi_error("conic process failed. "
@@ -539,6 +583,446 @@ namespace casadi {
     return ret;
   }
 
+  void Conic::permute(const std::vector<casadi_int>& perm_x,
+      const std::vector<casadi_int>& perm_a) {
+    casadi_assert(np_==0, "Permutation not supported for psd constraints");
+    casadi_assert(perm_x.size()==nx_ && is_permutation(perm_x),
+      "Invalid permutation of the variables");
+    casadi_assert(perm_a.size()==na_ && is_permutation(perm_a),
+      "Invalid permutation of the constraints");
+    perm_x_ = perm_x;
+    perm_a_ = perm_a;
+    H_ = H_.sub(perm_x_, perm_x_, perm_h_nz_);
+    A_ = A_.sub(perm_a_, perm_x_, perm_a_nz_);
+    set_qp_prob();
+
+    // Permuted inputs and outputs
+    alloc_arg(n_in_, true);
+    alloc_res(n_out_, true);
+    alloc_w(H_.nnz() + A_.nnz() + 7*nx_ + 4*na_, true);
+  }
+
+  int Conic::prepare(const double** arg, double** res,
+      casadi_int* iw, double* w, void* mem) const {
+    if (presolve_) return 0;
+    if (perm_x_.empty()) return prepare_matrices(arg, res, iw, w, mem);
+
+    // Permuted matrices
+    const double** arg1 = arg + n_in_;
+    double** res1 = res + n_out_;
+    std::fill_n(arg1, n_in_, nullptr);
+    std::fill_n(res1, n_out_, nullptr);
+    if (arg[CONIC_H]) {
+      for (casadi_int k=0; k<perm_h_nz_.size(); ++k) w[k] = arg[CONIC_H][perm_h_nz_[k]];
+      arg1[CONIC_H] = w;
+      w += perm_h_nz_.size();
+    }
+    if (arg[CONIC_A]) {
+      for (casadi_int k=0; k<perm_a_nz_.size(); ++k) w[k] = arg[CONIC_A][perm_a_nz_[k]];
+      arg1[CONIC_A] = w;
+      w += perm_a_nz_.size();
+    }
+    return prepare_matrices(arg1, res1, iw, w, mem);
+  }
+
+  int Conic::solve_permuted(const double** arg, double** res,
+      casadi_int* iw, double* w, void* mem) const {
+    // Input and output pointers of the permuted problem
+    const double** arg1 = arg + n_in_;
+    double** res1 = res + n_out_;
+    std::copy_n(arg, n_in_, arg1);
+    std::copy_n(res, n_out_, res1);
+
+    // Gather the permuted inputs
+    auto gather = [&](casadi_int i, const std::vector<casadi_int>& p) {
+      if (arg[i]) {
+        for (casadi_int k=0; k<p.size(); ++k) w[k] = arg[i][p[k]];
+        arg1[i] = w;
+        w += p.size();
+      }
+    };
+    gather(CONIC_H, perm_h_nz_);
+    gather(CONIC_G, perm_x_);
+    gather(CONIC_A, perm_a_nz_);
+    gather(CONIC_LBA, perm_a_);
+    gather(CONIC_UBA, perm_a_);
+    gather(CONIC_LBX, perm_x_);
+    gather(CONIC_UBX, perm_x_);
+    gather(CONIC_X0, perm_x_);
+    gather(CONIC_LAM_X0, perm_x_);
+    gather(CONIC_LAM_A0, perm_a_);
+
+    // Permuted outputs
+    for (casadi_int i : {CONIC_X, CONIC_LAM_X, CONIC_LAM_A}) {
+      if (res[i]) {
+        res1[i] = w;
+        w += i==CONIC_LAM_A ? na_ : nx_;
+      }
+    }
+
+    // Solve
+    int ret;
+    if (presolve_) {
+      ret = solve_presolved(arg1, res1, iw, w, mem);
+    } else {
+      setup(mem, arg1, res1, iw, w);
+      ret = solve(arg1, res1, iw, w, mem);
+    }
+
+    // Scatter the outputs
+    auto scatter = [&](casadi_int i, const std::vector<casadi_int>& p) {
+      if (res[i]) {
+        for (casadi_int k=0; k<p.size(); ++k) res[i][p[k]] = res1[i][k];
+      }
+    };
+    scatter(CONIC_X, perm_x_);
+    scatter(CONIC_LAM_X, perm_x_);
+    scatter(CONIC_LAM_A, perm_a_);
+    return ret;
+  }
+
+  int Conic::solve_presolved(const double** arg, double** res,
+      casadi_int* iw, double* w, void* mem) const {
+    auto m = static_cast<ConicMemory*>(mem);
+    const double *h = arg[CONIC_H], *g = arg[CONIC_G], *a = arg[CONIC_A];
+    auto val = [](const double* v, casadi_int i) { return v ? v[i] : 0.;};
+
+    // Sparsities
+    const casadi_int *h_colind = H_.colind(), *h_row = H_.row();
+    const casadi_int *a_colind = A_.colind(), *a_row = A_.row();
+    const casadi_int *at_colind = AT_.colind(), *at_row = AT_.row();
+
+    // Bounds, tightened and shifted by the fixed variables during presolve
+    std::vector<double> lbx(nx_), ubx(nx_), lba(na_), uba(na_);
+    for (casadi_int i=0; i<nx_; ++i) {
+      lbx[i] = val(arg[CONIC_LBX], i);
+      ubx[i] = val(arg[CONIC_UBX], i);
+    }
+    for (casadi_int i=0; i<na_; ++i) {
+      lba[i] = val(arg[CONIC_LBA], i);
+      uba[i] = val(arg[CONIC_UBA], i);
+    }
+
+    // Fixed variables and their values, removed constraints
+    std::vector<bool> fixed(nx_, false), removed(na_, false);
+    std::vector<double> x(nx_, 0);
+
+    // Number of (numerically) nonzero entries in each constraint, among free variables
+    std::vector<casadi_int> nnz_row(na_, 0);
+    for (casadi_int k=0; k<A_.nnz(); ++k) {
+      if (a[k]!=0) nnz_row[a_row[k]]++;
+    }
+
+    // Reductions, in the order they were made, needed to recover the multipliers
+    enum PresolveStep {PRE_FIXED, PRE_SINGLETON, PRE_DUPLICATE};
+    struct PresolveEvent {
+      PresolveStep step;
+      // Removed constraint, variable or constraint it was merged into
+      casadi_int i, j;
+      // Scaling factor
+      double c;
+      // Has the lower/upper bound of j been tightened?
+      bool lower, upper;
+    };
+    std::vector<PresolveEvent> events;
+
+    // Statistics
+    m->n_fixed = m->n_empty = m->n_singleton = m->n_duplicate = 0;
+    m->n_dominated = m->n_redundant = 0;
+    m->pre_stats.clear();
+
+    // Bounds that cross by at most the rounding error are merged, otherwise infeasible
+    bool infeasible = false;
+    auto check_bounds = [&](double& lb, double& ub) {
+      if (lb>ub) {
+        if (lb-ub <= 1e-12*std::fmax(1., std::fmax(fabs(lb), fabs(ub)))) {
+          lb = ub = 0.5*(lb+ub);
+        } else {
+          infeasible = true;
+        }
+      }
+    };
+
+    // Entries of constraint i among the free variables
+    auto live = [&](casadi_int i, std::vector<std::pair<casadi_int, double> >& e) {
+      e.clear();
+      for (casadi_int k=at_colind[i]; k<at_colind[i+1]; ++k) {
+        casadi_int j = at_row[k];
+        double v = a[at_map_[k]];
+        if (v!=0 && !fixed[j]) e.push_back(std::make_pair(j, v));
+      }
+    };
+    std::vector<std::pair<casadi_int, double> > e;
+
+    // Repeat until no more reductions can be made
+    bool changed = true;
+    while (changed && !infeasible) {
+      changed = false;
+
+      // Fixed variables
+      for (casadi_int j=0; j<nx_ && !infeasible; ++j) {
+        if (fixed[j]) continue;
+        check_bounds(lbx[j], ubx[j]);
+        if (lbx[j]!=ubx[j]) continue;
+        fixed[j] = true;
+        x[j] = lbx[j];
+        events.push_back({PRE_FIXED, -1, j, 0, false, false});
+        m->n_fixed++;
+        changed = true;
+        // Move to the constraint bounds
+        for (casadi_int k=a_colind[j]; k<a_colind[j+1]; ++k) {
+          if (a[k]==0) continue;
+          casadi_int i = a_row[k];
+          lba[i] -= a[k]*x[j];
+          uba[i] -= a[k]*x[j];
+          nnz_row[i]--;
+        }
+      }
+
+      // Empty and singleton constraints
+      for (casadi_int i=0; i<na_ && !infeasible; ++i) {
+        if (removed[i]) continue;
+        if (nnz_row[i]==0) {
+          // Must be satisfied by the fixed variables
+          double tol = 1e-12*std::fmax(1., std::fmax(fabs(lba[i]), fabs(uba[i])));
+          if (lba[i]>tol || uba[i]<-tol) infeasible = true;
+          removed[i] = true;
+          m->n_empty++;
+          changed = true;
+        } else if (nnz_row[i]==1) {
+          // Becomes a bound on the variable
+          live(i, e);
+          casadi_int j = e[0].first;
+          double v = e[0].second;
+          double lb = lba[i]/v, ub = uba[i]/v;
+          if (v<0) std::swap(lb, ub);
+          bool lower = lb>lbx[j], upper = ub<ubx[j];
+          if (lower) lbx[j] = lb;
+          if (upper) ubx[j] = ub;
+          check_bounds(lbx[j], ubx[j]);
+          events.push_back({PRE_SINGLETON, i, j, v, lower, upper});
+          removed[i] = true;
+          m->n_singleton++;
+          changed = true;
+        }
+      }
+
+      // Duplicate constraints, up to scaling: compare the normalized entries
+      std::map<std::vector<std::pair<casadi_int, double> >, casadi_int> rows;
+      std::vector<double> first(na_, 0);
+      for (casadi_int i=0; i<na_ && !infeasible; ++i) {
+        if (removed[i]) continue;
+        live(i, e);
+        first[i] = e[0].second;
+        for (auto&& ek : e) ek.second /= first[i];
+        auto it = rows.insert(std::make_pair(e, i));
+        if (it.second) continue;
+        // Constraint i is c times constraint i1: merge bounds into i1
+        casadi_int i1 = it.first->second;
+        double c = first[i]/first[i1];
+        double lb = lba[i]/c, ub = uba[i]/c;
+        if (c<0) std::swap(lb, ub);
+        bool lower = lb>lba[i1], upper = ub<uba[i1];
+        if (lower) lba[i1] = lb;
+        if (upper) uba[i1] = ub;
+        check_bounds(lba[i1], uba[i1]);
+        events.push_back({PRE_DUPLICATE, i, i1, c, lower, upper});
+        removed[i] = true;
+        m->n_duplicate++;
+        changed = true;
+      }
+
+      // Constraint bounds implied by the variable bounds
+      for (casadi_int i=0; i<na_ && !infeasible; ++i) {
+        if (removed[i]) continue;
+        live(i, e);
+        double a_min = 0, a_max = 0;
+        for (auto&& ek : e) {
+          double v = ek.second;
+          a_min += v * (v>0 ? lbx[ek.first] : ubx[ek.first]);
+          a_max += v * (v>0 ? ubx[ek.first] : lbx[ek.first]);
+        }
+        if (lba[i]!=-inf && a_min>=lba[i]) {
+          lba[i] = -inf;
+          m->n_dominated++;
+          changed = true;
+        }
+        if (uba[i]!=inf && a_max<=uba[i]) {
+          uba[i] = inf;
+          m->n_dominated++;
+          changed = true;
+        }
+        if (lba[i]==-inf && uba[i]==inf) {
+          removed[i] = true;
+          m->n_redundant++;
+        }
+      }
+    }
+
+    // Kept variables and constraints
+    std::vector<casadi_int> kept_x, kept_a;
+    for (casadi_int j=0; j<nx_; ++j) if (!fixed[j]) kept_x.push_back(j);
+    for (casadi_int i=0; i<na_; ++i) if (!removed[i]) kept_a.push_back(i);
+    m->nx_reduced = kept_x.size();
+    m->na_reduced = kept_a.size();
+
+    // Primal-dual solution of the full problem
+    std::vector<double> lam_x(nx_, 0), lam_a(na_, 0);
+    int ret = 0;
+    if (infeasible) {
+      // Primal solution: projected initial guess
+      for (casadi_int j : kept_x) {
+        x[j] = std::fmin(std::fmax(val(arg[CONIC_X0], j), lbx[j]), ubx[j]);
+      }
+      m->d_qp.success = false;
+      m->d_qp.unified_return_status = SOLVER_RET_INFEASIBLE;
+      m->d_qp.iter_count = 0;
+    } else if (kept_x.empty()) {
+      // Nothing left to solve
+      m->d_qp.success = true;
+      m->d_qp.unified_return_status = SOLVER_RET_SUCCESS;
+      m->d_qp.iter_count = 0;
+    } else {
+      // Get the solver for the reduced problem, creating it if necessary
+      std::vector<casadi_int> key = kept_x;
+      key.push_back(-1);
+      key.insert(key.end(), kept_a.begin(), kept_a.end());
+      PresolvedQP qp;
+      {
+#ifdef CASADI_WITH_THREAD
+        std::lock_guard<std::mutex> lock(mtx_);
+#endif //CASADI_WITH_THREAD
+        auto it = presolved_index_.find(key);
+        if (it==presolved_index_.end()) {
+          Sparsity Hr = H_.sub(kept_x, kept_x, qp.h_nz);
+          Sparsity Ar = A_.sub(kept_a, kept_x, qp.a_nz);
+          Dict opts = presolve_opts_;
+          if (!discrete_.empty()) opts["discrete"] = vector_slice(discrete_, kept_x);
+          qp.solver = conic(name_ + "_presolved", plugin_name(),
+            {{"h", Hr}, {"a", Ar}}, opts);
+          presolved_.push_front(std::make_pair(key, qp));
+          presolved_index_[key] = presolved_.begin();
+          // Discard the least recently used solver
+          if (static_cast<casadi_int>(presolved_.size())>presolve_max_solvers_) {
+            presolved_index_.erase(presolved_.back().first);
+            presolved_.pop_back();
+          }
+        } else {
+          // Mark as most recently used
+          presolved_.splice(presolved_.begin(), presolved_, it->second);
+          qp = it->second->second;
+        }
+      }
+      casadi_int nx = kept_x.size(), na = kept_a.size();
+
+      // Gradient of the reduced problem, including the fixed variables
+      std::vector<double> g_fixed(nx_, 0);
+      for (casadi_int j=0; j<nx_; ++j) {
+        if (!fixed[j] || x[j]==0) continue;
+        for (casadi_int k=h_colind[j]; k<h_colind[j+1]; ++k) {
+          g_fixed[h_row[k]] += h[k]*x[j];
+        }
+      }
+
+      // Work vectors of the reduced problem
+      size_t sz_arg, sz_res, sz_iw, sz_w;
+      qp.solver.sz_work(sz_arg, sz_res, sz_iw, sz_w);
+      m->pre_arg.resize(sz_arg);
+      m->pre_res.resize(sz_res);
+      m->pre_iw.resize(sz_iw);
+      m->pre_w.resize(sz_w + qp.h_nz.size() + qp.a_nz.size() + 9*nx + 5*na);
+      double* w1 = get_ptr(m->pre_w) + sz_w;
+      auto gather = [&](const std::vector<double>& v, const std::vector<casadi_int>& ind) {
+        double* r = w1;
+        for (casadi_int k : ind) *w1++ = v[k];
+        return r;
+      };
+      auto gather_arg = [&](casadi_int i, const std::vector<casadi_int>& ind) {
+        double* r = w1;
+        for (casadi_int k : ind) *w1++ = val(arg[i], k);
+        return r;
+      };
+      const double** arg1 = get_ptr(m->pre_arg);
+      double** res1 = get_ptr(m->pre_res);
+      arg1[CONIC_H] = gather_arg(CONIC_H, qp.h_nz);
+      arg1[CONIC_G] = w1;
+      for (casadi_int j : kept_x) *w1++ = val(g, j) + g_fixed[j];
+      arg1[CONIC_A] = gather_arg(CONIC_A, qp.a_nz);
+      arg1[CONIC_LBA] = gather(lba, kept_a);
+      arg1[CONIC_UBA] = gather(uba, kept_a);
+      arg1[CONIC_LBX] = gather(lbx, kept_x);
+      arg1[CONIC_UBX] = gather(ubx, kept_x);
+      arg1[CONIC_X0] = gather_arg(CONIC_X0, kept_x);
+      arg1[CONIC_LAM_X0] = gather_arg(CONIC_LAM_X0, kept_x);
+      arg1[CONIC_LAM_A0] = gather_arg(CONIC_LAM_A0, kept_a);
+      arg1[CONIC_Q] = nullptr;
+      arg1[CONIC_P] = nullptr;
+      double f;
+      res1[CONIC_X] = w1; w1 += nx;
+      res1[CONIC_COST] = &f;
+      res1[CONIC_LAM_A] = w1; w1 += na;
+      res1[CONIC_LAM_X] = w1; w1 += nx;
+
+      // Solve the reduced problem
+      scoped_checkout<Function> mem1(qp.solver);
+      ret = qp.solver(arg1, res1, get_ptr(m->pre_iw), get_ptr(m->pre_w), mem1);
+      m->pre_stats = qp.solver.stats(mem1);
+      auto m1 = static_cast<ConicMemory*>(qp.solver.memory(mem1));
+      m->d_qp.success = m1->d_qp.success;
+      m->d_qp.unified_return_status = m1->d_qp.unified_return_status;
+      m->d_qp.iter_count = m1->d_qp.iter_count;
+
+      // Scatter the solution
+      for (casadi_int k=0; k<nx; ++k) {
+        x[kept_x[k]] = res1[CONIC_X][k];
+        lam_x[kept_x[k]] = res1[CONIC_LAM_X][k];
+      }
+      for (casadi_int k=0; k<na; ++k) lam_a[kept_a[k]] = res1[CONIC_LAM_A][k];
+    }
+
+    // Recover the multipliers of the removed constraints and fixed variables
+    for (auto ev = events.rbegin(); ev!=events.rend(); ++ev) {
+      if (ev->step==PRE_FIXED) {
+        // Stationarity of the Lagrangian with respect to the fixed variable
+        casadi_int j = ev->j;
+        double r = val(g, j);
+        for (casadi_int k=h_colind[j]; k<h_colind[j+1]; ++k) r += h[k]*x[h_row[k]];
+        for (casadi_int k=a_colind[j]; k<a_colind[j+1]; ++k) r += a[k]*lam_a[a_row[k]];
+        lam_x[j] = -r;
+      } else if (ev->step==PRE_SINGLETON) {
+        // Active bound from the constraint: move the multiplier to the constraint
+        double& mu = lam_x[ev->j];
+        if ((ev->lower && mu<0) || (ev->upper && mu>0)) {
+          lam_a[ev->i] = mu/ev->c;
+          mu = 0;
+        }
+      } else {
+        // Active bound from the duplicate: move the multiplier to the duplicate
+        double& lam = lam_a[ev->j];
+        if ((ev->lower && lam<0) || (ev->upper && lam>0)) {
+          lam_a[ev->i] = lam/ev->c;
+          lam = 0;
+        }
+      }
+    }
+
+    // Pass to the outputs
+    casadi_copy(get_ptr(x), nx_, res[CONIC_X]);
+    casadi_copy(get_ptr(lam_x), nx_, res[CONIC_LAM_X]);
+    casadi_copy(get_ptr(lam_a), na_, res[CONIC_LAM_A]);
+    if (res[CONIC_COST]) {
+      double f = 0;
+      for (casadi_int j=0; j<nx_; ++j) {
+        f += val(g, j)*x[j];
+        for (casadi_int k=h_colind[j]; k<h_colind[j+1]; ++k) {
+          f += 0.5*x[h_row[k]]*h[k]*x[j];
+        }
+      }
+      *res[CONIC_COST] = f;
+    }
+    return ret;
+  }
+
   std::vector<std::string> conic_options(const std::string& name) {
     return Conic::plugin_options(name).all();
   }
@@ -693,6 +1177,33 @@ namespace casadi {
     stats["success"] = m->d_qp.success;
     stats["unified_return_status"] = string_from_UnifiedReturnStatus(m->d_qp.unified_return_status);
     stats["iter_count"] = m->d_qp.iter_count;
+    if (presolve_) {
+      stats["presolve"] = Dict{
+        {"n_fixed", m->n_fixed},
+        {"n_empty", m->n_empty},
+        {"n_singleton", m->n_singleton},
+        {"n_duplicate", m->n_duplicate},
+        {"n_dominated", m->n_dominated},
+        {"n_redundant", m->n_redundant},
+        {"nx", m->nx_reduced},
+        {"na", m->na_reduced},
+        {"solver_stats", m->pre_stats}};
+    }
+    return stats;
+  }
+
+  Dict Conic::get_stats_user(void* mem) const {
+    Dict stats = get_stats(mem);
+    auto m = static_cast<ConicMemory*>(mem);
+    // The plugin statistics of the top-level solver are not updated by the presolve
+    if (presolve_) {
+      for (auto&& e : m->pre_stats) {
+        const std::string& k = e.first;
+        if (k.rfind("n_call_", 0)==0 || k.rfind("t_wall_", 0)==0
+            || k.rfind("t_proc_", 0)==0) continue;
+        stats[k] = e.second;
+      }
+    }
     return stats;
   }
 
@@ -716,9 +1227,12 @@ namespace casadi {
   void Conic::serialize_body(SerializingStream &s) const {
     FunctionInternal::serialize_body(s);
 
-    s.version("Conic", 2);
+    s.version("Conic", 5);
     s.pack("Conic::discrete", discrete_);
     s.pack("Conic::print_problem", print_problem_);
+    s.pack("Conic::presolve", presolve_);
+    s.pack("Conic::presolve_opts", presolve_opts_);
+    s.pack("Conic::presolve_max_solvers", presolve_max_solvers_);
     s.pack("Conic::H", H_);
     s.pack("Conic::A", A_);
     s.pack("Conic::Q", Q_);
@@ -726,6 +1240,10 @@ namespace casadi {
     s.pack("Conic::nx", nx_);
     s.pack("Conic::na", na_);
     s.pack("Conic::np", np_);
+    s.pack("Conic::perm_x", perm_x_);
+    s.pack("Conic::perm_a", perm_a_);
+    s.pack("Conic::perm_h_nz", perm_h_nz_);
+    s.pack("Conic::perm_a_nz", perm_a_nz_);
   }
 
   void Conic::serialize_type(SerializingStream &s) const {
@@ -738,9 +1256,20 @@ namespace casadi {
   }
 
   Conic::Conic(DeserializingStream & s) : FunctionInternal(s) {
-    int version = s.version("Conic", 1, 2);
+    int version = s.version("Conic", 1, 5);
     s.unpack("Conic::discrete", discrete_);
     s.unpack("Conic::print_problem", print_problem_);
+    if (version>=4) {
+      s.unpack("Conic::presolve", presolve_);
+      s.unpack("Conic::presolve_opts", presolve_opts_);
+    } else {
+      presolve_ = false;
+    }
+    if (version>=5) {
+      s.unpack("Conic::presolve_max_solvers", presolve_max_solvers_);
+    } else {
+      presolve_max_solvers_ = 16;
+    }
     if (version==1) {
       s.unpack("Conic::error_on_fail", error_on_fail_);
     }
@@ -752,15 +1281,26 @@ namespace casadi {
     s.unpack("Conic::nx", nx_);
     s.unpack("Conic::na", na_);
     s.unpack("Conic::np", np_);
+    if (version>=3) {
+      s.unpack("Conic::perm_x", perm_x_);
+      s.unpack("Conic::perm_a", perm_a_);
+      s.unpack("Conic::perm_h_nz", perm_h_nz_);
+      s.unpack("Conic::perm_a_nz", perm_a_nz_);
+    }
   }
 
   void Conic::set_qp_prob() {
     p_qp_.sp_a = A_;
     p_qp_.sp_h = H_;
     casadi_qp_setup(&p_qp_);
+    // Row-wise access to A is only needed by the presolve
+    if (presolve_) AT_ = A_.transpose(at_map_);
   }
 
   void Conic::qp_codegen_body(CodeGenerator& g) const {
+    casadi_assert(perm_x_.empty(),
+      "Code generation is not supported for a problem in permuted order.");
+    casadi_assert(!presolve_, "Code generation is not supported with presolve.");
     g.add_auxiliary(CodeGenerator::AUX_QP);
     g.local("d_qp", "struct casadi_qp_data");
     g.local("p_qp", "struct casadi_qp_prob");
@@ -38,6 +38,16 @@ namespace casadi {
     // Problem data structure
     casadi_qp_data<double> d_qp;
 
+    // Presolve: work vectors of the reduced problem
+    std::vector<const double*> pre_arg;
+    std::vector<double*> pre_res;
+    std::vector<casadi_int> pre_iw;
+    std::vector<double> pre_w;
+
+    // Presolve: statistics of the last reduction
+    casadi_int n_fixed, n_empty, n_singleton, n_duplicate, n_dominated, n_redundant;
+    casadi_int nx_reduced, na_reduced;
+    Dict pre_stats;
   };
 
   /// Internal class
@@ -91,6 +101,38 @@ namespace casadi {
     virtual int solve(const double** arg, double** res,
       casadi_int* iw, double* w, void* mem) const = 0;
 
+    /** \brief Prepare the solution of QPs with given H and A
+
+        Only the inputs H and A are read. Lets a solver perform the work that depends
+        on the matrices only, e.g. a condensing, ahead of a solve with the same H and A.
+        Does nothing when presolving, since the reduced problem depends on the bounds.
+    */
+    int prepare(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const;
+
+    /// Prepare the solution of QPs with given H and A, in the (permuted) order of the solver
+    virtual int prepare_matrices(const double** arg, double** res,
+      casadi_int* iw, double* w, void* mem) const { return 0;}
+
+    /// Solve the QP in permuted order
+    int solve_permuted(const double** arg, double** res,
+      casadi_int* iw, double* w, void* mem) const;
+
+    /** \brief Solve a reduced QP
+
+        Removes fixed variables, empty, singleton and duplicate constraints and dominated
+        constraint bounds, solves the remaining problem with a solver of the same plugin
+        and recovers the primal and dual solution of the original problem.
+    */
+    int solve_presolved(const double** arg, double** res,
+      casadi_int* iw, double* w, void* mem) const;
+
+    /** \brief Let the solver work with permuted variables and constraints
+
+        Replaces H and A by their permuted versions. Inputs and outputs are permuted
+        before and after each solve, so that the function signature is unchanged.
+    */
+    void permute(const std::vector<casadi_int>& perm_x, const std::vector<casadi_int>& perm_a);
+
     // Initialize
     void init(const Dict& opts) override;
 
@@ -147,6 +189,9 @@ namespace casadi {
     /// Get all statistics
     Dict get_stats(void* mem) const override;
 
+    /// Get all statistics, with those of the plugin taken from the reduced problem
+    Dict get_stats_user(void* mem) const override;
+
     /** \brief Generate code for the function body
 
         \identifier{24y} */
@@ -156,6 +201,11 @@ namespace casadi {
     /// Options
     std::vector<bool> discrete_;
     bool print_problem_;
+    bool presolve_;
+    casadi_int presolve_max_solvers_;
+
+    /// Options of the solver for the reduced problem
+    Dict presolve_opts_;
 
     /// Problem structure
     Sparsity H_, A_, Q_, P_;
@@ -169,6 +219,28 @@ namespace casadi {
     /// The shape of psd constraint matrix
     casadi_int np_;
 
+    /// Permutation of the variables and constraints, empty if none
+    std::vector<casadi_int> perm_x_, perm_a_;
+
+    /// Corresponding nonzeros of H and A
+    std::vector<casadi_int> perm_h_nz_, perm_a_nz_;
+
+    /// Transpose of A and corresponding mapping, for row-wise access
+    Sparsity AT_;
+    std::vector<casadi_int> at_map_;
+
+    /// Solver for a reduced problem, with the corresponding nonzeros of H and A
+    struct PresolvedQP {
+      Function solver;
+      std::vector<casadi_int> h_nz, a_nz;
+    };
+
+    /// Solvers for the reduced problems encountered most recently, keyed by the kept
+    /// variables and constraints
+    typedef std::list<std::pair<std::vector<casadi_int>, PresolvedQP> > PresolvedList;
+    mutable PresolvedList presolved_;
+    mutable std::map<std::vector<casadi_int>, PresolvedList::iterator> presolved_index_;
+
     /// SDP to SOCP conversion memory
     struct SDPToSOCPMem {
       // Block partition vector for SOCP (block i runs from r[i] to r[i+1])
@@ -74,6 +74,12 @@ namespace casadi {
     // Hessian blocks
     std::vector<HBlock> hess_;
 
+    // Hessian-vector product blocks
+    std::vector<Block> hvp_;
+
+    // Number of directions in Hessian-vector products
+    casadi_int hvp_ndir_ = 1;
+
     // Read a Jacobian or gradient block
     Block block(const std::string& s1, const std::string& s) const;
 
@@ -119,6 +125,9 @@ namespace casadi {
     // Calculate Hessian blocks
     void calculate_hess(const Dict& opts);
 
+    // Calculate Hessian-vector products, forward-over-reverse
+    void calculate_hvp(const Dict& opts);
+
     // Calculate requested outputs
     void calculate(const Dict& opts = Dict());
 
@@ -222,6 +231,8 @@ namespace casadi {
       grad_.push_back(block(ss.second, s));
     } else if (ss.first=="hess") {
       hess_.push_back(hblock(ss.second, s));
+    } else if (ss.first=="hvp") {
+      hvp_.push_back(block(ss.second, s));
     } else {
       // Assume attribute
       request_output(ss.second);
@@ -537,6 +548,43 @@ namespace casadi {
     }
   }
 
+  template<typename MatType>
+  void Factory<MatType>::calculate_hvp(const Dict& opts) {
+    for (auto &&b : hvp_) {
+      // Copies, since add_input below may reallocate in_
+      MatType ex = out_.at(b.f);
+      MatType arg = in_[b.x];
+      casadi_assert(ex.is_scalar(), "Can only take Hessian-vector product of scalar expression.");
+      bool is_diff = is_diff_out_.at(b.f) && is_diff_in_.at(b.x);
+      // Directions, horizontally concatenated, shared with forward mode
+      std::string sname = "fwd:" + iname_[b.x];
+      if (!has_in(sname)) {
+        Sparsity sp = is_diff_in_.at(b.x) ? arg.sparsity() : Sparsity(arg.size());
+        add_input(sname, MatType::sym("fwd_" + iname_[b.x], repmat(sp, 1, hvp_ndir_)), true);
+      }
+      const MatType& v = in_.at(imap(sname));
+      casadi_assert(v.size1() == arg.size1() && v.size2() == hvp_ndir_ * arg.size2(),
+        "Hessian-vector product requires " + str(hvp_ndir_) + " directions for \""
+        + iname_[b.x] + "\", but \"" + sname + "\" has dimension " + v.dim() + ".");
+      if (!is_diff) {
+        add_output(b.s, MatType(arg.size1(), arg.size2() * hvp_ndir_), false);
+        continue;
+      }
+      // Gradient, calculated in reverse mode
+      MatType g = project(gradient(ex, arg, opts), arg.sparsity());
+      // All directional derivatives of the gradient in a single forward sweep
+      std::vector<MatType> v_split = horzsplit(v, arg.size2());
+      std::vector<std::vector<MatType>> seed(hvp_ndir_);
+      for (casadi_int d = 0; d < hvp_ndir_; ++d) seed[d] = {v_split.at(d)};
+      Dict local_opts = opts;
+      local_opts["always_inline"] = true;
+      std::vector<std::vector<MatType>> sens = forward({g}, {arg}, seed, local_opts);
+      std::vector<MatType> Hv(hvp_ndir_);
+      for (casadi_int d = 0; d < hvp_ndir_; ++d) Hv[d] = project(sens[d].at(0), arg.sparsity());
+      add_output(b.s, horzcat(Hv), true);
+    }
+  }
+
   template<typename MatType>
   void Factory<MatType>::add_dual(const Function::AuxOut& aux) {
     // Dual variables
@@ -590,6 +638,13 @@ namespace casadi {
     } catch (std::exception& e) {
       casadi_error("Hessian generation failed:\n" + str(e.what()));
     }
+
+    // Hessian-vector products
+    try {
+      calculate_hvp(opts);
+    } catch (std::exception& e) {
+      casadi_error("Hessian-vector product generation failed:\n" + str(e.what()));
+    }
   }
 
   template<typename MatType>
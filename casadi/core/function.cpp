@@ -925,7 +925,7 @@ namespace casadi {
   }
 
   Dict Function::stats(int mem) const {
-    return (*this)->get_stats(memory(mem));
+    return (*this)->get_stats_user(memory(mem));
   }
 
   const std::vector<Sparsity>& Function::jac_sparsity(bool compact) const {
@@ -1123,6 +1123,14 @@ namespace casadi {
     }
   }
 
+  Function Function::taylor(casadi_int order) const {
+    try {
+      return (*this)->taylor(order);
+    } catch(std::exception& e) {
+      THROW_ERROR("taylor", e.what());
+    }
+  }
+
   void Function::print_dimensions(std::ostream &stream) const {
     (*this)->print_dimensions(stream);
   }
@@ -819,6 +819,22 @@ namespace casadi {
         \identifier{1wr} */
     Function reverse(casadi_int nadj) const;
 
+    /** \brief Get a function that propagates univariate Taylor polynomials
+     *
+     *         Returns a function with the same inputs and outputs as this function,
+     *         each stacked horizontally <tt>order+1</tt> times. Input block \a k holds
+     *         the coefficient of <tt>t^k</tt> of a curve <tt>x(t)</tt>, output block \a k
+     *         the coefficient of <tt>t^k</tt> of the outputs along that curve, i.e.
+     *         the \a k-th directional derivative divided by <tt>k!</tt> for a straight line.
+     *
+     *         All coefficients are obtained in a single sweep, avoiding the nested
+     *         forward derivatives whose cost grows exponentially with the order.
+     *
+     *        The functions returned are cached, meaning that if called multiple timed
+     *        with the same value, then multiple references to the same function will be returned.
+     */
+    Function taylor(casadi_int order) const;
+
     /** \brief Get, if necessary generate, the sparsity of all Jacobian blocks
 
         \identifier{1ws} */
@@ -38,6 +38,7 @@
 #include "switch.hpp"
 #include "interpolant_impl.hpp"
 #include "nlpsol_impl.hpp"
+#include "nlpsol_batch.hpp"
 #include "conic_impl.hpp"
 #include "integrator_impl.hpp"
 #include "external_impl.hpp"
@@ -2171,6 +2172,31 @@ namespace casadi {
     casadi_error("'get_reverse' not defined for " + class_name());
   }
 
+  Function FunctionInternal::taylor(casadi_int order) const {
+    casadi_assert(order>=0, "Taylor polynomial degree must be nonnegative");
+    // Retrieve/generate cached
+    Function f;
+    std::string fname = "taylor" + str(order) + "_" + name_;
+    if (!incache(fname, f)) {
+      f = get_taylor(order, fname, Dict());
+      // Consistency check
+      casadi_assert_dev(f.n_in()==n_in_ && f.n_out()==n_out_);
+      for (casadi_int i=0; i<n_in_; ++i) {
+        casadi_assert_dev(f.sparsity_in(i)==repmat(sparsity_in(i), 1, order+1));
+      }
+      for (casadi_int i=0; i<n_out_; ++i) f.assert_sparsity_out(i, sparsity_out(i), order+1);
+      // Save to cache
+      tocache(f);
+    }
+    return f;
+  }
+
+  Function FunctionInternal::
+  get_taylor(casadi_int order, const std::string& name, const Dict& opts) const {
+    // Propagate through the expanded function
+    return self().expand(name_).taylor(order);
+  }
+
   void FunctionInternal::export_code(const std::string& lang, std::ostream &stream,
       const Dict& options) const {
     casadi_error("'export_code' not defined for " + class_name());
@@ -3810,6 +3836,7 @@ namespace casadi {
       case SOLVER_RET_LIMITED:  return "SOLVER_RET_LIMITED";
       case SOLVER_RET_NAN:  return "SOLVER_RET_NAN";
       case SOLVER_RET_SUCCESS:  return "SOLVER_RET_SUCCESS";
+      case SOLVER_RET_INFEASIBLE:  return "SOLVER_RET_INFEASIBLE";
       default: return "SOLVER_RET_UNKNOWN";
     }
   }
@@ -4055,6 +4082,7 @@ namespace casadi {
     {"Map", Map::deserialize},
     {"MapSum", MapSum::deserialize},
     {"Nlpsol", Nlpsol::deserialize},
+    {"NlpsolBatch", NlpsolBatch::deserialize},
     {"Rootfinder", Rootfinder::deserialize},
     {"Integrator", Integrator::deserialize},
     {"External", External::deserialize},
@@ -184,6 +184,9 @@ namespace casadi {
     /// Get all statistics
     virtual Dict get_stats(void* mem) const;
 
+    /// Get all statistics, as returned to the user
+    virtual Dict get_stats_user(void* mem) const { return get_stats(mem);}
+
     /** \brief Clear all memory (called from destructor)
 
         \identifier{jq} */
@@ -646,6 +649,19 @@ namespace casadi {
                                  const Dict& opts) const;
     ///@}
 
+    ///@{
+    /** \brief Return function that propagates univariate Taylor polynomials
+
+     *    taylor(order) returns a cached instance if available,
+     *    and calls <tt>Function get_taylor(casadi_int order)</tt>
+     *    if no cached version is available. The default implementation
+     *    expands the function into an SXFunction.
+     */
+    Function taylor(casadi_int order) const;
+    virtual Function get_taylor(casadi_int order, const std::string& name,
+                                const Dict& opts) const;
+    ///@}
+
     /** \brief Ensure that a matrix's sparsity is a horizontal multiple of another, or empty
 
         \identifier{26j} */
@@ -654,6 +654,10 @@ namespace casadi {
       return to_int() != op2.to_int();
     }
 
+    if (is_bool() && op2.is_bool()) {
+      return to_bool() != op2.to_bool();
+    }
+
     if (is_double() && op2.is_double()) {
       return to_double() != op2.to_double();
     }
@@ -702,6 +706,10 @@ namespace casadi {
       return false;
     }
 
+    if (is_dict() && op2.is_dict()) {
+      return as_dict() != op2.as_dict();
+    }
+
     // Different types
     return true;
   }
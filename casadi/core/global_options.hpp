@@ -60,6 +60,14 @@ namespace casadi {
           \identifier{17v} */
       static bool simplification_on_the_fly;
 
+      /** \brief Reuse structurally identical SX nodes when they are created
+
+      * Unary and binary nodes are looked up in a hash table before allocation,
+      * so that memory use scales with the number of unique expressions.
+      * Default: false
+      */
+      static bool hash_consing;
+
       static std::string casadipath;
 
       static std::string casadi_include_path;
@@ -75,6 +83,10 @@ namespace casadi {
       static void setSimplificationOnTheFly(bool flag) { simplification_on_the_fly = flag; }
       static bool getSimplificationOnTheFly() { return simplification_on_the_fly; }
 
+      // Setter and getter for hash_consing
+      static void setHashConsing(bool flag) { hash_consing = flag; }
+      static bool getHashConsing() { return hash_consing; }
+
       // Setter and getter for hierarchical_sparsity
       static void setHierarchicalSparsity(bool flag) { hierarchical_sparsity = flag; }
       static bool getHierarchicalSparsity() { return hierarchical_sparsity; }
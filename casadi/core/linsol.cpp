@@ -110,6 +110,9 @@ namespace casadi {
     if (A==nullptr) return 1;
     auto m = static_cast<LinsolMemory*>((*this)->memory(mem));
 
+    // Matrix unchanged since the last factorization
+    if ((*this)->is_factorized(m, A)) return 0;
+
     // Factorization will be needed after this step
     m->is_sfact = m->is_nfact = false;
 
@@ -132,6 +135,12 @@ namespace casadi {
     if (A==nullptr) return 1;
     auto m = static_cast<LinsolMemory*>((*this)->memory(mem));
 
+    // Matrix unchanged since the last factorization
+    if ((*this)->is_factorized(m, A)) {
+      m->n_reuse++;
+      return 0;
+    }
+
     // Perform pivoting, if required
     if (!m->is_sfact) {
       if (sfact(A, mem)) return 1;
@@ -159,6 +168,14 @@ namespace casadi {
         + "[" + (*this)->class_name() + "]. Linear system saved to '" + fname + "'");
     }
     m->is_nfact = true;
+    // Remember the factorized matrix, nan never compares equal
+    if (!m->nz_fact.empty()) {
+      if (flag) {
+        std::fill(m->nz_fact.begin(), m->nz_fact.end(), nan);
+      } else {
+        std::copy(A, A + sparsity().nnz(), m->nz_fact.begin());
+      }
+    }
     return flag;
   }
 
@@ -25,19 +25,133 @@
 
 #include "linsol_internal.hpp"
 
+#include <unordered_map>
+
+#ifdef CASADI_WITH_THREAD
+#ifdef CASADI_WITH_THREAD_MINGW
+#include <mingw.thread.h>
+#include <mingw.mutex.h>
+#else // CASADI_WITH_THREAD_MINGW
+#include <thread>
+#include <mutex>
+#endif // CASADI_WITH_THREAD_MINGW
+#endif // CASADI_WITH_THREAD
+
 namespace casadi {
 
   LinsolInternal::LinsolInternal(const std::string& name, const Sparsity& sp)
-   : ProtoFunction(name), sp_(sp) {
+   : ProtoFunction(name), sp_(sp), symbolic_cache_(true), mixed_precision_(false),
+     refine_max_iter_(10), refine_tol_(1e-14), reuse_factorization_(false) {
   }
 
   LinsolInternal::~LinsolInternal() {
   }
 
+  const Options LinsolInternal::options_
+  = {{&ProtoFunction::options_},
+     {{"symbolic_cache",
+       {OT_BOOL,
+        "Share the symbolic analysis with other instances of the same plugin, "
+        "sparsity pattern and options, where supported [true]"}},
+      {"mixed_precision",
+       {OT_BOOL,
+        "Factorize in single precision and recover double precision accuracy "
+        "by iterative refinement, where supported [false]"}},
+      {"refine_max_iter",
+       {OT_INT,
+        "Maximum number of iterative refinement steps [10]"}},
+      {"refine_tol",
+       {OT_DOUBLE,
+        "Iterative refinement stops when the residual is below this tolerance "
+        "relative to the right-hand-side [1e-14]"}},
+      {"reuse_factorization",
+       {OT_BOOL,
+        "Skip the symbolic and numeric factorization when the matrix is identical to "
+        "the one last factorized with the same memory object [false]"}}
+     }
+  };
+
   void LinsolInternal::init(const Dict& opts) {
     // Call the base class initializer
     ProtoFunction::init(opts);
 
+    // Read options
+    for (auto&& op : opts) {
+      if (op.first=="symbolic_cache") {
+        symbolic_cache_ = op.second;
+      } else if (op.first=="mixed_precision") {
+        mixed_precision_ = op.second;
+      } else if (op.first=="refine_max_iter") {
+        refine_max_iter_ = op.second;
+      } else if (op.first=="refine_tol") {
+        refine_tol_ = op.second;
+      } else if (op.first=="reuse_factorization") {
+        reuse_factorization_ = op.second;
+      }
+    }
+    casadi_assert(!mixed_precision_ || has_mixed_precision(),
+      "Option 'mixed_precision' not supported by " + class_name());
+  }
+
+  namespace {
+    // Entry of the symbolic analysis cache
+    struct SymbolicCacheEntry {
+      std::string key;
+      Sparsity sp;
+      std::weak_ptr<const void> data;
+    };
+
+    typedef std::unordered_multimap<std::size_t, SymbolicCacheEntry> SymbolicCache;
+
+    // Intentionally leaked: solvers may still be destroyed during static destruction
+    SymbolicCache& symbolic_cache_map() {
+      static SymbolicCache* ret = new SymbolicCache();
+      return *ret;
+    }
+
+#ifdef CASADI_WITH_THREAD
+    std::mutex& symbolic_cache_mutex() {
+      static std::mutex* ret = new std::mutex();
+      return *ret;
+    }
+#endif // CASADI_WITH_THREAD
+  } // namespace
+
+  std::shared_ptr<const void> LinsolInternal::symbolic_cache_find(const std::string& key) const {
+    std::string k = std::string(plugin_name()) + ":" + key;
+    std::size_t h = sp_.hash() ^ std::hash<std::string>()(k);
+#ifdef CASADI_WITH_THREAD
+    std::lock_guard<std::mutex> lock(symbolic_cache_mutex());
+#endif // CASADI_WITH_THREAD
+    auto eq = symbolic_cache_map().equal_range(h);
+    for (auto it=eq.first; it!=eq.second; ++it) {
+      if (it->second.key==k && it->second.sp==sp_) return it->second.data.lock();
+    }
+    return nullptr;
+  }
+
+  std::shared_ptr<const void> LinsolInternal::symbolic_cache_insert(const std::string& key,
+      const std::shared_ptr<const void>& data) const {
+    std::string k = std::string(plugin_name()) + ":" + key;
+    std::size_t h = sp_.hash() ^ std::hash<std::string>()(k);
+#ifdef CASADI_WITH_THREAD
+    std::lock_guard<std::mutex> lock(symbolic_cache_mutex());
+#endif // CASADI_WITH_THREAD
+    SymbolicCache& cache = symbolic_cache_map();
+    // Another thread may have inserted the same analysis in the meantime,
+    // purge expired entries with the same hash on the way
+    auto eq = cache.equal_range(h);
+    for (auto it=eq.first; it!=eq.second;) {
+      if (it->second.data.expired()) {
+        it = cache.erase(it);
+      } else if (it->second.key==k && it->second.sp==sp_) {
+        return it->second.data.lock();
+      } else {
+        ++it;
+      }
+    }
+    cache.insert({h, {k, sp_, data}});
+    return data;
   }
 
   void LinsolInternal::disp(std::ostream &stream, bool more) const {
@@ -57,6 +171,67 @@ namespace casadi {
       m->add_stat("sfact");
       m->add_stat("solve");
     }
+    if (mixed_precision_) {
+      m->ir_w.resize(2 * nrow());
+      m->ir_wf.resize(nrow());
+    }
+    if (reuse_factorization_) m->nz_fact.resize(sp_.nnz());
+    return 0;
+  }
+
+  bool LinsolInternal::is_factorized(void* mem, const double* A) const {
+    auto m = static_cast<LinsolMemory*>(mem);
+    return reuse_factorization_ && m->is_nfact
+      && std::equal(A, A + sp_.nnz(), m->nz_fact.begin());
+  }
+
+  Dict LinsolInternal::get_stats(void* mem) const {
+    Dict stats = ProtoFunction::get_stats(mem);
+    if (mixed_precision_) {
+      auto m = static_cast<LinsolMemory*>(mem);
+      stats["refine_iter"] = m->ir_iter;
+      stats["refine_residual"] = m->ir_residual;
+    }
+    if (reuse_factorization_) {
+      auto m = static_cast<LinsolMemory*>(mem);
+      stats["n_reuse"] = m->n_reuse;
+    }
+    return stats;
+  }
+
+  int LinsolInternal::refine(void* mem, const double* A, double* x, casadi_int nrhs, bool tr,
+      const std::function<int(float*)>& solve_lo) const {
+    auto m = static_cast<LinsolMemory*>(mem);
+    casadi_int n = nrow();
+    double *b = get_ptr(m->ir_w), *r = b + n;
+    float* rf = get_ptr(m->ir_wf);
+    m->ir_iter = 0;
+    m->ir_residual = 0;
+    for (casadi_int k=0; k<nrhs; ++k) {
+      casadi_copy(x, n, b);
+      double bnorm = casadi_norm_inf(n, b);
+      // Initial solution with the single precision factors
+      for (casadi_int i=0; i<n; ++i) rf[i] = static_cast<float>(b[i]);
+      if (solve_lo(rf)) return 1;
+      for (casadi_int i=0; i<n; ++i) x[i] = rf[i];
+      // Corrections from double precision residuals
+      double res, res_prev = inf;
+      casadi_int iter;
+      for (iter=0; ; ++iter) {
+        casadi_clear(r, n);
+        casadi_mv(A, sp_, x, r, tr);
+        for (casadi_int i=0; i<n; ++i) r[i] = b[i] - r[i];
+        res = casadi_norm_inf(n, r);
+        if (res<=refine_tol_*bnorm || iter>=refine_max_iter_ || res>=0.5*res_prev) break;
+        res_prev = res;
+        for (casadi_int i=0; i<n; ++i) rf[i] = static_cast<float>(r[i]);
+        if (solve_lo(rf)) return 1;
+        for (casadi_int i=0; i<n; ++i) x[i] += rf[i];
+      }
+      m->ir_iter = std::max(m->ir_iter, iter);
+      m->ir_residual = std::max(m->ir_residual, bnorm>0 ? res/bnorm : res);
+      x += n;
+    }
     return 0;
   }
 
@@ -112,6 +287,73 @@ namespace casadi {
     g << "#error " <<  class_name() << " does not support code generation\n";
   }
 
+  void LinsolInternal::etree_tasks(const Sparsity& sp_u, casadi_int nthreads, casadi_int cutoff,
+      std::vector<std::vector<casadi_int> >& tasks, std::vector<casadi_int>& rest) {
+    casadi_int n = sp_u.size2();
+    const casadi_int *colind = sp_u.colind(), *row = sp_u.row();
+    tasks.clear();
+    rest.clear();
+    // Elimination tree, columns are visited in increasing order
+    std::vector<casadi_int> parent(n, -1);
+    for (casadi_int c=0; c<n; ++c) {
+      for (casadi_int k=colind[c]; k<colind[c+1]; ++k) {
+        casadi_int r = row[k];
+        if (r<c && parent[r]<0) parent[r] = c;
+      }
+    }
+    // Subtree sizes, children precede their parents
+    std::vector<casadi_int> size(n, 1);
+    for (casadi_int c=0; c<n; ++c) {
+      if (parent[c]>=0) size[parent[c]] += size[c];
+    }
+    // Roots of maximal subtrees that are small enough to balance the load.
+    // Subtrees with fewer than cutoff columns are not worth a task and are left
+    // to the serial part
+    casadi_int smax = (n + nthreads - 1) / std::max(nthreads, casadi_int(1));
+    std::vector<casadi_int> roots;
+    for (casadi_int c=0; c<n; ++c) {
+      if (size[c]>=cutoff && size[c]<=smax && (parent[c]<0 || size[parent[c]]>smax)) {
+        roots.push_back(c);
+      }
+    }
+    // Largest subtrees first, each to the task with the least work so far
+    std::stable_sort(roots.begin(), roots.end(),
+      [&](casadi_int i, casadi_int j) { return size[i]>size[j];});
+    std::vector<casadi_int> load(nthreads, 0), owner(n, -1);
+    for (casadi_int r : roots) {
+      casadi_int t = std::min_element(load.begin(), load.end()) - load.begin();
+      owner[r] = t;
+      load[t] += size[r];
+    }
+    // Nothing to gain if all work ends up in one task
+    if (std::count(load.begin(), load.end(), 0) >= nthreads - 1) {
+      rest = range(n);
+      return;
+    }
+    // Descendants belong to the task of their root
+    for (casadi_int c=n-1; c>=0; --c) {
+      if (owner[c]<0 && parent[c]>=0) owner[c] = owner[parent[c]];
+    }
+    tasks.resize(nthreads);
+    for (casadi_int c=0; c<n; ++c) {
+      if (owner[c]<0) {
+        rest.push_back(c);
+      } else {
+        tasks[owner[c]].push_back(c);
+      }
+    }
+  }
+
+  void LinsolInternal::parallel_for(casadi_int n, const std::function<void(casadi_int)>& f) {
+#ifdef CASADI_WITH_THREAD
+    std::vector<std::thread> threads;
+    for (casadi_int i=0; i<n; ++i) threads.emplace_back(f, i);
+    for (auto&& th : threads) th.join();
+#else // CASADI_WITH_THREAD
+    for (casadi_int i=0; i<n; ++i) f(i);
+#endif // CASADI_WITH_THREAD
+  }
+
   std::map<std::string, LinsolInternal::Plugin> LinsolInternal::solvers_;
 
   const std::string LinsolInternal::infix_ = "linsol";
@@ -124,11 +366,26 @@ namespace casadi {
 
   void LinsolInternal::serialize_body(SerializingStream &s) const {
     ProtoFunction::serialize_body(s);
+    s.version("LinsolInternal", 2);
     s.pack("LinsolInternal::sp", sp_);
+    s.pack("LinsolInternal::reuse_factorization", reuse_factorization_);
+    s.pack("LinsolInternal::symbolic_cache", symbolic_cache_);
+    s.pack("LinsolInternal::mixed_precision", mixed_precision_);
+    s.pack("LinsolInternal::refine_max_iter", refine_max_iter_);
+    s.pack("LinsolInternal::refine_tol", refine_tol_);
   }
 
-  LinsolInternal::LinsolInternal(DeserializingStream& s) : ProtoFunction(s) {
+  LinsolInternal::LinsolInternal(DeserializingStream& s) : ProtoFunction(s),
+      symbolic_cache_(true), mixed_precision_(false), refine_max_iter_(10), refine_tol_(1e-14) {
+    int version = s.version("LinsolInternal", 1, 2);
     s.unpack("LinsolInternal::sp", sp_);
+    s.unpack("LinsolInternal::reuse_factorization", reuse_factorization_);
+    if (version >= 2) {
+      s.unpack("LinsolInternal::symbolic_cache", symbolic_cache_);
+      s.unpack("LinsolInternal::mixed_precision", mixed_precision_);
+      s.unpack("LinsolInternal::refine_max_iter", refine_max_iter_);
+      s.unpack("LinsolInternal::refine_tol", refine_tol_);
+    }
   }
 
   ProtoFunction* LinsolInternal::deserialize(DeserializingStream& s) {
@@ -29,6 +29,8 @@
 #include "linsol.hpp"
 #include "function_internal.hpp"
 #include "plugin_interface.hpp"
+#include <functional>
+#include <memory>
 
 /// \cond INTERNAL
 
@@ -38,8 +40,21 @@ namespace casadi {
     // Current state of factorization
     bool is_sfact, is_nfact;
 
+    // Work vectors for iterative refinement
+    std::vector<double> ir_w;
+    std::vector<float> ir_wf;
+
+    // Iterations and relative residual of the last refined solve
+    casadi_int ir_iter;
+    double ir_residual;
+
+    // Nonzeros of the last factorized matrix, number of factorizations skipped
+    std::vector<double> nz_fact;
+    casadi_int n_reuse;
+
     // Constructor
-    LinsolMemory() : is_sfact(false), is_nfact(false) {}
+    LinsolMemory() : is_sfact(false), is_nfact(false), ir_iter(0), ir_residual(0),
+      n_reuse(0) {}
   };
 
   /** Internal class
@@ -54,6 +69,12 @@ namespace casadi {
     /// Destructor
     ~LinsolInternal() override;
 
+    ///@{
+    /** \brief Options */
+    static const Options options_;
+    const Options& get_options() const override { return options_;}
+    ///@}
+
     /** \brief Display object
 
         \identifier{e4} */
@@ -82,6 +103,9 @@ namespace casadi {
         \identifier{e8} */
     void free_mem(void *mem) const override { delete static_cast<LinsolMemory*>(mem);}
 
+    /// Get all statistics
+    Dict get_stats(void* mem) const override;
+
     /// Evaluate SX, possibly transposed
     virtual void linsol_eval_sx(const SXElem** arg, SXElem** res,
                                 casadi_int* iw, SXElem* w, void* mem,
@@ -113,10 +137,64 @@ namespace casadi {
     /// Matrix rank
     virtual casadi_int rank(void* mem, const double* A) const;
 
+    /// Can the plugin factorize in single precision?
+    virtual bool has_mixed_precision() const { return false;}
+
+    /** \brief Solve with a single precision factorization and iterative refinement
+
+        The right-hand-sides in x are overwritten by the solution. solve_lo solves a
+        single right-hand-side in place with the single precision factors. Corrections
+        are computed from residuals in double precision until the residual drops below
+        refine_tol times the right-hand-side, stagnates, or refine_max_iter is reached.
+    */
+    int refine(void* mem, const double* A, double* x, casadi_int nrhs, bool tr,
+               const std::function<int(float*)>& solve_lo) const;
+
     /// Generate C code
     virtual void generate(CodeGenerator& g, const std::string& A, const std::string& x,
                           casadi_int nrhs, bool tr) const;
 
+    /** \brief Partition an elimination tree into independent subtrees
+
+        The parent of column r is the first column c>r with an entry (r, c) in the
+        triangular factor pattern sp_u. Maximal subtrees with at most
+        ncol/nthreads columns are distributed over at most nthreads tasks, unless they
+        have fewer than cutoff columns.
+        Columns of a task, in increasing order, only depend on columns of the same task.
+        The remaining columns, which must be handled afterwards, are returned in rest.
+        If there is nothing to parallelize, tasks is empty.
+    */
+    static void etree_tasks(const Sparsity& sp_u, casadi_int nthreads, casadi_int cutoff,
+                            std::vector<std::vector<casadi_int> >& tasks,
+                            std::vector<casadi_int>& rest);
+
+    /** \brief Call f(0), ..., f(n-1) in parallel threads
+
+        Serial if CasADi was not compiled with WITH_THREAD=ON.
+    */
+    static void parallel_for(casadi_int n, const std::function<void(casadi_int)>& f);
+
+    /** \brief Shared symbolic analysis
+
+        Look up the result of a symbolic analysis in a process-wide cache, keyed by the
+        plugin name, a string encoding the options that affect the analysis, and the
+        sparsity pattern. On a miss, analyze() is called and the result is inserted.
+        Entries live as long as some solver instance holds the returned pointer.
+    */
+    template<typename T>
+    std::shared_ptr<const T> symbolic_cache(const std::string& key,
+                                            const std::function<T()>& analyze) {
+      std::shared_ptr<const void> r;
+      if (symbolic_cache_) r = symbolic_cache_find(key);
+      if (r) {
+        if (verbose_) casadi_message("Reusing symbolic analysis for " + key);
+      } else {
+        r = std::make_shared<const T>(analyze());
+        if (symbolic_cache_) r = symbolic_cache_insert(key, r);
+      }
+      return std::static_pointer_cast<const T>(r);
+    }
+
     // Creator function for internal class
     typedef LinsolInternal* (*Creator)(const std::string& name, const Sparsity& sp);
 
@@ -156,6 +234,27 @@ namespace casadi {
     // Sparsity pattern of the linear system
     Sparsity sp_;
 
+    // Share symbolic analyses between instances
+    bool symbolic_cache_;
+
+    ///@{
+    // Single precision factorization with iterative refinement
+    bool mixed_precision_;
+    casadi_int refine_max_iter_;
+    double refine_tol_;
+    ///@}
+
+    // Skip refactorization if the matrix is unchanged
+    bool reuse_factorization_;
+
+    // Is the matrix identical to the last one factorized in this memory?
+    bool is_factorized(void* mem, const double* A) const;
+
+    // Look up or insert a symbolic analysis in the process-wide cache
+    std::shared_ptr<const void> symbolic_cache_find(const std::string& key) const;
+    std::shared_ptr<const void> symbolic_cache_insert(const std::string& key,
+      const std::shared_ptr<const void>& data) const;
+
   protected:
     /** \brief Deserializing constructor
 
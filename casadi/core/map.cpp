@@ -25,6 +25,8 @@
 
 #include "map.hpp"
 #include "serializing_stream.hpp"
+#include "mx_function.hpp"
+#include "solve.hpp"
 
 #ifdef CASADI_WITH_THREAD
 #ifdef CASADI_WITH_THREAD_MINGW
@@ -40,6 +42,9 @@ namespace casadi {
     // Create instance of the right class
     std::string suffix = str(n) + "_" + f.name();
     if (parallelization == "serial") {
+      if (BatchSolveMap::applies(f)) {
+        return Function::create(new BatchSolveMap("map" + suffix, f, n), Dict());
+      }
       return Function::create(new Map("map" + suffix, f, n), Dict());
     } else if (parallelization== "openmp") {
       return Function::create(new OmpMap("ompmap" + suffix, f, n), Dict());
@@ -69,6 +74,11 @@ namespace casadi {
       || (recursive && Map::is_a(type, recursive));
   }
 
+  bool BatchSolveMap::is_a(const std::string& type, bool recursive) const {
+    return type=="BatchSolveMap"
+      || (recursive && Map::is_a(type, recursive));
+  }
+
  std::vector<std::string> Map::get_function() const {
     return {"f"};
   }
@@ -109,6 +119,8 @@ namespace casadi {
       return new OmpMap(s);
     } else if (class_name=="ThreadMap") {
       return new ThreadMap(s);
+    } else if (class_name=="BatchSolveMap") {
+      return new BatchSolveMap(s);
     } else {
       casadi_error("class name '" + class_name + "' unknown.");
     }
@@ -519,4 +531,125 @@ namespace casadi {
     alloc_iw(f_.sz_iw() * n_);
   }
 
+  const casadi_int BatchSolveMap::max_size;
+  const casadi_int BatchSolveMap::max_batch;
+
+  BatchSolveMap::~BatchSolveMap() {
+    clear_mem();
+  }
+
+  bool BatchSolveMap::applies(const Function& f) {
+    // A single linear solve with a linear solver instance, directly on the inputs
+    if (!f.is_a("MXFunction") || f.n_in()!=2 || f.n_out()!=1) return false;
+    const MXFunction* fm = static_cast<const MXFunction*>(f.get());
+    const MX& x = fm->out_.at(0);
+    if (x.op()!=OP_SOLVE) return false;
+    Linsol linsol;
+    if (auto s = dynamic_cast<const LinsolCall<false>*>(x.get())) {
+      linsol = s->linsol_;
+    } else if (auto s = dynamic_cast<const LinsolCall<true>*>(x.get())) {
+      linsol = s->linsol_;
+    } else {
+      return false;
+    }
+    // Least-squares solutions are not reproduced by the LU factorization
+    if (linsol.plugin_name()=="lsqr") return false;
+    const MX& A = x.dep(1);
+    const MX& b = x.dep(0);
+    if (!b.is_dense() || A.size1()>max_size) return false;
+    // Solvers for symmetric matrices may only reference one triangle of the pattern.
+    // csparsecholesky uses the upper triangle, which is mirrored in eval, for other
+    // symmetric solvers the pattern must be structurally symmetric
+    static const std::vector<std::string> unsymmetric = {"csparse", "qr", "lapacklu",
+      "lapackqr", "symbolicqr"};
+    if (linsol.plugin_name()!="csparsecholesky"
+        && std::find(unsymmetric.begin(), unsymmetric.end(), linsol.plugin_name())
+          ==unsymmetric.end()
+        && !A.sparsity().is_symmetric()) return false;
+    return (MX::is_equal(A, fm->in_[0]) && MX::is_equal(b, fm->in_[1]))
+      || (MX::is_equal(A, fm->in_[1]) && MX::is_equal(b, fm->in_[0]));
+  }
+
+  void BatchSolveMap::analyze() {
+    const MXFunction* fm = static_cast<const MXFunction*>(f_.get());
+    const MX& x = fm->out_.at(0);
+    ind_a_ = MX::is_equal(x.dep(1), fm->in_[0]) ? 0 : 1;
+    ind_b_ = 1 - ind_a_;
+    sp_a_ = x.dep(1).sparsity();
+    nrhs_ = x.dep(0).size2();
+    tr_ = x.info().at("tr");
+    Linsol linsol = tr_ ? dynamic_cast<const LinsolCall<true>*>(x.get())->linsol_
+                        : dynamic_cast<const LinsolCall<false>*>(x.get())->linsol_;
+    chol_ = linsol.plugin_name()=="csparsecholesky";
+    nbatch_ = std::min(n_, max_batch);
+  }
+
+  void BatchSolveMap::init(const Dict& opts) {
+    // Call the initialization method of the base class
+    Map::init(opts);
+
+    // Linear system
+    analyze();
+
+    // Interleaved matrices, right-hand-sides and pivots
+    casadi_int na = sp_a_.size1();
+    alloc_w(nbatch_ * na * (na + 1));
+    alloc_iw(nbatch_ * na);
+  }
+
+  BatchSolveMap::BatchSolveMap(DeserializingStream& s) : Map(s) {
+    analyze();
+  }
+
+  int BatchSolveMap::eval(const double** arg, double** res, casadi_int* iw, double* w,
+      void* mem) const {
+    const double *A = arg[ind_a_], *b = arg[ind_b_];
+    double* x = res[0];
+    if (!x) return 0;
+    casadi_int na = sp_a_.size1(), nnz_a = sp_a_.nnz(), nx = na * nrhs_;
+    const casadi_int *colind = sp_a_.colind(), *row = sp_a_.row();
+    double *a = w, *xb = w + nbatch_ * na * na;
+    for (casadi_int k0=0; k0<n_; k0+=nbatch_) {
+      casadi_int nb = std::min(nbatch_, n_ - k0);
+      // Interleave the matrices
+      casadi_clear(a, na * na * nb);
+      if (A) {
+        for (casadi_int k=0; k<nb; ++k) {
+          const double* Ak = A + (k0 + k) * nnz_a;
+          for (casadi_int c=0; c<na; ++c) {
+            for (casadi_int el=colind[c]; el<colind[c+1]; ++el) {
+              if (chol_) {
+                // Symmetric matrix from the upper triangle, as csparsecholesky
+                if (row[el]>c) continue;
+                a[(c + row[el] * na) * nb + k] = Ak[el];
+              }
+              a[(row[el] + c * na) * nb + k] = Ak[el];
+            }
+          }
+        }
+      }
+      // Factorize
+      if (chol_ ? casadi_chol_batch(a, na, nb) : casadi_lu_batch(a, na, nb, iw)) return 1;
+      // Solve for each right-hand-side
+      for (casadi_int r=0; r<nrhs_; ++r) {
+        for (casadi_int k=0; k<nb; ++k) {
+          for (casadi_int i=0; i<na; ++i) {
+            xb[i * nb + k] = b ? b[(k0 + k) * nx + r * na + i] : 0;
+          }
+        }
+        if (chol_) {
+          casadi_chol_batch_solve(a, na, nb, xb);
+        } else {
+          casadi_lu_batch_solve(a, na, nb, iw, xb, tr_);
+        }
+        for (casadi_int k=0; k<nb; ++k) {
+          for (casadi_int i=0; i<na; ++i) {
+            x[(k0 + k) * nx + r * na + i] = xb[i * nb + k];
+          }
+        }
+      }
+    }
+    return 0;
+  }
+
 } // namespace casadi
@@ -316,6 +316,63 @@ namespace casadi {
     explicit ThreadMap(DeserializingStream& s) : Map(s) {}
   };
 
+  /** A serial map of a function that performs a single linear solve with a small matrix
+
+      The matrices of all evaluations are factorized together with batched dense LU or
+      Cholesky kernels, which store the matrices interleaved so that the innermost loops
+      run over the evaluations.
+  */
+  class CASADI_EXPORT BatchSolveMap : public Map {
+    friend class Map;
+  public:
+    // Constructor (protected, use create function in Map)
+    BatchSolveMap(const std::string& name, const Function& f, casadi_int n) : Map(name, f, n) {}
+
+    /** \brief  Destructor */
+    ~BatchSolveMap() override;
+
+    /** \brief Get type name */
+    std::string class_name() const override {return "BatchSolveMap";}
+
+    /** \brief Check if the function is of a particular type */
+    bool is_a(const std::string& type, bool recursive) const override;
+
+    /// Can a map of the function be evaluated with batched factorizations?
+    static bool applies(const Function& f);
+
+    /// Evaluate the function numerically
+    int eval(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const override;
+
+    /** \brief  Initialize */
+    void init(const Dict& opts) override;
+
+    /// Largest matrix dimension handled by the batched kernels
+    static const casadi_int max_size = 20;
+
+    /// Largest number of matrices factorized together
+    static const casadi_int max_batch = 64;
+
+  protected:
+    /** \brief Deserializing constructor */
+    explicit BatchSolveMap(DeserializingStream& s);
+
+    // Extract the linear system from the function
+    void analyze();
+
+    // Inputs holding the matrix and the right-hand-sides
+    casadi_int ind_a_, ind_b_;
+
+    // Sparsity pattern of the matrix, number of right-hand-sides
+    Sparsity sp_a_;
+    casadi_int nrhs_;
+
+    // Transposed system, Cholesky factorization
+    bool tr_, chol_;
+
+    // Number of matrices factorized together
+    casadi_int nbatch_;
+  };
+
 } // namespace casadi
 /// \endcond
 
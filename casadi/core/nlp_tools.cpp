@@ -224,4 +224,250 @@ void detect_simple_bounds(const MX& x, const MX& p,
     gi, lbx, ubx, lam_forward, lam_backward);
 }
 
+// Find the group of a variable, with path halving
+static casadi_int ocp_group(std::vector<casadi_int>& parent, casadi_int c) {
+  while (parent[c]!=c) c = parent[c] = parent[parent[c]];
+  return c;
+}
+
+// Merge the groups of two variables, returns true if they were different
+static bool ocp_merge(std::vector<casadi_int>& parent, casadi_int c1, casadi_int c2) {
+  c1 = ocp_group(parent, c1);
+  c2 = ocp_group(parent, c2);
+  if (c1==c2) return false;
+  parent[std::max(c1, c2)] = std::min(c1, c2);
+  return true;
+}
+
+/* Group the variables into a chain of stages. The identity entry (pivot) of a
+   gap-closing constraint is the only entry which may lie in the next stage.
+   Ties between pivot candidates are broken with the latest or earliest variable,
+   optionally preferring variables which appear in more than one constraint.
+   Returns the number of stages, the stage of each variable and the pivot of each
+   constraint (-1 if the constraint does not link two stages) */
+static casadi_int ocp_stages(const Sparsity& A, const Sparsity& H, bool latest, bool linked_first,
+    std::vector<casadi_int>& stage, std::vector<casadi_int>& pivot) {
+  casadi_int n = A.size2(), m = A.size1();
+  // Variables of each constraint
+  Sparsity AT = A.T();
+  const casadi_int *AT_colind = AT.colind(), *AT_row = AT.row();
+  // Constraints of each variable
+  const casadi_int *A_colind = A.colind(), *A_row = A.row();
+
+  // Choose the pivots: a variable which does not appear together with any other
+  // variable of the constraint in a different constraint
+  pivot.assign(m, -1);
+  std::vector<bool> is_pivot(n, false);
+  std::vector<casadi_int> shared(m, 0);
+  for (casadi_int r=0; r<m; ++r) {
+    if (AT_colind[r+1]-AT_colind[r]<2) continue;
+    // Number of variables each constraint has in common with r
+    for (casadi_int k=AT_colind[r]; k<AT_colind[r+1]; ++k) {
+      casadi_int c = AT_row[k];
+      for (casadi_int el=A_colind[c]; el<A_colind[c+1]; ++el) shared[A_row[el]]++;
+    }
+    casadi_int best = -1;
+    bool best_linked = false;
+    for (casadi_int k=AT_colind[r]; k<AT_colind[r+1]; ++k) {
+      casadi_int c = AT_row[k];
+      if (is_pivot[c]) continue;
+      bool isolated = true;
+      for (casadi_int el=A_colind[c]; el<A_colind[c+1]; ++el) {
+        if (A_row[el]!=r && shared[A_row[el]]>1) isolated = false;
+      }
+      if (!isolated) continue;
+      // Variables which are used in the next stage
+      bool linked = linked_first && A_colind[c+1]-A_colind[c]>1;
+      if (best<0 || (linked && !best_linked) || (linked==best_linked && latest)) {
+        best = c;
+        best_linked = linked;
+      }
+    }
+    for (casadi_int k=AT_colind[r]; k<AT_colind[r+1]; ++k) {
+      casadi_int c = AT_row[k];
+      for (casadi_int el=A_colind[c]; el<A_colind[c+1]; ++el) shared[A_row[el]] = 0;
+    }
+    if (best>=0) {
+      pivot[r] = best;
+      is_pivot[best] = true;
+    }
+  }
+
+  // Variables in the same constraint, other than the pivot, are in the same stage
+  std::vector<casadi_int> parent(n);
+  for (casadi_int c=0; c<n; ++c) parent[c] = c;
+  for (casadi_int r=0; r<m; ++r) {
+    casadi_int first = -1;
+    for (casadi_int k=AT_colind[r]; k<AT_colind[r+1]; ++k) {
+      casadi_int c = AT_row[k];
+      if (c==pivot[r]) continue;
+      if (first<0) {
+        first = c;
+      } else {
+        ocp_merge(parent, first, c);
+      }
+    }
+  }
+  // Variables coupled in the Hessian are in the same stage
+  const casadi_int *H_colind = H.colind(), *H_row = H.row();
+  for (casadi_int c=0; c<n; ++c) {
+    for (casadi_int el=H_colind[c]; el<H_colind[c+1]; ++el) ocp_merge(parent, H_row[el], c);
+  }
+
+  // Merge groups until they form a single chain
+  std::vector<casadi_int> succ(n), pred(n);
+  std::vector<std::vector<casadi_int> > chains;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    // Each stage is linked to at most one previous and one next stage
+    std::fill(succ.begin(), succ.end(), -1);
+    std::fill(pred.begin(), pred.end(), -1);
+    for (casadi_int r=0; r<m; ++r) {
+      if (pivot[r]<0) continue;
+      casadi_int g = -1;
+      for (casadi_int k=AT_colind[r]; k<AT_colind[r+1] && g<0; ++k) {
+        if (AT_row[k]!=pivot[r]) g = ocp_group(parent, AT_row[k]);
+      }
+      casadi_int h = ocp_group(parent, pivot[r]);
+      if (g==h) continue;
+      if (succ[g]<0) {
+        succ[g] = h;
+      } else if (ocp_merge(parent, succ[g], h)) {
+        changed = true;
+      }
+      if (pred[h]<0) {
+        pred[h] = g;
+      } else if (ocp_merge(parent, pred[h], g)) {
+        changed = true;
+      }
+    }
+    if (changed) continue;
+    // Collect the chains
+    chains.clear();
+    std::vector<bool> visited(n, false);
+    for (casadi_int c=0; c<n; ++c) {
+      if (parent[c]!=c || pred[c]>=0) continue;
+      chains.emplace_back();
+      for (casadi_int g=c; g>=0; g=succ[g]) {
+        chains.back().push_back(g);
+        visited[g] = true;
+      }
+    }
+    // Merge cycles
+    for (casadi_int c=0; c<n; ++c) {
+      if (parent[c]!=c || visited[c]) continue;
+      visited[c] = true;
+      for (casadi_int g=succ[c]; g!=c; g=succ[g]) {
+        visited[g] = true;
+        ocp_merge(parent, c, g);
+      }
+      changed = true;
+    }
+    if (changed) continue;
+    // Merge unconnected chains stage by stage into the longest one
+    if (chains.size()>1) {
+      casadi_int longest = 0;
+      for (casadi_int i=1; i<chains.size(); ++i) {
+        if (chains[i].size()>chains[longest].size()) longest = i;
+      }
+      for (casadi_int i=0; i<chains.size(); ++i) {
+        if (i==longest) continue;
+        for (casadi_int j=0; j<chains[i].size(); ++j) {
+          ocp_merge(parent, chains[longest][j], chains[i][j]);
+        }
+      }
+      changed = true;
+    }
+  }
+  if (n==0) return 0;
+
+  // Stage of each variable
+  std::vector<casadi_int> ind(n, -1);
+  for (casadi_int k=0; k<chains[0].size(); ++k) ind[chains[0][k]] = k;
+  stage.resize(n);
+  for (casadi_int c=0; c<n; ++c) stage[c] = ind[ocp_group(parent, c)];
+
+  // Pivots which ended up in the same stage as the rest of the constraint
+  for (casadi_int r=0; r<m; ++r) {
+    if (pivot[r]<0) continue;
+    for (casadi_int k=AT_colind[r]; k<AT_colind[r+1]; ++k) {
+      if (AT_row[k]!=pivot[r]) {
+        if (stage[AT_row[k]]==stage[pivot[r]]) pivot[r] = -1;
+        break;
+      }
+    }
+  }
+  return chains[0].size();
+}
+
+bool detect_ocp_structure(const Sparsity& A, const Sparsity& H,
+    std::vector<casadi_int>& perm_x, std::vector<casadi_int>& perm_a,
+    std::vector<casadi_int>& nx, std::vector<casadi_int>& nu, std::vector<casadi_int>& ng) {
+  casadi_int n = A.size2(), m = A.size1();
+  casadi_assert(H.size1()==n && H.size2()==n,
+    "Dimension mismatch: A is " + A.dim() + ", but H is " + H.dim() + ".");
+
+  // Try all tie-breaking rules, keep the finest structure
+  std::vector<casadi_int> stage, pivot, stage2, pivot2;
+  casadi_int n_stage = -1;
+  for (bool latest : {true, false}) {
+    for (bool linked_first : {false, true}) {
+      casadi_int n_stage2 = ocp_stages(A, H, latest, linked_first, stage2, pivot2);
+      if (n_stage2>n_stage) {
+        n_stage = n_stage2;
+        stage.swap(stage2);
+        pivot.swap(pivot2);
+      }
+    }
+  }
+  if (n_stage==0) return false;
+
+  // Gap-closing constraint of each state
+  std::vector<casadi_int> gap(n, -1);
+  for (casadi_int r=0; r<m; ++r) {
+    if (pivot[r]>=0) gap[pivot[r]] = r;
+  }
+
+  // Variables of each stage: states first, then controls.
+  // All variables of the first stage are treated as states.
+  std::vector< std::vector<casadi_int> > states(n_stage), controls(n_stage);
+  for (casadi_int c=0; c<n; ++c) {
+    if (stage[c]==0 || gap[c]>=0) {
+      states[stage[c]].push_back(c);
+    } else {
+      controls[stage[c]].push_back(c);
+    }
+  }
+
+  // Remaining constraints of each stage
+  std::vector< std::vector<casadi_int> > path(n_stage);
+  Sparsity AT = A.T();
+  const casadi_int *AT_colind = AT.colind(), *AT_row = AT.row();
+  for (casadi_int r=0; r<m; ++r) {
+    if (pivot[r]>=0) continue;
+    casadi_int k = AT_colind[r+1]>AT_colind[r] ? stage[AT_row[AT_colind[r]]] : 0;
+    path[k].push_back(r);
+  }
+
+  // Assemble
+  perm_x.clear();
+  perm_a.clear();
+  nx.clear();
+  nu.clear();
+  ng.clear();
+  for (casadi_int k=0; k<n_stage; ++k) {
+    perm_x.insert(perm_x.end(), states[k].begin(), states[k].end());
+    perm_x.insert(perm_x.end(), controls[k].begin(), controls[k].end());
+    if (k+1<n_stage) {
+      for (casadi_int c : states[k+1]) perm_a.push_back(gap[c]);
+    }
+    perm_a.insert(perm_a.end(), path[k].begin(), path[k].end());
+    nx.push_back(states[k].size());
+    nu.push_back(controls[k].size());
+    ng.push_back(path[k].size());
+  }
+  return n_stage>1;
+}
+
 } // namespace casadi
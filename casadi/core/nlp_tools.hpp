@@ -62,6 +62,37 @@ namespace casadi {
       Function& SWIG_OUTPUT(lam_backward));
   //@}
 
+  /** \brief Detect the stage structure of an optimal control problem
+   *
+   * Given the sparsity of the constraint Jacobian A and of the Hessian H of a
+   * (possibly permuted) multi-stage problem, look for a reordering of the variables
+   * and constraints into the form expected by structure-exploiting solvers
+   * such as hpipm and fatrop:
+   * \verbatim
+   *   variables:   x0 u0 x1 u1 ... xN uN
+   *   constraints: dyn0 g0 dyn1 g1 ... gN
+   * \endverbatim
+   * where each gap-closing constraint of dynk has exactly one nonzero in the states
+   * xk+1 (identity structure) and all other entries in stage k.
+   *
+   * The stages are found by grouping variables that appear together in a constraint or in
+   * the Hessian. Only the sparsity is used, so the identity entry of a gap-closing
+   * constraint can be ambiguous. Such ties are broken with the original variable order.
+   * The result is always a valid structure, but ambiguous problems may get fewer,
+   * larger stages than the problem has.
+   *
+   * \param[out] perm_x variables in stage-wise order
+   * \param[out] perm_a constraints in stage-wise order
+   * \param[out] nx,nu,ng number of states, controls and path constraints per stage
+   * \return true if at least two stages were found
+   */
+  CASADI_EXPORT bool detect_ocp_structure(const Sparsity& A, const Sparsity& H,
+      std::vector<casadi_int>& SWIG_OUTPUT(perm_x),
+      std::vector<casadi_int>& SWIG_OUTPUT(perm_a),
+      std::vector<casadi_int>& SWIG_OUTPUT(nx),
+      std::vector<casadi_int>& SWIG_OUTPUT(nu),
+      std::vector<casadi_int>& SWIG_OUTPUT(ng));
+
 /*
   CASADI_EXPORT void detect_simple_bounds(const SX& xX,
       const SX& g, const SX& lbg, const SX& ubg,
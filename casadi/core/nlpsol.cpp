@@ -28,6 +28,11 @@
 #include "casadi/core/timing.hpp"
 #include "nlp_builder.hpp"
 #include "nlp_tools.hpp"
+#include "linsol.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 
 namespace casadi {
 
@@ -278,6 +283,9 @@ namespace casadi {
     no_nlp_grad_ = false;
     error_on_fail_ = false;
     sens_linsol_ = "qr";
+    sens_reuse_factorization_ = false;
+    warm_start_cache_ = 0;
+    warm_start_cache_radius_ = inf;
   }
 
   Nlpsol::~Nlpsol() {
@@ -374,6 +382,11 @@ namespace casadi {
       {"no_nlp_grad",
        {OT_BOOL,
         "Prevent the creation of the 'nlp_grad' function"}},
+      {"hvp_ndir",
+       {OT_INT,
+        "Create an 'nlp_hvp' function, calculating the product of the Hessian of the "
+        "Lagrangian with this many directions at once (forward-over-reverse). "
+        "Default 0: not created"}},
       {"bound_consistency",
        {OT_BOOL,
         "Ensure that primal-dual solution is consistent with the bounds"}},
@@ -389,6 +402,25 @@ namespace casadi {
       {"sens_linsol_options",
        {OT_DICT,
         "Linear solver options used for parametric sensitivities."}},
+      {"sens_reuse_factorization",
+       {OT_BOOL,
+        "Share one linear solver between all parametric sensitivity functions and "
+        "skip the factorization of the KKT matrix when it is unchanged since the "
+        "previous sensitivity evaluation (default false)."}},
+      {"warm_start_cache",
+       {OT_INT,
+        "Keep up to this many converged solutions in memory and initialize x0, lam_x0 "
+        "and lam_g0 of each solve from the one with the nearest parameter value. "
+        "Default 0: disabled"}},
+      {"warm_start_cache_file",
+       {OT_STRING,
+        "File from which the warm start cache is populated at initialization and "
+        "to which converged solutions are appended. The file is rewritten with the "
+        "entries in memory when it holds twice their maximum number"}},
+      {"warm_start_cache_radius",
+       {OT_DOUBLE,
+        "Only warm start from cached solutions within this (Euclidean) distance "
+        "in the parameters (default: inf)"}},
       {"detect_simple_bounds",
        {OT_BOOL,
         "Automatically detect simple bounds (lbx/ubx) (default false). "
@@ -409,6 +441,9 @@ namespace casadi {
   };
 
   void Nlpsol::init(const Dict& opts) {
+    // Default options
+    casadi_int hvp_ndir = 0;
+
     // Read options
     for (auto&& op : opts) {
       if (op.first=="detect_simple_bounds_is_simple") {
@@ -456,6 +491,8 @@ namespace casadi {
         calc_g_ = op.second;
       } else if (op.first=="no_nlp_grad") {
         no_nlp_grad_ = op.second;
+      } else if (op.first=="hvp_ndir") {
+        hvp_ndir = op.second;
       } else if (op.first=="bound_consistency") {
         bound_consistency_ = op.second;
       } else if (op.first=="min_lam") {
@@ -464,8 +501,17 @@ namespace casadi {
         sens_linsol_ = op.second.to_string();
       } else if (op.first=="sens_linsol_options") {
         sens_linsol_options_ = op.second;
+      } else if (op.first=="sens_reuse_factorization") {
+        sens_reuse_factorization_ = op.second;
+      } else if (op.first=="warm_start_cache") {
+        warm_start_cache_ = op.second;
+      } else if (op.first=="warm_start_cache_file") {
+        warm_start_cache_file_ = op.second.to_string();
+      } else if (op.first=="warm_start_cache_radius") {
+        warm_start_cache_radius_ = op.second;
       }
     }
+    casadi_assert(warm_start_cache_>=0, "Option 'warm_start_cache' must be nonnegative");
 
     // Deprecated option
     if (calc_multipliers_) {
@@ -555,6 +601,13 @@ namespace casadi {
                       {"f", "g", "grad:gamma:x", "grad:gamma:p"},
                       {{"gamma", {"f", "g"}}});
     }
+
+    // Function calculating Hessian-of-the-Lagrangian-vector products, matrix-free
+    if (hvp_ndir > 0) {
+      create_function("nlp_hvp", {"x", "p", "lam:f", "lam:g", "fwd:x"},
+                      {"hvp:gamma:x"}, {{"gamma", {"f", "g"}}},
+                      {{"hvp_ndir", hvp_ndir}});
+    }
   }
 
   int detect_bounds_callback(const double** arg, double** res,
@@ -590,9 +643,206 @@ namespace casadi {
     m->add_stat("callback_fun");
     m->success = false;
     m->unified_return_status = SOLVER_RET_UNKNOWN;
+
+    // Warm start cache
+    m->cache_n = m->cache_next = m->cache_file_n = 0;
+    m->cache_root = -1;
+    m->cache_hit = false;
+    m->cache_n_lookup = m->cache_n_hit = m->cache_iter_hit = m->cache_iter_miss = 0;
+    if (warm_start_cache_>0) {
+      casadi_int sz = np_ + 2*nx_ + ng_;
+      m->cache_data.resize(warm_start_cache_*sz);
+      m->cache_node.resize(warm_start_cache_);
+      m->cache_tree.clear();
+      // Populate from file, the most recent entries are kept
+      if (!warm_start_cache_file_.empty()) {
+        std::ifstream file(warm_start_cache_file_);
+        std::string line;
+        std::vector<double> e;
+        while (std::getline(file, line)) {
+          std::istringstream ss(line);
+          e.clear();
+          double v;
+          while (ss >> v) e.push_back(v);
+          if (e.empty()) continue;
+          casadi_assert(e.size()==sz, "Warm start cache file '" + warm_start_cache_file_
+            + "' does not match the problem dimensions");
+          cache_store(m, get_ptr(e), get_ptr(e) + np_, get_ptr(e) + np_ + nx_);
+          m->cache_file_n++;
+        }
+      }
+    }
     return 0;
   }
 
+  bool Nlpsol::cache_lookup(NlpsolMemory* m) const {
+    auto d_nlp = &m->d_nlp;
+    casadi_int sz = np_ + 2*nx_ + ng_;
+    m->cache_n_lookup++;
+    if (m->cache_n==0) return false;
+    casadi_int best = -1;
+    if (np_==0) {
+      // All entries are equally close, take the most recent one
+      best = (m->cache_next + warm_start_cache_ - 1) % warm_start_cache_;
+    } else {
+      // Squared distance to the nearest entry so far
+      double best_dist = warm_start_cache_radius_*warm_start_cache_radius_;
+      std::vector<double> p(np_);
+      casadi_copy(d_nlp->p, np_, get_ptr(p));
+      cache_nearest(m, m->cache_root, 0, get_ptr(p), best_dist, best);
+      if (best<0) return false;
+    }
+    // Initialize from the cached solution
+    const double* e = get_ptr(m->cache_data) + best*sz;
+    casadi_copy(e + np_, nx_, d_nlp->z);
+    casadi_copy(e + np_ + nx_, nx_ + ng_, d_nlp->lam);
+    m->cache_n_hit++;
+    return true;
+  }
+
+  void Nlpsol::cache_nearest(const NlpsolMemory* m, casadi_int node, casadi_int depth,
+      const double* p, double& best_dist, casadi_int& best) const {
+    if (node<0) return;
+    const NlpsolMemory::CacheNode& c = m->cache_tree[node];
+    if (c.entry>=0) {
+      const double* e = get_ptr(m->cache_data) + c.entry*(np_ + 2*nx_ + ng_);
+      double dist = 0;
+      for (casadi_int i=0; i<np_; ++i) dist += (e[i] - p[i])*(e[i] - p[i]);
+      if (dist < best_dist || (best<0 && dist==best_dist)) {
+        best_dist = dist;
+        best = c.entry;
+      }
+    }
+    // The far side only needs to be visited if the splitting plane is close enough
+    double d = p[depth % np_] - c.split;
+    cache_nearest(m, d<0 ? c.left : c.right, depth+1, p, best_dist, best);
+    if (d*d<=best_dist) cache_nearest(m, d<0 ? c.right : c.left, depth+1, p, best_dist, best);
+  }
+
+  void Nlpsol::cache_store(NlpsolMemory* m, const double* p, const double* x,
+      const double* lam) const {
+    casadi_int sz = np_ + 2*nx_ + ng_;
+    casadi_int k = m->cache_next;
+    // When full, the oldest entry is replaced
+    if (m->cache_n==warm_start_cache_) {
+      if (np_>0) m->cache_tree[m->cache_node[k]].entry = -1;
+    } else {
+      m->cache_n++;
+    }
+    double* e = get_ptr(m->cache_data) + k*sz;
+    casadi_copy(p, np_, e);
+    casadi_copy(x, nx_, e + np_);
+    casadi_copy(lam, nx_ + ng_, e + np_ + nx_);
+    m->cache_next = (k+1) % warm_start_cache_;
+    if (np_==0) return;
+    // Rebuild the tree once half of its nodes are unused, otherwise insert
+    if (static_cast<casadi_int>(m->cache_tree.size()) >= 2*m->cache_n) {
+      m->cache_tree.clear();
+      std::vector<casadi_int> entries = range(m->cache_n);
+      m->cache_root = cache_build(m, get_ptr(entries), m->cache_n, 0);
+    } else {
+      cache_insert(m, k);
+    }
+  }
+
+  void Nlpsol::cache_insert(NlpsolMemory* m, casadi_int k) const {
+    const double* e = get_ptr(m->cache_data) + k*(np_ + 2*nx_ + ng_);
+    // Descend to an empty leaf
+    std::vector<casadi_int> path;
+    for (casadi_int c=m->cache_root; c>=0; ) {
+      const NlpsolMemory::CacheNode& n = m->cache_tree[c];
+      path.push_back(c);
+      c = e[(path.size()-1) % np_] < n.split ? n.left : n.right;
+    }
+    casadi_int depth = path.size();
+    casadi_int node = m->cache_tree.size();
+    m->cache_tree.push_back({k, e[depth % np_], -1, -1});
+    m->cache_node[k] = node;
+    if (depth==0) {
+      m->cache_root = node;
+    } else {
+      NlpsolMemory::CacheNode& n = m->cache_tree[path.back()];
+      (e[(depth-1) % np_] < n.split ? n.left : n.right) = node;
+    }
+    // Too deep: rebuild the subtree of the lowest ancestor with an unbalanced child
+    if (depth <= 1 + std::log(static_cast<double>(2*m->cache_n))/std::log(4./3)) return;
+    casadi_int size = 1;
+    for (casadi_int i=depth-1; i>=0; --i) {
+      const NlpsolMemory::CacheNode& n = m->cache_tree[path[i]];
+      casadi_int child = i+1<depth ? path[i+1] : node;
+      casadi_int size_i = size + 1 + cache_count(m, n.left==child ? n.right : n.left);
+      if (size > 0.75*size_i) {
+        std::vector<casadi_int> entries;
+        cache_collect(m, path[i], entries);
+        casadi_int sub = cache_build(m, get_ptr(entries), entries.size(), i);
+        if (i==0) {
+          m->cache_root = sub;
+        } else {
+          NlpsolMemory::CacheNode& parent = m->cache_tree[path[i-1]];
+          (parent.left==path[i] ? parent.left : parent.right) = sub;
+        }
+        return;
+      }
+      size = size_i;
+    }
+  }
+
+  casadi_int Nlpsol::cache_build(NlpsolMemory* m, casadi_int* entries, casadi_int n,
+      casadi_int depth) const {
+    if (n==0) return -1;
+    casadi_int sz = np_ + 2*nx_ + ng_, dim = depth % np_, mid = n/2;
+    const double* data = get_ptr(m->cache_data);
+    // Split at the median
+    std::nth_element(entries, entries + mid, entries + n, [&](casadi_int a, casadi_int b) {
+      return data[a*sz + dim] < data[b*sz + dim];});
+    casadi_int node = m->cache_tree.size();
+    m->cache_tree.push_back({entries[mid], data[entries[mid]*sz + dim], -1, -1});
+    m->cache_node[entries[mid]] = node;
+    casadi_int left = cache_build(m, entries, mid, depth+1);
+    casadi_int right = cache_build(m, entries + mid + 1, n - mid - 1, depth+1);
+    m->cache_tree[node].left = left;
+    m->cache_tree[node].right = right;
+    return node;
+  }
+
+  casadi_int Nlpsol::cache_count(const NlpsolMemory* m, casadi_int node) const {
+    if (node<0) return 0;
+    const NlpsolMemory::CacheNode& n = m->cache_tree[node];
+    return 1 + cache_count(m, n.left) + cache_count(m, n.right);
+  }
+
+  void Nlpsol::cache_collect(const NlpsolMemory* m, casadi_int node,
+      std::vector<casadi_int>& entries) const {
+    if (node<0) return;
+    const NlpsolMemory::CacheNode& n = m->cache_tree[node];
+    if (n.entry>=0) entries.push_back(n.entry);
+    cache_collect(m, n.left, entries);
+    cache_collect(m, n.right, entries);
+  }
+
+  void Nlpsol::cache_write(NlpsolMemory* m) const {
+    casadi_int sz = np_ + 2*nx_ + ng_;
+    auto write = [&](std::ostream& file, casadi_int k) {
+      const double* e = get_ptr(m->cache_data) + k*sz;
+      for (casadi_int i=0; i<sz; ++i) file << (i==0 ? "" : " ") << e[i];
+      file << "\n";
+    };
+    if (m->cache_file_n < 2*warm_start_cache_) {
+      // Append the last entry
+      std::ofstream file(warm_start_cache_file_, std::ios::app);
+      file << std::setprecision(17);
+      write(file, (m->cache_next + warm_start_cache_ - 1) % warm_start_cache_);
+      m->cache_file_n++;
+    } else {
+      // Replace by the entries in memory, oldest first
+      std::ofstream file(warm_start_cache_file_);
+      file << std::setprecision(17);
+      casadi_int first = m->cache_n==warm_start_cache_ ? m->cache_next : 0;
+      for (casadi_int i=0; i<m->cache_n; ++i) write(file, (first + i) % warm_start_cache_);
+      m->cache_file_n = m->cache_n;
+    }
+  }
+
   void Nlpsol::check_inputs(void* mem) const {
     auto m = static_cast<NlpsolMemory*>(mem);
     auto d_nlp = &m->d_nlp;
@@ -706,6 +956,9 @@ namespace casadi {
       if (casadi_detect_bounds_before(d_nlp)) return 1;
     }
 
+    // Warm start from the nearest cached solution
+    m->cache_hit = warm_start_cache_>0 && cache_lookup(m);
+
     // Set multipliers to nan
     casadi_fill(d_nlp->lam_p, np_, nan);
 
@@ -745,6 +998,17 @@ namespace casadi {
       bound_consistency(nx_+ng_, d_nlp->z, d_nlp->lam, d_nlp->lbz, d_nlp->ubz);
     }
 
+    if (warm_start_cache_>0) {
+      // Iteration count, if reported by the plugin
+      casadi_int iter_count = get_iter_count(m);
+      if (iter_count>=0) (m->cache_hit ? m->cache_iter_hit : m->cache_iter_miss) += iter_count;
+      // Store converged solutions
+      if (m->success) {
+        cache_store(m, d_nlp->p, d_nlp->z, d_nlp->lam);
+        if (!warm_start_cache_file_.empty()) cache_write(m);
+      }
+    }
+
     // Get optimal solution
     casadi_copy(d_nlp->z, nx_, d_nlp->x);
 
@@ -830,6 +1094,23 @@ namespace casadi {
     return ret;
   }
 
+  Linsol Nlpsol::sens_linsol(const Sparsity& sp) const {
+    // Quick return if cached
+    if (sens_linsol_cache_.alive()) {
+      Linsol ret = shared_cast<Linsol>(sens_linsol_cache_.shared());
+      if (ret.sparsity()==sp) return ret;
+    }
+
+    // Create a linear solver which keeps its factorization between calls
+    Dict opts = sens_linsol_options_;
+    opts["reuse_factorization"] = true;
+    Linsol ret("sens_linsol", sens_linsol_, sp, opts);
+
+    // Cache and return
+    sens_linsol_cache_ = ret;
+    return ret;
+  }
+
 
   Function Nlpsol::
   get_forward(casadi_int nfwd, const std::string& name,
@@ -926,7 +1207,11 @@ namespace casadi {
     MX v = MX::vertcat({fwd_alpha_x, fwd_alpha_g});
 
     // Solve
-    v = MX::solve(H, v, sens_linsol_, sens_linsol_options_);
+    if (sens_reuse_factorization_) {
+      v = sens_linsol(H.sparsity()).solve(H, v);
+    } else {
+      v = MX::solve(H, v, sens_linsol_, sens_linsol_options_);
+    }
 
     // Extract sensitivities in x, lam_x and lam_g
     std::vector<MX> v_split = vertsplit(v, {0, nx_, nx_+ng_});
@@ -1049,7 +1334,11 @@ namespace casadi {
 
     // Solve to get beta_x_bar, beta_g_bar
     MX v = MX::vertcat({adj_x + adj_x0, adj_lam_g + adj_lam_g0});
-    v = MX::solve(H.T(), v, sens_linsol_, sens_linsol_options_);
+    if (sens_reuse_factorization_) {
+      v = sens_linsol(H.sparsity()).solve(H, v, true);
+    } else {
+      v = MX::solve(H.T(), v, sens_linsol_, sens_linsol_options_);
+    }
     std::vector<MX> v_split = vertsplit(v, {0, nx_, nx_+ng_});
     MX beta_x_bar = v_split.at(0);
     MX beta_g_bar = v_split.at(1);
@@ -1130,6 +1419,25 @@ namespace casadi {
     auto m = static_cast<NlpsolMemory*>(mem);
     stats["success"] = m->success;
     stats["unified_return_status"] = string_from_UnifiedReturnStatus(m->unified_return_status);
+    if (warm_start_cache_>0) {
+      Dict cache;
+      cache["hit"] = m->cache_hit;
+      cache["n_entries"] = m->cache_n;
+      cache["n_lookup"] = m->cache_n_lookup;
+      cache["n_hit"] = m->cache_n_hit;
+      casadi_int n_miss = m->cache_n_lookup - m->cache_n_hit;
+      cache["hit_rate"] = m->cache_n_lookup==0 ? 0. :
+        static_cast<double>(m->cache_n_hit)/static_cast<double>(m->cache_n_lookup);
+      // Average iteration counts of warm started and other solves
+      double iter_hit = m->cache_n_hit==0 ? nan :
+        static_cast<double>(m->cache_iter_hit)/static_cast<double>(m->cache_n_hit);
+      double iter_miss = n_miss==0 ? nan :
+        static_cast<double>(m->cache_iter_miss)/static_cast<double>(n_miss);
+      cache["iter_count_hit"] = iter_hit;
+      cache["iter_count_miss"] = iter_miss;
+      cache["iter_saved"] = (iter_miss - iter_hit)*static_cast<double>(m->cache_n_hit);
+      stats["warm_start_cache"] = cache;
+    }
     return stats;
   }
 
@@ -1259,7 +1567,7 @@ namespace casadi {
   void Nlpsol::serialize_body(SerializingStream &s) const {
     OracleFunction::serialize_body(s);
 
-    s.version("Nlpsol", 3);
+    s.version("Nlpsol", 5);
     s.pack("Nlpsol::nx", nx_);
     s.pack("Nlpsol::ng", ng_);
     s.pack("Nlpsol::np", np_);
@@ -1283,6 +1591,10 @@ namespace casadi {
     s.pack("Nlpsol::detect_simple_bounds_is_simple", detect_simple_bounds_is_simple_);
     s.pack("Nlpsol::detect_simple_bounds_parts", detect_simple_bounds_parts_);
     s.pack("Nlpsol::detect_simple_bounds_target_x", detect_simple_bounds_target_x_);
+    s.pack("Nlpsol::warm_start_cache", warm_start_cache_);
+    s.pack("Nlpsol::warm_start_cache_file", warm_start_cache_file_);
+    s.pack("Nlpsol::warm_start_cache_radius", warm_start_cache_radius_);
+    s.pack("Nlpsol::sens_reuse_factorization", sens_reuse_factorization_);
   }
 
   void Nlpsol::serialize_type(SerializingStream &s) const {
@@ -1295,7 +1607,7 @@ namespace casadi {
   }
 
   Nlpsol::Nlpsol(DeserializingStream & s) : OracleFunction(s) {
-    int version = s.version("Nlpsol", 1, 3);
+    int version = s.version("Nlpsol", 1, 5);
     s.unpack("Nlpsol::nx", nx_);
     s.unpack("Nlpsol::ng", ng_);
     s.unpack("Nlpsol::np", np_);
@@ -1329,6 +1641,19 @@ namespace casadi {
       s.unpack("Nlpsol::detect_simple_bounds_parts", detect_simple_bounds_parts_);
       s.unpack("Nlpsol::detect_simple_bounds_target_x", detect_simple_bounds_target_x_);
     }
+    if (version>=4) {
+      s.unpack("Nlpsol::warm_start_cache", warm_start_cache_);
+      s.unpack("Nlpsol::warm_start_cache_file", warm_start_cache_file_);
+      s.unpack("Nlpsol::warm_start_cache_radius", warm_start_cache_radius_);
+    } else {
+      warm_start_cache_ = 0;
+      warm_start_cache_radius_ = inf;
+    }
+    if (version>=5) {
+      s.unpack("Nlpsol::sens_reuse_factorization", sens_reuse_factorization_);
+    } else {
+      sens_reuse_factorization_ = false;
+    }
     for (casadi_int i=0;i<detect_simple_bounds_is_simple_.size();++i) {
       if (detect_simple_bounds_is_simple_[i]) {
         detect_simple_bounds_target_g_.push_back(i);
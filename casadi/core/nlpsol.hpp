@@ -83,6 +83,20 @@ namespace casadi {
                                 const Function& nlp, const Dict& opts=Dict());
   ///@}
 
+  /** \brief Solve a batch of NLPs in parallel
+
+      Returns a function that solves \a n instances of the problem of \a solver, e.g. for
+      multi-start or scenario sweeps. The inputs and outputs of the instances are
+      concatenated horizontally, as for Function::map. Symbolic data of the solver is shared
+      and each worker thread owns its own solver memory. Statistics of each solve are
+      available in the "solves" entry of stats().
+
+      Options: "max_num_threads" (number of worker threads),
+      "best" (only return the successful solution with the lowest objective)
+  */
+  CASADI_EXPORT Function nlpsol_batch(const std::string& name, const Function& solver,
+                                      casadi_int n, const Dict& opts=Dict());
+
   /** \brief Get input scheme of NLP solvers
 
   * \if EXPANDED
@@ -0,0 +1,245 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#include "nlpsol_batch.hpp"
+#include "nlpsol.hpp"
+#include "serializing_stream.hpp"
+
+#include <atomic>
+#include <exception>
+#ifdef CASADI_WITH_THREAD
+#ifdef CASADI_WITH_THREAD_MINGW
+#include <mingw.thread.h>
+#else // CASADI_WITH_THREAD_MINGW
+#include <thread>
+#endif // CASADI_WITH_THREAD_MINGW
+#endif //CASADI_WITH_THREAD
+
+namespace casadi {
+
+  Function nlpsol_batch(const std::string& name, const Function& solver, casadi_int n,
+      const Dict& opts) {
+    casadi_assert(solver.is_a("Nlpsol", true), "'" + solver.name() + "' is not an NLP solver");
+    casadi_assert(n>=1, "Number of solves must be positive");
+    return Function::create(new NlpsolBatch(name, solver, n), opts);
+  }
+
+  NlpsolBatch::NlpsolBatch(const std::string& name, const Function& solver, casadi_int n)
+    : FunctionInternal(name), solver_(solver), n_(n) {
+  }
+
+  NlpsolBatch::~NlpsolBatch() {
+    clear_mem();
+  }
+
+  const Options NlpsolBatch::options_
+  = {{&FunctionInternal::options_},
+     {{"max_num_threads",
+       {OT_INT,
+        "Number of worker threads, each with its own memory of the NLP solver "
+        "(default: 1)"}},
+      {"best",
+       {OT_BOOL,
+        "Only return the solution with the lowest objective value among the successful "
+        "solves, e.g. for multi-start (default: false)"}}
+     }
+  };
+
+  const Function& NlpsolBatch::get_function(const std::string &name) const {
+    casadi_assert(has_function(name),
+      "No function \"" + name + "\" in " + name_ + ". " +
+      "Available functions: " + join(get_function()) + ".");
+    return solver_;
+  }
+
+  void NlpsolBatch::init(const Dict& opts) {
+    // Default options
+    max_num_threads_ = 1;
+    best_ = false;
+
+    // Read options, before the sparsity patterns are queried
+    for (auto&& op : opts) {
+      if (op.first=="max_num_threads") {
+        max_num_threads_ = op.second;
+      } else if (op.first=="best") {
+        best_ = op.second;
+      }
+    }
+    casadi_assert(max_num_threads_>=1, "Option 'max_num_threads' must be positive");
+    max_num_threads_ = std::min(max_num_threads_, n_);
+#ifndef CASADI_WITH_THREAD
+    if (max_num_threads_>1) {
+      casadi_warning("CasADi was not compiled with WITH_THREAD=ON. "
+                     "Falling back to serial evaluation.");
+    }
+#endif // CASADI_WITH_THREAD
+
+    // Call the initialization method of the base class
+    FunctionInternal::init(opts);
+
+    // Work vectors of each worker, followed by the outputs of all solves
+    // when only the best one is returned
+    casadi_int sz_out = 0;
+    if (best_) {
+      for (casadi_int i=0; i<n_out_; ++i) sz_out += n_ * solver_.nnz_out(i);
+    }
+    alloc_arg(solver_.sz_arg() * max_num_threads_);
+    alloc_res(solver_.sz_res() * max_num_threads_);
+    alloc_w(solver_.sz_w() * max_num_threads_ + sz_out);
+    alloc_iw(solver_.sz_iw() * max_num_threads_);
+  }
+
+  int NlpsolBatch::init_mem(void* mem) const {
+    if (FunctionInternal::init_mem(mem)) return 1;
+    auto m = static_cast<NlpsolBatchMemory*>(mem);
+    for (casadi_int t=0; t<max_num_threads_; ++t) m->mem.push_back(solver_.checkout());
+    m->best = -1;
+    return 0;
+  }
+
+  void NlpsolBatch::free_mem(void *mem) const {
+    auto m = static_cast<NlpsolBatchMemory*>(mem);
+    for (int ind : m->mem) solver_.release(ind);
+    delete m;
+  }
+
+  int NlpsolBatch::eval(const double** arg, double** res, casadi_int* iw, double* w,
+      void* mem) const {
+    auto m = static_cast<NlpsolBatchMemory*>(mem);
+
+    // Work sizes of the solver
+    size_t sz_arg, sz_res, sz_iw, sz_w;
+    solver_.sz_work(sz_arg, sz_res, sz_iw, sz_w);
+
+    // Outputs of all solves
+    std::vector<double*> out(res, res + n_out_);
+    double* w_out = w + sz_w * max_num_threads_;
+    if (best_) {
+      for (casadi_int i=0; i<n_out_; ++i) {
+        out[i] = w_out;
+        w_out += n_ * solver_.nnz_out(i);
+      }
+    }
+
+    // Solves are distributed over the workers as they become available
+    m->stats.assign(n_, Dict());
+    m->flag.assign(n_, 0);
+    std::atomic<casadi_int> next(0);
+    auto worker = [&](casadi_int t) {
+      const double** arg1 = arg + n_in_ + t*sz_arg;
+      double** res1 = res + n_out_ + t*sz_res;
+      casadi_int k;
+      while ((k = next++) < n_) {
+        for (casadi_int i=0; i<n_in_; ++i) {
+          arg1[i] = arg[i] ? arg[i] + k*solver_.nnz_in(i) : nullptr;
+        }
+        for (casadi_int i=0; i<n_out_; ++i) {
+          res1[i] = out[i] ? out[i] + k*solver_.nnz_out(i) : nullptr;
+        }
+        try {
+          m->flag[k] = solver_(arg1, res1, iw + t*sz_iw, w + t*sz_w, m->mem[t]);
+          m->stats[k] = solver_.stats(m->mem[t]);
+        } catch (std::exception& e) {
+          m->flag[k] = 1;
+          m->stats[k] = Dict{{"success", false}, {"return_status", std::string(e.what())}};
+        }
+      }
+    };
+#ifdef CASADI_WITH_THREAD
+    std::vector<std::thread> threads;
+    for (casadi_int t=1; t<max_num_threads_; ++t) threads.emplace_back(worker, t);
+    worker(0);
+    for (auto&& th : threads) th.join();
+#else // CASADI_WITH_THREAD
+    worker(0);
+#endif // CASADI_WITH_THREAD
+
+    // Select the successful solve with the lowest objective value
+    m->best = -1;
+    if (out[NLPSOL_F]) {
+      bool success_best = false;
+      double f_best = inf;
+      for (casadi_int k=0; k<n_; ++k) {
+        auto it = m->stats[k].find("success");
+        bool success = it!=m->stats[k].end() && it->second.as_bool();
+        double f = out[NLPSOL_F][k];
+        if (m->best<0 || (success && !success_best)
+            || (success==success_best && f<f_best)) {
+          m->best = k;
+          success_best = success;
+          f_best = f;
+        }
+      }
+    }
+
+    if (best_) {
+      // Copy the selected solution
+      for (casadi_int i=0; i<n_out_; ++i) {
+        casadi_int nnz = solver_.nnz_out(i);
+        casadi_copy(out[i] + m->best*nnz, nnz, res[i]);
+      }
+      return m->flag[m->best];
+    }
+
+    // Fail if any solve failed
+    int ret = 0;
+    for (int e : m->flag) ret = ret || e;
+    return ret;
+  }
+
+  Dict NlpsolBatch::get_stats(void* mem) const {
+    Dict stats = FunctionInternal::get_stats(mem);
+    auto m = static_cast<NlpsolBatchMemory*>(mem);
+    casadi_int n_success = 0;
+    for (auto&& s : m->stats) {
+      auto it = s.find("success");
+      if (it!=s.end() && it->second.as_bool()) n_success++;
+    }
+    stats["solves"] = m->stats;
+    stats["n_success"] = n_success;
+    stats["best"] = m->best;
+    stats["success"] = m->best>=0 && m->stats.at(m->best).count("success")
+      && m->stats.at(m->best).at("success").as_bool();
+    return stats;
+  }
+
+  void NlpsolBatch::serialize_body(SerializingStream &s) const {
+    FunctionInternal::serialize_body(s);
+    s.version("NlpsolBatch", 1);
+    s.pack("NlpsolBatch::solver", solver_);
+    s.pack("NlpsolBatch::n", n_);
+    s.pack("NlpsolBatch::max_num_threads", max_num_threads_);
+    s.pack("NlpsolBatch::best", best_);
+  }
+
+  NlpsolBatch::NlpsolBatch(DeserializingStream& s) : FunctionInternal(s) {
+    s.version("NlpsolBatch", 1);
+    s.unpack("NlpsolBatch::solver", solver_);
+    s.unpack("NlpsolBatch::n", n_);
+    s.unpack("NlpsolBatch::max_num_threads", max_num_threads_);
+    s.unpack("NlpsolBatch::best", best_);
+  }
+
+} // namespace casadi
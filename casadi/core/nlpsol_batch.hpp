@@ -0,0 +1,151 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef CASADI_NLPSOL_BATCH_HPP
+#define CASADI_NLPSOL_BATCH_HPP
+
+#include "function_internal.hpp"
+
+/// \cond INTERNAL
+
+namespace casadi {
+
+  /** \brief Memory of a batch of NLP solves */
+  struct CASADI_EXPORT NlpsolBatchMemory : public FunctionMemory {
+    // Memory objects of the NLP solver, one per worker
+    std::vector<int> mem;
+    // Statistics of each solve
+    std::vector<Dict> stats;
+    // Return flag of each solve
+    std::vector<int> flag;
+    // Selected solve, -1 if none
+    casadi_int best;
+  };
+
+  /** Solve a batch of NLPs with the same structure, in parallel
+
+      The inputs and outputs of the solves are concatenated horizontally, as for Map.
+      Each worker thread owns a memory object of the solver, so that all symbolic data
+      is shared and only the numeric memory is replicated.
+  */
+  class CASADI_EXPORT NlpsolBatch : public FunctionInternal {
+  public:
+    // Constructor
+    NlpsolBatch(const std::string& name, const Function& solver, casadi_int n);
+
+    /** \brief Destructor */
+    ~NlpsolBatch() override;
+
+    /** \brief Get type name */
+    std::string class_name() const override {return "NlpsolBatch";}
+
+    ///@{
+    /** \brief Options */
+    static const Options options_;
+    const Options& get_options() const override { return options_;}
+    ///@}
+
+    // Get list of dependency functions
+    std::vector<std::string> get_function() const override { return {"solver"};}
+
+    // Get a dependency function
+    const Function& get_function(const std::string &name) const override;
+
+    // Check if a particular dependency exists
+    bool has_function(const std::string& fname) const override { return fname=="solver";}
+
+    /// @{
+    /** \brief Sparsities of function inputs and outputs */
+    Sparsity get_sparsity_in(casadi_int i) override {
+      return repmat(solver_.sparsity_in(i), 1, n_);
+    }
+    Sparsity get_sparsity_out(casadi_int i) override {
+      return best_ ? solver_.sparsity_out(i) : repmat(solver_.sparsity_out(i), 1, n_);
+    }
+    /// @}
+
+    /** \brief Get default input value */
+    double get_default_in(casadi_int ind) const override { return solver_.default_in(ind);}
+
+    ///@{
+    /** \brief Number of function inputs and outputs */
+    size_t get_n_in() override { return solver_.n_in();}
+    size_t get_n_out() override { return solver_.n_out();}
+    ///@}
+
+    ///@{
+    /** \brief Names of function input and outputs */
+    std::string get_name_in(casadi_int i) override { return solver_.name_in(i);}
+    std::string get_name_out(casadi_int i) override { return solver_.name_out(i);}
+    /// @}
+
+    /** \brief  Initialize */
+    void init(const Dict& opts) override;
+
+    /** \brief Create memory block */
+    void* alloc_mem() const override { return new NlpsolBatchMemory();}
+
+    /** \brief Initalize memory block */
+    int init_mem(void* mem) const override;
+
+    /** \brief Free memory block */
+    void free_mem(void *mem) const override;
+
+    /// Evaluate the function numerically
+    int eval(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const override;
+
+    /// Get all statistics
+    Dict get_stats(void* mem) const override;
+
+    /** Obtain information about node */
+    Dict info() const override { return {{"solver", solver_}, {"n", n_}}; }
+
+    /** \brief Serialize an object without type information */
+    void serialize_body(SerializingStream &s) const override;
+
+    /** \brief Deserialize into MX */
+    static ProtoFunction* deserialize(DeserializingStream& s) { return new NlpsolBatch(s); }
+
+  protected:
+    /** \brief Deserializing constructor */
+    explicit NlpsolBatch(DeserializingStream& s);
+
+    // The NLP solver
+    Function solver_;
+
+    // Number of solves
+    casadi_int n_;
+
+    // Number of worker threads
+    casadi_int max_num_threads_;
+
+    // Only return the solution with the lowest objective?
+    bool best_;
+  };
+
+} // namespace casadi
+/// \endcond
+
+#endif // CASADI_NLPSOL_BATCH_HPP
@@ -46,6 +46,24 @@ namespace casadi {
     bool success;
     // Return status
     UnifiedReturnStatus unified_return_status;
+    // Warm start cache: parameters, primal and dual solution of each entry
+    std::vector<double> cache_data;
+    // Warm start cache: k-d tree over the parameters of the entries, splitting on
+    // parameter component depth % np. Nodes of replaced entries have entry -1.
+    struct CacheNode {
+      casadi_int entry;
+      double split;
+      casadi_int left, right;
+    };
+    std::vector<CacheNode> cache_tree;
+    casadi_int cache_root;
+    // Warm start cache: tree node of each entry
+    std::vector<casadi_int> cache_node;
+    // Warm start cache: number of entries, slot to be filled next, entries in the file
+    casadi_int cache_n, cache_next, cache_file_n;
+    // Warm start cache statistics
+    bool cache_hit;
+    casadi_int cache_n_lookup, cache_n_hit, cache_iter_hit, cache_iter_miss;
   };
 
   /** \brief NLP solver storage class
@@ -81,6 +99,14 @@ namespace casadi {
     std::string sens_linsol_;
     Dict sens_linsol_options_;
 
+    /// Share the factorization of the KKT matrix between sensitivity evaluations
+    bool sens_reuse_factorization_;
+
+    /// Warm start cache: maximum number of entries, file, maximum parameter distance
+    casadi_int warm_start_cache_;
+    std::string warm_start_cache_file_;
+    double warm_start_cache_radius_;
+
     std::vector<char> detect_simple_bounds_is_simple_;
     Function detect_simple_bounds_parts_;
     std::vector<casadi_int> detect_simple_bounds_target_x_;
@@ -107,6 +133,9 @@ namespace casadi {
     /// Cache for KKT function
     mutable WeakRef kkt_;
 
+    /// Cache for the linear solver of the sensitivity equations
+    mutable WeakRef sens_linsol_cache_;
+
     /** \brief Serialize an object without type information
 
         \identifier{1nl} */
@@ -192,6 +221,35 @@ namespace casadi {
         \identifier{1nx} */
     virtual void check_inputs(void* mem) const;
 
+    /** \brief Warm start from the cached solution with the nearest parameter value */
+    bool cache_lookup(NlpsolMemory* m) const;
+
+    /** \brief Add a converged solution to the warm start cache */
+    void cache_store(NlpsolMemory* m, const double* p, const double* x, const double* lam) const;
+
+    /** \brief Append the last stored entry to the warm start cache file, rewriting it
+        with the entries in memory when it has grown to twice their maximum number */
+    void cache_write(NlpsolMemory* m) const;
+
+    /// Warm start cache: insert an entry into the k-d tree
+    void cache_insert(NlpsolMemory* m, casadi_int k) const;
+
+    /// Warm start cache: balanced k-d tree of entries at a given depth, returns the root
+    casadi_int cache_build(NlpsolMemory* m, casadi_int* entries, casadi_int n,
+                           casadi_int depth) const;
+
+    /// Warm start cache: number of nodes in a subtree, entries of a subtree
+    casadi_int cache_count(const NlpsolMemory* m, casadi_int node) const;
+    void cache_collect(const NlpsolMemory* m, casadi_int node,
+                       std::vector<casadi_int>& entries) const;
+
+    /// Warm start cache: nearest entry in a subtree, if closer than best_dist (squared)
+    void cache_nearest(const NlpsolMemory* m, casadi_int node, casadi_int depth,
+                       const double* p, double& best_dist, casadi_int& best) const;
+
+    /// Iteration count of the last solve, as reported by the plugin, -1 if unknown
+    virtual casadi_int get_iter_count(void* mem) const { return -1;}
+
     /** \brief Get default input value
 
         \identifier{1ny} */
@@ -259,6 +317,9 @@ namespace casadi {
     // Get KKT function
     Function kkt() const;
 
+    // Get linear solver for the sensitivity equations
+    Linsol sens_linsol(const Sparsity& sp) const;
+
     // Make sure primal-dual solution is consistent with bounds
     static void bound_consistency(casadi_int n, double* z, double* lam,
                                   const double* lbz, const double* ubz);
@@ -239,7 +239,8 @@ MX OptiNode::g_lookup(casadi_int i) const {
 }
 
 OptiNode::OptiNode(const std::string& problem_type) :
-    count_(0), count_var_(0), count_par_(0), count_dual_(0) {
+    bake_full_(true), count_(0), count_var_(0), count_par_(0), count_dual_(0),
+    n_baked_(0), nx_baked_(0), ng_baked_(0) {
   f_ = 0;
   instance_number_ = instance_count_++;
   user_callback_ = nullptr;
@@ -375,7 +376,14 @@ MX OptiNode::parameter(casadi_int n, casadi_int m, const std::string& attribute)
 
 Dict OptiNode::stats() const {
   assert_solved();
-  return solver_.stats();
+  Dict stats = solver_.stats();
+  // Add timings of the Opti stack
+  for (const auto& s : fstats_) {
+    stats["n_call_" +s.first] = s.second.n_call;
+    stats["t_wall_" +s.first] = s.second.t_wall;
+    stats["t_proc_" +s.first] = s.second.t_proc;
+  }
+  return stats;
 }
 
 std::string OptiNode::return_status() const {
@@ -577,95 +585,128 @@ void OptiNode::bake() {
     "You need to specify at least an objective (y calling 'minimize'), "
     "or a constraint (by calling 'subject_to').");
 
-  symbol_active_.clear();
-  symbol_active_.resize(symbols_.size());
+  // Try to append the constraints added since the last bake
+  std::vector<MX> g_new(g_.begin() + n_baked_, g_.end());
+  if (!bake_full_) {
+    symbol_active_.resize(symbols_.size());
+    bake_full_ = !bake_symbols(veccat(g_new), true);
+  }
 
-  // Gather all expressions
-  MX total_expr = vertcat(f_, veccat(g_));
+  if (bake_full_) {
+    symbol_active_.clear();
+    symbol_active_.resize(symbols_.size());
+    active_var_.clear();
+    active_par_.clear();
+    active_dual_.clear();
+    baked_g_.clear();
+    baked_h_.clear();
+    baked_lbg_.clear();
+    baked_ubg_.clear();
+    nx_baked_ = 0;
+    ng_baked_ = 0;
+
+    // Categorize the symbols appearing in all expressions
+    bake_symbols(vertcat(f_, veccat(g_)), false);
+    g_new = g_;
+  }
+  bake_constraints(g_new);
+  n_baked_ = g_.size();
+  bake_full_ = false;
 
-  // Categorize the symbols appearing in those expressions
-  for (const auto& d : symvar(total_expr))
-    symbol_active_[meta(d).count] = true;
+  // Fill the nlp definition
+  nlp_["x"] = veccat(active_var_);
+  nlp_["p"] = veccat(active_par_);
+  nlp_["f"] = f_;
+  nlp_["g"] = veccat(baked_g_);
+  if (problem_type_=="conic") {
+    nlp_["h"] = diagcat(baked_h_);
+  }
+  lam_ = veccat(active_dual_);
 
-  std::vector<MX> x = active_symvar(OPTI_VAR);
-  for (casadi_int i=0;i<x.size();++i) meta(x[i]).active_i = i;
+  // Create bounds helper function
+  MXDict bounds;
+  bounds["p"] = nlp_["p"];
+  bounds_lbg_ = veccat(baked_lbg_);
+  bounds_ubg_ = veccat(baked_ubg_);
 
-  casadi_int offset = 0;
-  for (const auto& v : x) {
-    meta(v).start = offset;
-    offset+= v.nnz();
-    meta(v).stop = offset;
-  }
-  std::vector<MX> p = active_symvar(OPTI_PAR);
-  for (casadi_int i=0;i<p.size();++i) meta(p[i]).active_i = i;
+  bounds["lbg"] = bounds_lbg_;
+  bounds["ubg"] = bounds_ubg_;
 
-  // Fill the nlp definition
-  nlp_["x"] = veccat(x);
-  nlp_["p"] = veccat(p);
+  bounds_ = Function("bounds", bounds, {"p"}, {"lbg", "ubg"});
+  mark_problem_dirty(false);
+}
 
-  nlp_["f"] = f_;
+bool OptiNode::bake_symbols(const MX& expr, bool append) {
+  std::vector<MX> s = symvar(expr);
+
+  // Symbols that become active must come after the active ones of the same type
+  if (append) {
+    for (const auto& d : s) {
+      if (symbol_active_[meta(d).count]) continue;
+      if (meta(d).type==OPTI_VAR && !active_var_.empty()
+          && meta(d).count<meta(active_var_.back()).count) return false;
+      if (meta(d).type==OPTI_PAR && !active_par_.empty()
+          && meta(d).count<meta(active_par_.back()).count) return false;
+    }
+  }
+
+  for (const auto& d : s) {
+    MetaVar& m = meta(d);
+    if (symbol_active_[m.count]) continue;
+    symbol_active_[m.count] = true;
+    if (m.type==OPTI_VAR) {
+      m.active_i = active_var_.size();
+      m.start = nx_baked_;
+      nx_baked_ += d.nnz();
+      m.stop = nx_baked_;
+      active_var_.push_back(d);
+    } else if (m.type==OPTI_PAR) {
+      m.active_i = active_par_.size();
+      active_par_.push_back(d);
+    }
+  }
+  return true;
+}
 
-  offset = 0;
-  for (casadi_int i=0;i<g_.size();++i) {
-    MetaCon& r = meta_con(g_[i]);
+void OptiNode::bake_constraints(const std::vector<MX>& g) {
+  for (const auto& e : g) {
+    MetaCon& r = meta_con(e);
     MetaVar& r2 = meta(r.dual_canon);
-    symbol_active_[r2.count] = true;
+    if (!symbol_active_[r2.count]) {
+      symbol_active_[r2.count] = true;
+      r2.active_i = active_dual_.size();
+      active_dual_.push_back(r.dual_canon);
+    }
 
     // Compute offsets for this constraint:
     // location into the global constraint variable
-    r.start = offset;
-    offset+= r.canon.nnz();
-    r.stop = offset;
+    r.start = ng_baked_;
+    ng_baked_ += r.canon.nnz();
+    r.stop = ng_baked_;
 
     r2.start = r.start;
     r2.stop  = r.stop;
 
-  }
-
-  std::vector<MX> lam = active_symvar(OPTI_DUAL_G);
-  for (casadi_int i=0;i<lam.size();++i) meta(lam[i]).active_i = i;
-
-  lam_ = veccat(lam);
-
-  // Collect bounds and canonical form of constraints
-  std::vector<MX> g_all;
-  std::vector<MX> h_all;
-  std::vector<MX> lbg_all;
-  std::vector<MX> ubg_all;
-  for (const auto& g : g_) {
-    if (meta_con(g).type==OPTI_PSD) {
-      h_all.push_back(meta_con(g).canon);
+    // Collect bounds and canonical form of constraints
+    if (r.type==OPTI_PSD) {
+      baked_h_.push_back(r.canon);
     } else {
-      g_all.push_back(meta_con(g).canon);
-      lbg_all.push_back(meta_con(g).lb);
-      ubg_all.push_back(meta_con(g).ub);
+      baked_g_.push_back(r.canon);
+      baked_lbg_.push_back(r.lb);
+      baked_ubg_.push_back(r.ub);
     }
   }
-
-  nlp_["g"] = veccat(g_all);
-  if (problem_type_=="conic") {
-    nlp_["h"] = diagcat(h_all);
-  }
-
-  // Create bounds helper function
-  MXDict bounds;
-  bounds["p"] = nlp_["p"];
-  bounds_lbg_ = veccat(lbg_all);
-  bounds_ubg_ = veccat(ubg_all);
-
-  bounds["lbg"] = bounds_lbg_;
-  bounds["ubg"] = bounds_ubg_;
-
-  bounds_ = Function("bounds", bounds, {"p"}, {"lbg", "ubg"});
-  mark_problem_dirty(false);
 }
 
 void OptiNode::solver(const std::string& solver_name, const Dict& plugin_options,
                        const Dict& solver_options) {
-  solver_name_ = solver_name;
-  solver_options_ = plugin_options;
+  Dict opts = plugin_options;
   if (!solver_options.empty())
-    solver_options_[solver_name] = solver_options;
+    opts[solver_name] = solver_options;
+  // Keep the solver instance when nothing changes
+  if (solver_name==solver_name_ && opts==solver_options_) return;
+  solver_name_ = solver_name;
+  solver_options_ = opts;
   mark_solver_dirty();
 }
 
@@ -884,8 +925,11 @@ void OptiNode::assert_empty() const {
 
 void OptiNode::minimize(const MX& f) {
   assert_only_opti_nondual(f);
-  mark_problem_dirty();
   casadi_assert(f.is_scalar(), "Objective must be scalar, got " + f.dim() + ".");
+  // Keep the baked problem when the same objective is passed again
+  if (f.get()==f_.get()) return;
+  mark_problem_dirty();
+  bake_full_ = true;
   f_ = f;
 }
 
@@ -910,6 +954,7 @@ void OptiNode::subject_to(const MX& g) {
 
 void OptiNode::subject_to() {
   mark_problem_dirty();
+  bake_full_ = true;
   g_.clear();
   store_initial_[OPTI_DUAL_G].clear();
   store_latest_[OPTI_DUAL_G].clear();
@@ -951,8 +996,10 @@ bool OptiNode::old_callback() const {
 }
 // Solve the problem
 OptiSol OptiNode::solve(bool accept_limit) {
+  fstats_.clear();
 
   if (problem_dirty()) {
+    ScopedTiming tic(fstats_["opti_bake"]);
     bake();
   }
   // Verify the constraint types
@@ -968,6 +1015,7 @@ OptiSol OptiNode::solve(bool accept_limit) {
   bool solver_update =  solver_dirty() || old_callback() || (user_callback_ && callback_.is_null());
 
   if (solver_update) {
+    ScopedTiming tic(fstats_["opti_construct"]);
     Dict opts = solver_options_;
 
     // Handle callbacks
@@ -988,8 +1036,11 @@ OptiSol OptiNode::solve(bool accept_limit) {
     mark_solver_dirty(false);
   }
 
-  solve_prepare();
-  res(solve_actual(arg_));
+  {
+    ScopedTiming tic(fstats_["opti_solve"]);
+    solve_prepare();
+    res(solve_actual(arg_));
+  }
 
   std::string ret = return_status();
 
@@ -1245,22 +1296,18 @@ void OptiNode::set_value(const MX& x, const DM& v) {
 }
 
 std::vector<MX> OptiNode::active_symvar(VariableType type) const {
-  if (symbol_active_.empty()) return std::vector<MX>{};
-  std::vector<MX> ret;
-  for (const auto& s : symbols_) {
-    if (symbol_active_[meta(s).count] && meta(s).type==type)
-      ret.push_back(s);
+  switch (type) {
+    case OPTI_VAR: return active_var_;
+    case OPTI_PAR: return active_par_;
+    case OPTI_DUAL_G: return active_dual_;
+    default: return std::vector<MX>{};
   }
-  return ret;
 }
 
 std::vector<DM> OptiNode::active_values(VariableType type) const {
-  if (symbol_active_.empty()) return std::vector<DM>{};
   std::vector<DM> ret;
-  for (const auto& s : symbols_) {
-    if (symbol_active_[meta(s).count] && meta(s).type==type) {
-      ret.push_back(store_initial_.at(meta(s).type)[meta(s).i]);
-    }
+  for (const auto& s : active_symvar(type)) {
+    ret.push_back(store_initial_.at(meta(s).type)[meta(s).i]);
   }
   return ret;
 }
@@ -27,6 +27,7 @@
 
 #include "optistack.hpp"
 #include "shared_object_internal.hpp"
+#include "timing.hpp"
 
 namespace casadi {
 
@@ -268,7 +269,12 @@ public:
   ///  Print representation
   void disp(std::ostream& stream, bool more=false) const override;
 
-  /// Fix the structure of the optimization problem
+  /** \brief Fix the structure of the optimization problem
+
+      Constraints added since the last bake are appended to the baked problem, as long as
+      the symbols they activate come after the active ones. Otherwise, and after changes
+      to the objective or removal of constraints, the problem is baked from scratch.
+  */
   void bake();
 
   casadi_int instance_number() const;
@@ -277,6 +283,9 @@ public:
 
   bool problem_dirty_;
   void mark_problem_dirty(bool flag=true) { problem_dirty_=flag; mark_solver_dirty(); }
+
+  /// Does the next bake need to start from scratch?
+  bool bake_full_;
   bool problem_dirty() const { return problem_dirty_; }
 
   bool solver_dirty_;
@@ -298,6 +307,12 @@ private:
   bool parse_opti_name(const std::string& name, VariableType& vt) const;
   void register_dual(MetaCon& meta);
 
+  /// Activate the symbols of an expression, false if they cannot be appended
+  bool bake_symbols(const MX& expr, bool append);
+
+  /// Append constraints to the baked problem
+  void bake_constraints(const std::vector<MX>& g);
+
   /// Set value of symbol
   void set_value_internal(const MX& x, const DM& v);
 
@@ -357,6 +372,21 @@ private:
   /// Is symbol present in problem?
   std::vector<bool> symbol_active_;
 
+  /// Active symbols, in the order of the baked problem
+  std::vector<MX> active_var_, active_par_, active_dual_;
+
+  /// Canonical constraints and their bounds in the baked problem
+  std::vector<MX> baked_g_, baked_h_, baked_lbg_, baked_ubg_;
+
+  /// Number of entries of g_ in the baked problem
+  casadi_int n_baked_;
+
+  /// Number of nonzeros of x and g in the baked problem
+  casadi_int nx_baked_, ng_baked_;
+
+  /// Timings of the last solve: baking, solver construction and solving
+  std::map<std::string, FStats> fstats_;
+
   /// Solver
   Function solver_;
 
@@ -29,6 +29,14 @@
 
 #include <iomanip>
 #include <iostream>
+#include <exception>
+#ifdef CASADI_WITH_THREAD
+#ifdef CASADI_WITH_THREAD_MINGW
+#include <mingw.thread.h>
+#else // CASADI_WITH_THREAD_MINGW
+#include <thread>
+#endif // CASADI_WITH_THREAD_MINGW
+#endif //CASADI_WITH_THREAD
 
 namespace casadi {
 
@@ -56,7 +64,11 @@ const Options OracleFunction::options_
     {"specific_options",
       {OT_DICT,
       "Options for specific auto-generated functions,"
-      " overwriting the defaults from common_options. Nested dictionary."}}
+      " overwriting the defaults from common_options. Nested dictionary."}},
+    {"max_num_threads",
+      {OT_INT,
+      "Maximum number of threads for evaluating independent oracle functions "
+      "concurrently, where supported by the solver [1]"}}
   }
 };
 
@@ -89,8 +101,11 @@ void OracleFunction::init(const Dict& opts) {
       monitor_ = op.second;
     } else if (op.first=="show_eval_warnings") {
       show_eval_warnings_ = op.second;
+    } else if (op.first=="max_num_threads") {
+      max_num_threads_ = op.second;
     }
   }
+  casadi_assert(max_num_threads_ >= 1, "Option 'max_num_threads' must be positive");
 
   // Replace MX oracle with SX oracle?
   if (expand) oracle_ = oracle_.expand();
@@ -149,6 +164,7 @@ void OracleFunction::join_results(OracleMemory* m) const {
     auto* ml = m->thread_local_mem[i];
     for (auto&& s : ml->fstats) {
       m->fstats.at(s.first).join(s.second);
+      s.second.reset();
     }
   }
 }
@@ -384,6 +400,45 @@ calc_function(OracleMemory* m, const std::string& fcn,
   return 0;
 }
 
+void OracleFunction::
+calc_functions(OracleMemory* m, std::vector<OracleCall>& calls) const {
+  // Number of threads
+  casadi_int n_calls = calls.size();
+  casadi_int n_threads = std::min(static_cast<casadi_int>(max_num_threads_), n_calls);
+  // Evaluate calls t, t + n_threads, ... with the memory of thread t
+  std::vector<std::exception_ptr> ex(n_threads);
+  auto worker = [&](casadi_int t) {
+    auto ml = m->thread_local_mem.at(t);
+    try {
+      for (casadi_int i = t; i < n_calls; i += n_threads) {
+        OracleCall& c = calls[i];
+        const Function& f = get_function(c.fcn);
+        casadi_assert_dev(static_cast<casadi_int>(c.arg.size()) <= f.n_in());
+        casadi_assert_dev(static_cast<casadi_int>(c.res.size()) <= f.n_out());
+        std::fill_n(ml->arg, f.n_in(), nullptr);
+        std::copy(c.arg.begin(), c.arg.end(), ml->arg);
+        std::fill_n(ml->res, f.n_out(), nullptr);
+        std::copy(c.res.begin(), c.res.end(), ml->res);
+        c.flag = calc_function(m, c.fcn, nullptr, t);
+      }
+    } catch (...) {
+      ex[t] = std::current_exception();
+    }
+  };
+#ifdef CASADI_WITH_THREAD
+  std::vector<std::thread> threads;
+  for (casadi_int t = 1; t < n_threads; ++t) threads.emplace_back(worker, t);
+  if (n_threads > 0) worker(0);
+  for (auto&& th : threads) th.join();
+#else // CASADI_WITH_THREAD
+  for (casadi_int t = 0; t < n_threads; ++t) worker(t);
+#endif // CASADI_WITH_THREAD
+  // Propagate errors
+  for (auto&& e : ex) {
+    if (e) std::rethrow_exception(e);
+  }
+}
+
 int OracleFunction::calc_sp_forward(const std::string& fcn, const bvec_t** arg, bvec_t** res,
     casadi_int* iw, bvec_t* w) const {
   return get_function(fcn)(arg, res, iw, w);
@@ -167,6 +167,20 @@ namespace casadi {
     int calc_function(OracleMemory* m, const std::string& fcn,
       const double* const* arg=nullptr, int thread_id=0) const;
 
+    // Oracle function call with inputs, outputs and return flag, cf. calc_function
+    struct OracleCall {
+      std::string fcn;
+      std::vector<const double*> arg;
+      std::vector<double*> res;
+      int flag;
+    };
+
+    /** \brief Calculate independent oracle functions
+
+        The calls are distributed over at most max_num_threads_ threads, each
+        using its thread-local memory. Sequential if compiled without threads. */
+    void calc_functions(OracleMemory* m, std::vector<OracleCall>& calls) const;
+
     // Forward sparsity propagation through a function
     int calc_sp_forward(const std::string& fcn, const bvec_t** arg, bvec_t** res,
       casadi_int* iw, bvec_t* w) const;
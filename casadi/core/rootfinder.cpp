@@ -150,6 +150,7 @@ namespace casadi {
     iin_ = 0;
     iout_ = 0;
     error_on_fail_ = true;
+    tearing_ = false;
   }
 
   Rootfinder::~Rootfinder() {
@@ -176,6 +177,12 @@ namespace casadi {
       {"jacobian_function",
        {OT_FUNCTION,
         "Function object for calculating the Jacobian (autogenerated by default)"}},
+      {"tearing",
+       {OT_BOOL,
+        "Solve the system block by block, following the block triangular form of the "
+        "Jacobian, with one instance of the root-finder for each diagonal block. "
+        "With an MX oracle, each block evaluates the complete oracle: expand it to SX "
+        "to avoid this. Not supported in code generation [false]"}},
      }
   };
 
@@ -200,6 +207,8 @@ namespace casadi {
         linear_solver = op.second.to_string();
       } else if (op.first=="constraints") {
         u_c_ = op.second;
+      } else if (op.first=="tearing") {
+        tearing_ = op.second;
       }
     }
 
@@ -251,6 +260,96 @@ namespace casadi {
       sz_w = std::max(sz_w, jac.sz_w());
     }
     alloc_w(sz_w + 2*static_cast<size_t>(n_));
+
+    // Block-by-block solution
+    if (tearing_) init_tearing(opts);
+  }
+
+  void Rootfinder::init_tearing(const Dict& opts) {
+    std::vector<casadi_int> rowperm, colperm, rowblock, colblock, coarse_rowblock, coarse_colblock;
+    casadi_int nb = sp_jac_.btf(rowperm, colperm, rowblock, colblock,
+      coarse_rowblock, coarse_colblock);
+    if (nb<=1) {
+      // Nothing to tear
+      if (verbose_) casadi_message("Jacobian is irreducible, tearing disabled");
+      tearing_ = false;
+      return;
+    }
+    // Blocks are solved in order of dependency: either forward or backward
+    std::vector<casadi_int> rblk(n_), cblk(n_);
+    for (casadi_int b=0; b<nb; ++b) {
+      for (casadi_int k=rowblock[b]; k<rowblock[b+1]; ++k) rblk[rowperm[k]] = b;
+      for (casadi_int k=colblock[b]; k<colblock[b+1]; ++k) cblk[colperm[k]] = b;
+    }
+    bool forward = true;
+    const casadi_int *colind = sp_jac_.colind(), *row = sp_jac_.row();
+    for (casadi_int c=0; c<n_ && forward; ++c) {
+      for (casadi_int k=colind[c]; k<colind[c+1]; ++k) {
+        if (rblk[row[k]]<cblk[c]) forward = false;
+      }
+    }
+    // Options for the block root-finders
+    Dict block_opts = opts;
+    for (const char* op : {"tearing", "implicit_input", "implicit_output",
+                           "jacobian_function", "constraints"}) {
+      block_opts.erase(op);
+    }
+    block_opts["error_on_fail"] = false;
+    // Residual of each block as a function of its unknowns and all inputs.
+    // SX oracles are evaluated once, each block only keeps its own equations
+    bool sx = oracle_.is_a("SXFunction");
+    std::vector<SX> sx_arg;
+    SX sx_res;
+    std::vector<MX> arg;
+    if (sx) {
+      sx_arg = oracle_.sx_in();
+      sx_res = oracle_(sx_arg).at(iout_);
+    } else {
+      arg = oracle_.mx_in();
+    }
+    std::vector<std::string> name_in = oracle_.name_in();
+    name_in.insert(name_in.begin(), "x_block");
+    tear_off_ = {0};
+    casadi_int max_block = 0;
+    for (casadi_int bb=0; bb<nb; ++bb) {
+      casadi_int b = forward ? bb : nb - 1 - bb;
+      std::vector<casadi_int> var(colperm.begin()+colblock[b], colperm.begin()+colblock[b+1]);
+      std::vector<casadi_int> eq(rowperm.begin()+rowblock[b], rowperm.begin()+rowblock[b+1]);
+      Function g_b;
+      if (sx) {
+        // The unknowns of the block are moved from the x input to the block input
+        std::vector<SX> arg_b = sx_arg;
+        SX xb, res_b;
+        sx_arg[iin_].get_nz(xb, false, Matrix<casadi_int>(var));
+        arg_b[iin_].set_nz(SX::sym("x_unused", var.size()), false, Matrix<casadi_int>(var));
+        arg_b.insert(arg_b.begin(), xb);
+        sx_res.get_nz(res_b, false, Matrix<casadi_int>(eq));
+        g_b = Function(oracle_.name() + "_block" + str(bb), arg_b, {res_b}, name_in, {"res"});
+      } else {
+        MX xb = MX::sym("x_block", var.size());
+        std::vector<MX> arg_b = arg;
+        arg_b[iin_].set_nz(xb, false, Matrix<casadi_int>(var));
+        MX res_b;
+        oracle_(arg_b).at(iout_).get_nz(res_b, false, Matrix<casadi_int>(eq));
+        arg_b = arg;
+        arg_b.insert(arg_b.begin(), xb);
+        g_b = Function(oracle_.name() + "_block" + str(bb), arg_b, {res_b}, name_in, {"res"});
+      }
+      Dict opts_b = block_opts;
+      if (!u_c_.empty()) opts_b["constraints"] = vector_slice(u_c_, var);
+      tear_.push_back(rootfinder(name_ + "_block" + str(bb), plugin_name(), g_b, opts_b));
+      tear_var_.insert(tear_var_.end(), var.begin(), var.end());
+      tear_off_.push_back(tear_var_.size());
+      max_block = std::max(max_block, static_cast<casadi_int>(var.size()));
+      alloc(tear_.back());
+      alloc_w(tear_.back().sz_w() + 2*static_cast<size_t>(n_));
+    }
+    // Auxiliary outputs, evaluated at the solution
+    set_function(oracle_, "tearing_aux");
+    if (verbose_) {
+      casadi_message("Tearing into " + str(nb) + " blocks, largest "
+        + str(max_block) + "x" + str(max_block));
+    }
   }
 
   int Rootfinder::init_mem(void* mem) const {
@@ -262,6 +361,7 @@ namespace casadi {
     m->success = false;
     m->unified_return_status = SOLVER_RET_UNKNOWN;
 
+    if (tearing_) m->tear_x.resize(n_);
     return 0;
   }
 
@@ -271,8 +371,11 @@ namespace casadi {
     setup(mem, arg, res, iw, w);
 
     // Solve the NLP
-    int ret = solve(mem);
+    int ret = tearing_ ? solve_tearing(mem) : solve(mem);
     auto m = static_cast<RootfinderMemory*>(mem);
+
+    // Join statistics
+    join_results(m);
     if (error_on_fail_ && !m->success)
       casadi_error("rootfinder process failed. "
                    "Set 'error_on_fail' option to false to ignore this error.");
@@ -280,6 +383,42 @@ namespace casadi {
     return ret;
   }
 
+  int Rootfinder::solve_tearing(void* mem) const {
+    auto m = static_cast<RootfinderMemory*>(mem);
+    // Current iterate, block initial guess and solution
+    double *x = get_ptr(m->tear_x), *xb0 = m->w, *xb = xb0 + n_, *w = xb + n_;
+    casadi_copy(m->iarg[iin_], n_, x);
+    // Solve the blocks in sequence
+    m->success = true;
+    for (casadi_int b=0; b<tear_.size(); ++b) {
+      const casadi_int* var = get_ptr(tear_var_) + tear_off_[b];
+      casadi_int nv = tear_off_[b+1] - tear_off_[b];
+      for (casadi_int k=0; k<nv; ++k) xb0[k] = x[var[k]];
+      m->arg[0] = xb0;
+      std::copy_n(m->iarg, n_in_, m->arg + 1);
+      m->arg[1+iin_] = x;
+      m->res[0] = xb;
+      scoped_checkout<Function> mem_b(tear_[b]);
+      if (tear_[b](m->arg, m->res, m->iw, w, mem_b)) return 1;
+      for (casadi_int k=0; k<nv; ++k) x[var[k]] = xb[k];
+      auto mb = static_cast<RootfinderMemory*>(tear_[b]->memory(mem_b));
+      if (!mb->success) {
+        if (verbose_) casadi_message("Block " + str(b) + " failed");
+        m->success = false;
+        m->unified_return_status = mb->unified_return_status;
+        break;
+      }
+    }
+    // Auxiliary outputs
+    std::copy_n(m->iarg, n_in_, m->arg);
+    m->arg[iin_] = x;
+    std::copy_n(m->ires, n_out_, m->res);
+    m->res[iout_] = nullptr;
+    if (calc_function(m, "tearing_aux")) return 1;
+    casadi_copy(x, n_, m->ires[iout_]);
+    return 0;
+  }
+
   void Rootfinder::set_work(void* mem, const double**& arg, double**& res,
                         casadi_int*& iw, double*& w) const {
     auto m = static_cast<RootfinderMemory*>(mem);
@@ -556,13 +695,17 @@ namespace casadi {
   void Rootfinder::serialize_body(SerializingStream &s) const {
     OracleFunction::serialize_body(s);
 
-    s.version("Rootfinder", 2);
+    s.version("Rootfinder", 3);
     s.pack("Rootfinder::n", n_);
     s.pack("Rootfinder::linsol", linsol_);
     s.pack("Rootfinder::sp_jac", sp_jac_);
     s.pack("Rootfinder::u_c", u_c_);
     s.pack("Rootfinder::iin", iin_);
     s.pack("Rootfinder::iout", iout_);
+    s.pack("Rootfinder::tearing", tearing_);
+    s.pack("Rootfinder::tear", tear_);
+    s.pack("Rootfinder::tear_var", tear_var_);
+    s.pack("Rootfinder::tear_off", tear_off_);
   }
 
   void Rootfinder::serialize_type(SerializingStream &s) const {
@@ -575,7 +718,7 @@ namespace casadi {
   }
 
   Rootfinder::Rootfinder(DeserializingStream & s) : OracleFunction(s) {
-    int version = s.version("Rootfinder", 1, 2);
+    int version = s.version("Rootfinder", 1, 3);
     s.unpack("Rootfinder::n", n_);
     s.unpack("Rootfinder::linsol", linsol_);
     s.unpack("Rootfinder::sp_jac", sp_jac_);
@@ -585,6 +728,15 @@ namespace casadi {
     if (version==1) {
       s.unpack("Rootfinder::error_on_fail", error_on_fail_);
     }
+    if (version>=3) {
+      s.unpack("Rootfinder::tearing", tearing_);
+      s.unpack("Rootfinder::tear", tear_);
+      s.unpack("Rootfinder::tear_var", tear_var_);
+      s.unpack("Rootfinder::tear_off", tear_off_);
+    } else {
+      tearing_ = false;
+    }
+    if (tearing_ && !has_function("tearing_aux")) set_function(oracle_, "tearing_aux");
   }
 
 } // namespace casadi
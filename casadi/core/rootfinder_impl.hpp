@@ -48,6 +48,9 @@ namespace casadi {
 
     // Return status
     UnifiedReturnStatus unified_return_status;
+
+    // Current iterate of the block-by-block solution
+    std::vector<double> tear_x;
   };
 
   /// Internal class
@@ -192,6 +195,21 @@ namespace casadi {
     /// Indices of the input and output that correspond to the actual root-finding
     casadi_int iin_, iout_;
 
+    /// Block-by-block solution following the block triangular form of the Jacobian
+    bool tearing_;
+
+    /// Root-finders for the diagonal blocks, in order of solution
+    std::vector<Function> tear_;
+
+    /// Unknowns of each block, with offsets
+    std::vector<casadi_int> tear_var_, tear_off_;
+
+    /// Set up the block root-finders
+    void init_tearing(const Dict& opts);
+
+    /// Solve block by block
+    int solve_tearing(void* mem) const;
+
     // Creator function for internal class
     typedef Rootfinder* (*Creator)(const std::string& name, const Function& oracle);
 
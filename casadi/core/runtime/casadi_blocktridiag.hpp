@@ -0,0 +1,233 @@
+// C-REPLACE "fabs" "casadi_fabs"
+
+//
+//    MIT No Attribution
+//
+//    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl, KU Leuven.
+//
+//    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//    software and associated documentation files (the "Software"), to deal in the Software
+//    without restriction, including without limitation the rights to use, copy, modify,
+//    merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+//    permit persons to whom the Software is furnished to do so.
+//
+//    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//    OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+// SYMBOL "dense_lu"
+// In-place LU factorization with partial pivoting of a dense n-by-n matrix (column major),
+// P*A = L*U with L unit lower triangular. Row k was interchanged with row ipiv[k].
+// Returns 1 if the matrix is singular
+template<typename T1>
+int casadi_dense_lu(T1* a, casadi_int n, casadi_int* ipiv) {
+  casadi_int i, j, k, p;
+  T1 amax, t;
+  for (k=0; k<n; ++k) {
+    // Pivot: largest entry in column k on or below the diagonal
+    p = k;
+    amax = fabs(a[k+k*n]);
+    for (i=k+1; i<n; ++i) {
+      if (fabs(a[i+k*n])>amax) {
+        amax = fabs(a[i+k*n]);
+        p = i;
+      }
+    }
+    ipiv[k] = p;
+    if (amax==0) return 1;
+    // Interchange rows k and p
+    if (p!=k) {
+      for (j=0; j<n; ++j) {
+        t = a[k+j*n];
+        a[k+j*n] = a[p+j*n];
+        a[p+j*n] = t;
+      }
+    }
+    // Multipliers
+    for (i=k+1; i<n; ++i) a[i+k*n] /= a[k+k*n];
+    // Update of the trailing submatrix
+    for (j=k+1; j<n; ++j) {
+      t = a[k+j*n];
+      if (t==0) continue;
+      for (i=k+1; i<n; ++i) a[i+j*n] -= a[i+k*n]*t;
+    }
+  }
+  return 0;
+}
+
+// SYMBOL "dense_lu_solve"
+// Solve A*x=b or A'*x=b for nrhs right-hand-sides, in-place, using the factors of casadi_dense_lu
+template<typename T1>
+void casadi_dense_lu_solve(const T1* lu, casadi_int n, const casadi_int* ipiv, T1* x,
+                           casadi_int nrhs, casadi_int tr) {
+  casadi_int i, k, r;
+  T1 t;
+  for (r=0; r<nrhs; ++r) {
+    if (tr) {
+      // U'*y = b
+      for (k=0; k<n; ++k) {
+        for (i=0; i<k; ++i) x[k] -= lu[i+k*n]*x[i];
+        x[k] /= lu[k+k*n];
+      }
+      // L'*z = y
+      for (k=n-1; k>=0; --k) {
+        for (i=k+1; i<n; ++i) x[k] -= lu[i+k*n]*x[i];
+      }
+      // x = P'*z
+      for (k=n-1; k>=0; --k) {
+        t = x[k]; x[k] = x[ipiv[k]]; x[ipiv[k]] = t;
+      }
+    } else {
+      // P*b
+      for (k=0; k<n; ++k) {
+        t = x[k]; x[k] = x[ipiv[k]]; x[ipiv[k]] = t;
+      }
+      // L*y = P*b
+      for (k=0; k<n; ++k) {
+        for (i=k+1; i<n; ++i) x[i] -= lu[i+k*n]*x[k];
+      }
+      // U*x = y
+      for (k=n-1; k>=0; --k) {
+        x[k] /= lu[k+k*n];
+        for (i=0; i<k; ++i) x[i] -= lu[i+k*n]*x[k];
+      }
+    }
+    x += n;
+  }
+}
+
+// SYMBOL "blocktridiag"
+// Block LU factorization of a block tridiagonal matrix with nb diagonal blocks, block k
+// spanning rows and columns blk[k], ..., blk[k+1]-1. For each block, f holds the dense
+// factors of the Schur complement S_k = D_k - L_k*G_{k-1}, followed by the subdiagonal
+// block L_k (k>0) and G_k = S_k^{-1}*U_k (k<nb-1), all column major. The nonzero k of A is
+// stored at f[amap[k]]. For symmetric matrices, this is the block Riccati recursion.
+// Returns 1 if a Schur complement is singular
+// len[f] >= sum_k n_k*(n_{k-1} + n_k + n_{k+1}), len[ipiv] >= n
+template<typename T1>
+int casadi_blocktridiag(const casadi_int* sp_a, const T1* a, const casadi_int* amap,
+                        const casadi_int* blk, casadi_int nb, T1* f, casadi_int* ipiv) {
+  casadi_int b, i, j, k, n, n_prev, n_next, nf, nnz;
+  T1 *s, *l, *g, *g_prev;
+  // Number of nonzeros in A and factors
+  nnz = sp_a[2+sp_a[1]];
+  nf = 0;
+  for (b=0; b<nb; ++b) {
+    n = blk[b+1]-blk[b];
+    nf += n*(blk[b+1] - (b>0 ? blk[b-1] : blk[b]) + (b<nb-1 ? blk[b+2]-blk[b+1] : 0));
+  }
+  // Scatter the nonzeros of A
+  for (k=0; k<nf; ++k) f[k] = 0;
+  for (k=0; k<nnz; ++k) f[amap[k]] = a[k];
+  // Forward recursion
+  g_prev = 0;
+  n_prev = 0;
+  for (b=0; b<nb; ++b) {
+    n = blk[b+1]-blk[b];
+    n_next = b<nb-1 ? blk[b+2]-blk[b+1] : 0;
+    s = f;
+    l = s + n*n;
+    g = l + n*n_prev;
+    // Schur complement S_k = D_k - L_k*G_{k-1}
+    for (j=0; j<n; ++j) {
+      for (k=0; k<n_prev; ++k) {
+        if (g_prev[k+j*n_prev]==0) continue;
+        for (i=0; i<n; ++i) s[i+j*n] -= l[i+k*n]*g_prev[k+j*n_prev];
+      }
+    }
+    // Factorize
+    if (casadi_dense_lu(s, n, ipiv + blk[b])) return 1;
+    // G_k = S_k^{-1}*U_k
+    casadi_dense_lu_solve(s, n, ipiv + blk[b], g, n_next, 0);
+    // Next block
+    g_prev = g;
+    n_prev = n;
+    f = g + n*n_next;
+  }
+  return 0;
+}
+
+// SYMBOL "blocktridiag_solve"
+// Solve A*x=b or A'*x=b in-place using the factors of casadi_blocktridiag
+template<typename T1>
+void casadi_blocktridiag_solve(T1* x, casadi_int nrhs, casadi_int tr, const casadi_int* blk,
+                               casadi_int nb, const T1* f, const casadi_int* ipiv) {
+  casadi_int b, i, j, r, n, n_prev, n_next, nf;
+  const T1 *s, *l, *g;
+  T1 *xb;
+  // Offset of the factors of the last block
+  nf = 0;
+  for (b=0; b<nb-1; ++b) {
+    n = blk[b+1]-blk[b];
+    nf += n*(blk[b+1] - (b>0 ? blk[b-1] : blk[b]) + blk[b+2]-blk[b+1]);
+  }
+  for (r=0; r<nrhs; ++r) {
+    if (tr) {
+      // Forward: z_k = b_k - G_{k-1}'*z_{k-1}
+      s = f;
+      n_prev = 0;
+      for (b=0; b<nb; ++b) {
+        n = blk[b+1]-blk[b];
+        n_next = b<nb-1 ? blk[b+2]-blk[b+1] : 0;
+        g = s + n*(n + n_prev);
+        xb = x + blk[b];
+        for (j=0; j<n_next; ++j) {
+          for (i=0; i<n; ++i) xb[n+j] -= g[i+j*n]*xb[i];
+        }
+        n_prev = n;
+        s = g + n*n_next;
+      }
+      // Backward: x_k = S_k^{-T}*(z_k - L_{k+1}'*x_{k+1})
+      s = f + nf;
+      for (b=nb-1; b>=0; --b) {
+        n = blk[b+1]-blk[b];
+        n_prev = b>0 ? blk[b]-blk[b-1] : 0;
+        n_next = b<nb-1 ? blk[b+2]-blk[b+1] : 0;
+        xb = x + blk[b];
+        if (n_next>0) {
+          // L_{k+1} is stored right after S_{k+1}
+          l = s + n*(n + n_prev + n_next) + n_next*n_next;
+          for (i=0; i<n; ++i) {
+            for (j=0; j<n_next; ++j) xb[i] -= l[j+i*n_next]*xb[n+j];
+          }
+        }
+        casadi_dense_lu_solve(s, n, ipiv + blk[b], xb, 1, 1);
+        if (b>0) s -= n_prev*(n_prev + n + (b>1 ? blk[b-1]-blk[b-2] : 0));
+      }
+    } else {
+      // Forward: y_k = S_k^{-1}*(b_k - L_k*y_{k-1})
+      s = f;
+      n_prev = 0;
+      for (b=0; b<nb; ++b) {
+        n = blk[b+1]-blk[b];
+        n_next = b<nb-1 ? blk[b+2]-blk[b+1] : 0;
+        l = s + n*n;
+        xb = x + blk[b];
+        for (j=0; j<n_prev; ++j) {
+          for (i=0; i<n; ++i) xb[i] -= l[i+j*n]*xb[j-n_prev];
+        }
+        casadi_dense_lu_solve(s, n, ipiv + blk[b], xb, 1, 0);
+        s = l + n*(n_prev + n_next);
+        n_prev = n;
+      }
+      // Backward: x_k = y_k - G_k*x_{k+1}
+      s = f + nf;
+      for (b=nb-1; b>=0; --b) {
+        n = blk[b+1]-blk[b];
+        n_prev = b>0 ? blk[b]-blk[b-1] : 0;
+        n_next = b<nb-1 ? blk[b+2]-blk[b+1] : 0;
+        g = s + n*(n + n_prev);
+        xb = x + blk[b];
+        for (j=0; j<n_next; ++j) {
+          for (i=0; i<n; ++i) xb[i] -= g[i+j*n]*xb[n+j];
+        }
+        if (b>0) s -= n_prev*(n_prev + n + (b>1 ? blk[b-1]-blk[b-2] : 0));
+      }
+    }
+    x += blk[nb];
+  }
+}
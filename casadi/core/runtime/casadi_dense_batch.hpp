@@ -0,0 +1,188 @@
+// C-REPLACE "fabs" "casadi_fabs"
+
+//
+//    MIT No Attribution
+//
+//    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl, KU Leuven.
+//
+//    Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//    software and associated documentation files (the "Software"), to deal in the Software
+//    without restriction, including without limitation the rights to use, copy, modify,
+//    merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+//    permit persons to whom the Software is furnished to do so.
+//
+//    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//    INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//    PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+//    OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+// Batched factorizations of nb small dense n-by-n matrices in an interleaved layout:
+// entry (i,j) of matrix k is stored at a[(i+j*n)*nb+k] and entry i of a vector at x[i*nb+k],
+// so that the innermost loops run over the matrices and vectorize
+
+// SYMBOL "lu_batch"
+// In-place LU factorizations with partial pivoting, P*A = L*U with L unit lower triangular.
+// Row i of matrix k was interchanged with row ipiv[i*nb+k].
+// Returns 1 if any of the matrices is singular
+// len[ipiv] >= n*nb
+template<typename T1>
+int casadi_lu_batch(T1* a, casadi_int n, casadi_int nb, casadi_int* ipiv) {
+  casadi_int i, j, k, p, b, flag;
+  T1 amax, t, *ak, *aj;
+  flag = 0;
+  for (k=0; k<n; ++k) {
+    // Pivoting, separately for each matrix
+    for (b=0; b<nb; ++b) {
+      p = k;
+      amax = fabs(a[(k+k*n)*nb+b]);
+      for (i=k+1; i<n; ++i) {
+        if (fabs(a[(i+k*n)*nb+b])>amax) {
+          amax = fabs(a[(i+k*n)*nb+b]);
+          p = i;
+        }
+      }
+      ipiv[k*nb+b] = p;
+      if (amax==0) {
+        // Singular: continue with a unit pivot to keep the other matrices valid
+        flag = 1;
+        a[(k+k*n)*nb+b] = 1;
+      }
+      if (p!=k) {
+        for (j=0; j<n; ++j) {
+          t = a[(k+j*n)*nb+b];
+          a[(k+j*n)*nb+b] = a[(p+j*n)*nb+b];
+          a[(p+j*n)*nb+b] = t;
+        }
+      }
+    }
+    // Multipliers
+    ak = a + k*n*nb;
+    for (i=k+1; i<n; ++i) {
+      for (b=0; b<nb; ++b) ak[i*nb+b] /= ak[k*nb+b];
+    }
+    // Update of the trailing submatrices
+    for (j=k+1; j<n; ++j) {
+      aj = a + j*n*nb;
+      for (i=k+1; i<n; ++i) {
+        for (b=0; b<nb; ++b) aj[i*nb+b] -= ak[i*nb+b]*aj[k*nb+b];
+      }
+    }
+  }
+  return flag;
+}
+
+// SYMBOL "lu_batch_solve"
+// Solve A*x=b or A'*x=b in-place using the factors of casadi_lu_batch
+template<typename T1>
+void casadi_lu_batch_solve(const T1* a, casadi_int n, casadi_int nb, const casadi_int* ipiv,
+                           T1* x, casadi_int tr) {
+  casadi_int i, k, p, b;
+  T1 t;
+  const T1* ak;
+  if (tr) {
+    // U'*y = b
+    for (k=0; k<n; ++k) {
+      ak = a + k*n*nb;
+      for (i=0; i<k; ++i) {
+        for (b=0; b<nb; ++b) x[k*nb+b] -= ak[i*nb+b]*x[i*nb+b];
+      }
+      for (b=0; b<nb; ++b) x[k*nb+b] /= ak[k*nb+b];
+    }
+    // L'*z = y
+    for (k=n-1; k>=0; --k) {
+      ak = a + k*n*nb;
+      for (i=k+1; i<n; ++i) {
+        for (b=0; b<nb; ++b) x[k*nb+b] -= ak[i*nb+b]*x[i*nb+b];
+      }
+    }
+    // x = P'*z
+    for (k=n-1; k>=0; --k) {
+      for (b=0; b<nb; ++b) {
+        p = ipiv[k*nb+b];
+        t = x[k*nb+b]; x[k*nb+b] = x[p*nb+b]; x[p*nb+b] = t;
+      }
+    }
+  } else {
+    // P*b
+    for (k=0; k<n; ++k) {
+      for (b=0; b<nb; ++b) {
+        p = ipiv[k*nb+b];
+        t = x[k*nb+b]; x[k*nb+b] = x[p*nb+b]; x[p*nb+b] = t;
+      }
+    }
+    // L*y = P*b
+    for (k=0; k<n; ++k) {
+      ak = a + k*n*nb;
+      for (i=k+1; i<n; ++i) {
+        for (b=0; b<nb; ++b) x[i*nb+b] -= ak[i*nb+b]*x[k*nb+b];
+      }
+    }
+    // U*x = y
+    for (k=n-1; k>=0; --k) {
+      ak = a + k*n*nb;
+      for (b=0; b<nb; ++b) x[k*nb+b] /= ak[k*nb+b];
+      for (i=0; i<k; ++i) {
+        for (b=0; b<nb; ++b) x[i*nb+b] -= ak[i*nb+b]*x[k*nb+b];
+      }
+    }
+  }
+}
+
+// SYMBOL "chol_batch"
+// In-place Cholesky factorizations A = L*L' of symmetric positive definite matrices.
+// Only the lower triangular part of A is referenced and overwritten by L.
+// Returns 1 if any of the matrices is not positive definite
+template<typename T1>
+int casadi_chol_batch(T1* a, casadi_int n, casadi_int nb) {
+  casadi_int i, j, k, b, flag;
+  T1 *ak, *aj;
+  flag = 0;
+  for (k=0; k<n; ++k) {
+    ak = a + k*n*nb;
+    for (b=0; b<nb; ++b) {
+      if (ak[k*nb+b]<=0) {
+        // Not positive definite: continue with a unit pivot
+        flag = 1;
+        ak[k*nb+b] = 1;
+      }
+      ak[k*nb+b] = sqrt(ak[k*nb+b]);
+    }
+    for (i=k+1; i<n; ++i) {
+      for (b=0; b<nb; ++b) ak[i*nb+b] /= ak[k*nb+b];
+    }
+    for (j=k+1; j<n; ++j) {
+      aj = a + j*n*nb;
+      for (i=j; i<n; ++i) {
+        for (b=0; b<nb; ++b) aj[i*nb+b] -= ak[i*nb+b]*ak[j*nb+b];
+      }
+    }
+  }
+  return flag;
+}
+
+// SYMBOL "chol_batch_solve"
+// Solve A*x=b in-place using the factors of casadi_chol_batch
+template<typename T1>
+void casadi_chol_batch_solve(const T1* a, casadi_int n, casadi_int nb, T1* x) {
+  casadi_int i, k, b;
+  const T1* ak;
+  // L*y = b
+  for (k=0; k<n; ++k) {
+    ak = a + k*n*nb;
+    for (b=0; b<nb; ++b) x[k*nb+b] /= ak[k*nb+b];
+    for (i=k+1; i<n; ++i) {
+      for (b=0; b<nb; ++b) x[i*nb+b] -= ak[i*nb+b]*x[k*nb+b];
+    }
+  }
+  // L'*x = y
+  for (k=n-1; k>=0; --k) {
+    ak = a + k*n*nb;
+    for (i=k+1; i<n; ++i) {
+      for (b=0; b<nb; ++b) x[k*nb+b] -= ak[i*nb+b]*x[i*nb+b];
+    }
+    for (b=0; b<nb; ++b) x[k*nb+b] /= ak[k*nb+b];
+  }
+}
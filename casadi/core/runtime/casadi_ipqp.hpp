@@ -36,6 +36,11 @@ struct casadi_ipqp_prob {
   casadi_int max_iter;
   // Error tolerance
   T1 pr_tol, du_tol, co_tol, mu_tol;
+  // Maximum number of centrality correctors per iteration
+  casadi_int max_mcc;
+  // Warm start from the initial guess, complementarity of the initial point
+  int warm_start;
+  T1 warm_start_mu;
 };
 // C-REPLACE "casadi_ipqp_prob<T1>" "struct casadi_ipqp_prob"
 
@@ -52,6 +57,9 @@ void casadi_ipqp_setup(casadi_ipqp_prob<T1>* p, casadi_int nx, casadi_int na) {
   p->du_tol = 1e-8;
   p->co_tol = 1e-8;
   p->mu_tol = 1e-8;
+  p->max_mcc = 0;
+  p->warm_start = 0;
+  p->warm_start_mu = 1e-4;
 }
 
 // SYMBOL "ipqp_flag_t"
@@ -79,7 +87,8 @@ typedef enum {
   IPQP_NEWITER,
   IPQP_PREPARE,
   IPQP_PREDICTOR,
-  IPQP_CORRECTOR} casadi_ipqp_next_t;
+  IPQP_CORRECTOR,
+  IPQP_MCC} casadi_ipqp_next_t;
 
 // SYMBOL "ipqp_blocker_t"
 typedef enum {
@@ -118,12 +127,19 @@ struct casadi_ipqp_data {
   casadi_int ipr, idu, ico;
   // Iteration
   casadi_int iter;
+  // Centering parameter
+  T1 sigma;
+  // Centrality correctors: number in the current iteration, in total, step before correction
+  casadi_int n_mcc, n_mcc_tot;
+  T1 alpha_mcc;
   // Bounds
   T1 *lbz, *ubz;
   // Current solution
   T1 *z, *lam, *lam_lbz, *lam_ubz;
   // Step
   T1 *dz, *dlam, *dlam_lbz, *dlam_ubz;
+  // Step before the latest centrality correction
+  T1 *dz0, *dlam0, *dlam_lbz0, *dlam_ubz0;
   // Residual
   T1 *rz, *rlam, *rlam_lbz, *rlam_ubz;
   // Diagonal entries
@@ -151,6 +167,12 @@ casadi_int casadi_ipqp_sz_w(const casadi_ipqp_prob<T1>* p) {
   sz_w += p->nz; // dlam
   sz_w += p->nz; // dlam_lbz
   sz_w += p->nz; // dlam_ubz
+  if (p->max_mcc > 0) {
+    sz_w += p->nz; // dz0
+    sz_w += p->nz; // dlam0
+    sz_w += p->nz; // dlam_lbz0
+    sz_w += p->nz; // dlam_ubz0
+  }
   sz_w += p->nz; // rz
   sz_w += p->nz; // rlam
   sz_w += p->nz; // rlam_lbz
@@ -177,6 +199,12 @@ void casadi_ipqp_init(casadi_ipqp_data<T1>* d, casadi_int** iw, T1** w) {
   d->dlam = *w; *w += p->nz;
   d->dlam_lbz = *w; *w += p->nz;
   d->dlam_ubz = *w; *w += p->nz;
+  if (p->max_mcc > 0) {
+    d->dz0 = *w; *w += p->nz;
+    d->dlam0 = *w; *w += p->nz;
+    d->dlam_lbz0 = *w; *w += p->nz;
+    d->dlam_ubz0 = *w; *w += p->nz;
+  }
   d->rz = *w; *w += p->nz;
   d->rlam = *w; *w += p->nz;
   d->rlam_lbz = *w; *w += p->nz;
@@ -224,14 +252,20 @@ template<typename T1>
 void casadi_ipqp_reset(casadi_ipqp_data<T1>* d) {
   // Local variables
   casadi_int k;
-  T1 margin, mid;
+  T1 margin, mid, mu0;
   const casadi_ipqp_prob<T1>* p = d->prob;
   // Required margin to constraints
-  margin = .1;
+  if (p->warm_start) {
+    // Stay close to the initial guess, but keep the complementarity products above mu0
+    mu0 = p->warm_start_mu;
+    margin = std::sqrt(mu0);
+  } else {
+    margin = .1;
+    // Initialize constraints to zero
+    for (k = p->nx; k < p->nz; ++k) d->z[k] = 0;
+  }
   // Reset constraint count
   d->n_con = 0;
-  // Initialize constraints to zero
-  for (k = p->nx; k < p->nz; ++k) d->z[k] = 0;
   // Find interior point
   for (k = 0; k < p->nz; ++k) {
     if (d->lbz[k] > -p->inf) {
@@ -245,21 +279,34 @@ void casadi_ipqp_reset(casadi_ipqp_data<T1>* d) {
           d->z[k] = fmax(fmin(d->z[k], d->ubz[k] - margin), mid);
         }
         if (d->ubz[k] > d->lbz[k] + p->dmin) {
-          d->lam_lbz[k] = 1;
-          d->lam_ubz[k] = 1;
+          if (p->warm_start) {
+            d->lam_lbz[k] = fmax(fmax(-d->lam[k], 0.), mu0 / (d->z[k] - d->lbz[k]));
+            d->lam_ubz[k] = fmax(fmax(d->lam[k], 0.), mu0 / (d->ubz[k] - d->z[k]));
+          } else {
+            d->lam_lbz[k] = 1;
+            d->lam_ubz[k] = 1;
+          }
           d->n_con += 2;
         }
       } else {
         // Only lower bound
         d->z[k] = fmax(d->z[k], d->lbz[k] + margin);
-        d->lam_lbz[k] = 1;
+        if (p->warm_start) {
+          d->lam_lbz[k] = fmax(fmax(-d->lam[k], 0.), mu0 / (d->z[k] - d->lbz[k]));
+        } else {
+          d->lam_lbz[k] = 1;
+        }
         d->n_con++;
       }
     } else {
       if (d->ubz[k] < p->inf) {
         // Only upper bound
         d->z[k] = fmin(d->z[k], d->ubz[k] - margin);
-        d->lam_ubz[k] = 1;
+        if (p->warm_start) {
+          d->lam_ubz[k] = fmax(fmax(d->lam[k], 0.), mu0 / (d->ubz[k] - d->z[k]));
+        } else {
+          d->lam_ubz[k] = 1;
+        }
         d->n_con++;
       }
     }
@@ -268,7 +315,9 @@ void casadi_ipqp_reset(casadi_ipqp_data<T1>* d) {
   casadi_clear(d->rz, p->nz);
   // Reset iteration counter
   d->iter = 0;
+  d->n_mcc_tot = 0;
   // Reset iteration variables
+  d->status = IPQP_SUCCESS;
   d->msg = 0;
   d->tau = -1;
 }
@@ -334,6 +383,7 @@ int casadi_ipqp_newiter(casadi_ipqp_data<T1>* d) {
   }
   // Start new iteration
   d->iter++;
+  d->n_mcc = 0;
   // Calculate diagonal entries and scaling factors
   casadi_ipqp_diag(d);
   // Success
@@ -566,7 +616,7 @@ void casadi_ipqp_predictor(casadi_ipqp_data<T1>* d) {
   // Maximum primal and dual step
   (void)casadi_ipqp_maxstep(d, &alpha, 0);
   // Calculate sigma
-  sigma = casadi_ipqp_sigma(d, alpha);
+  d->sigma = sigma = casadi_ipqp_sigma(d, alpha);
   // Prepare corrector step
   casadi_ipqp_corrector_prepare(d, -sigma * d->mu);
   // Solve to get step
@@ -639,6 +689,16 @@ void casadi_ipqp_corrector_prepare(casadi_ipqp_data<T1>* d, T1 shift) {
   // Modified residual in lam_lbz, lam_ubz
   for (k=0; k<p->nz; ++k) d->rlam_lbz[k] = d->dlam_lbz[k] * d->dz[k] + shift;
   for (k=0; k<p->nz; ++k) d->rlam_ubz[k] = -d->dlam_ubz[k] * d->dz[k] + shift;
+  // Right-hand-side of the linear system
+  casadi_ipqp_corrector_rhs(d);
+}
+
+// SYMBOL "ipqp_corrector_rhs"
+template<typename T1>
+void casadi_ipqp_corrector_rhs(casadi_ipqp_data<T1>* d) {
+  // Local variables
+  casadi_int k;
+  const casadi_ipqp_prob<T1>* p = d->prob;
   // Difference in tilde(r)_x, tilde(r)_lamg
   for (k=0; k<p->nz; ++k)
     d->rz[k] = d->dinv_lbz[k] * d->rlam_lbz[k]
@@ -661,9 +721,8 @@ void casadi_ipqp_corrector_prepare(casadi_ipqp_data<T1>* d, T1 shift) {
 template<typename T1>
 void casadi_ipqp_corrector(casadi_ipqp_data<T1>* d) {
   // Local variables
-  T1 t, mu_test, primal_slack, primal_step, dual_slack, dual_step, max_tau;
+  T1 t;
   casadi_int k;
-  int flag;
   const casadi_ipqp_prob<T1>* p = d->prob;
   // Scale results
   for (k=0; k<p->nz; ++k) d->rz[k] *= d->S[k];
@@ -693,6 +752,89 @@ void casadi_ipqp_corrector(casadi_ipqp_data<T1>* d) {
     d->dlam_ubz[k] += t;
     if (k<p->nx) d->dlam[k] += t;
   }
+}
+
+// SYMBOL "ipqp_mcc_target"
+template<typename T1>
+T1 casadi_ipqp_mcc_target(T1 v, T1 mu) {
+  // Move complementarity products outside [0.1*mu, 10*mu] back into the interval
+  if (v < 0.1 * mu) return 0.1 * mu - v;
+  if (v > 10 * mu) return fmax(10 * mu - v, -10 * mu);
+  return 0;
+}
+
+// SYMBOL "ipqp_mcc_prepare"
+template<typename T1>
+int casadi_ipqp_mcc_prepare(casadi_ipqp_data<T1>* d) {
+  // Local variables
+  casadi_int k;
+  T1 alpha, mu;
+  const casadi_ipqp_prob<T1>* p = d->prob;
+  // Maximum number of correctors reached?
+  if (d->n_mcc >= p->max_mcc || d->n_con == 0) return 0;
+  // No correction needed if full step possible
+  (void)casadi_ipqp_maxstep(d, &alpha, 0);
+  if (alpha >= 1.) return 0;
+  d->alpha_mcc = alpha;
+  // Save current step
+  casadi_copy(d->dz, p->nz, d->dz0);
+  casadi_copy(d->dlam, p->nz, d->dlam0);
+  casadi_copy(d->dlam_lbz, p->nz, d->dlam_lbz0);
+  casadi_copy(d->dlam_ubz, p->nz, d->dlam_ubz0);
+  // Enlarged trial step and target complementarity
+  alpha = fmin(alpha + 0.1, 1.);
+  mu = d->sigma * d->mu;
+  // Correct complementarity products at the trial point that are far from the target
+  for (k=0; k<p->nz; ++k) {
+    d->rlam_lbz[k] = d->rlam_ubz[k] = 0;
+    if (d->ubz[k] <= d->lbz[k] + p->dmin) continue;
+    if (d->lbz[k] > -p->inf) {
+      d->rlam_lbz[k] = -casadi_ipqp_mcc_target((d->z[k] - d->lbz[k] + alpha * d->dz[k])
+        * (d->lam_lbz[k] + alpha * d->dlam_lbz[k]), mu);
+    }
+    if (d->ubz[k] < p->inf) {
+      d->rlam_ubz[k] = -casadi_ipqp_mcc_target((d->ubz[k] - d->z[k] - alpha * d->dz[k])
+        * (d->lam_ubz[k] + alpha * d->dlam_ubz[k]), mu);
+    }
+  }
+  // Right-hand-side of the linear system
+  casadi_ipqp_corrector_rhs(d);
+  // Solve to get correction
+  d->linsys = d->rz;
+  return 1;
+}
+
+// SYMBOL "ipqp_mcc"
+template<typename T1>
+int casadi_ipqp_mcc(casadi_ipqp_data<T1>* d) {
+  // Local variables
+  T1 alpha;
+  const casadi_ipqp_prob<T1>* p = d->prob;
+  // Add centrality correction to step
+  casadi_ipqp_corrector(d);
+  // Keep correction if it increases the step size sufficiently
+  (void)casadi_ipqp_maxstep(d, &alpha, 0);
+  if (alpha >= d->alpha_mcc + 0.01) {
+    d->n_mcc++;
+    d->n_mcc_tot++;
+    return 1;
+  }
+  // Revert correction
+  casadi_copy(d->dz0, p->nz, d->dz);
+  casadi_copy(d->dlam0, p->nz, d->dlam);
+  casadi_copy(d->dlam_lbz0, p->nz, d->dlam_lbz);
+  casadi_copy(d->dlam_ubz0, p->nz, d->dlam_ubz);
+  return 0;
+}
+
+// SYMBOL "ipqp_take_step"
+template<typename T1>
+void casadi_ipqp_take_step(casadi_ipqp_data<T1>* d) {
+  // Local variables
+  T1 mu_test, primal_slack, primal_step, dual_slack, dual_step, max_tau;
+  casadi_int k;
+  int flag;
+  const casadi_ipqp_prob<T1>* p = d->prob;
   // Find the largest step size, keeping track of blocking constraints
   flag = casadi_ipqp_maxstep(d, &max_tau, &k);
   // Handle blocking constraints using Mehrotra's heuristic
@@ -768,9 +910,28 @@ int casadi_ipqp(casadi_ipqp_data<T1>* d) {
       d->next = IPQP_CORRECTOR;
       return 1;
     case IPQP_CORRECTOR:
-      // Complete predictor step
+      // Complete corrector step
       if (d->status == IPQP_SOLVE_ERROR) break;
       casadi_ipqp_corrector(d);
+      // Centrality correction
+      if (casadi_ipqp_mcc_prepare(d)) {
+        d->task = IPQP_SOLVE;
+        d->next = IPQP_MCC;
+        return 1;
+      }
+      casadi_ipqp_take_step(d);
+      d->task = IPQP_MV;
+      d->next = IPQP_RESIDUAL;
+      return 1;
+    case IPQP_MCC:
+      // Complete centrality correction, try another one if successful
+      if (d->status == IPQP_SOLVE_ERROR) break;
+      if (casadi_ipqp_mcc(d) && casadi_ipqp_mcc_prepare(d)) {
+        d->task = IPQP_SOLVE;
+        d->next = IPQP_MCC;
+        return 1;
+      }
+      casadi_ipqp_take_step(d);
       d->task = IPQP_MV;
       d->next = IPQP_RESIDUAL;
       return 1;
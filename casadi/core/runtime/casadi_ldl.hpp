@@ -17,15 +17,14 @@
 //    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //
 
-// SYMBOL "ldl"
-// Calculate the nonzeros of the transposed L factor (strictly lower entries only)
-// as well as D for an LDL^T factorization
+// SYMBOL "ldl_copy"
+// Sparse copy of the permuted A to L^T and D, first step of casadi_ldl
 // len[w] >= n
 template<typename T1>
-void casadi_ldl(const casadi_int* sp_a, const T1* a,
-                const casadi_int* sp_lt, T1* lt, T1* d, const casadi_int* p, T1* w) {
+void casadi_ldl_copy(const casadi_int* sp_a, const T1* a,
+                     const casadi_int* sp_lt, T1* lt, T1* d, const casadi_int* p, T1* w) {
   const casadi_int *lt_colind, *lt_row, *a_colind, *a_row;
-  casadi_int n, r, c, c1, k, k2;
+  casadi_int n, r, c, c1, k;
   // Extract sparsities
   n=sp_lt[1];
   lt_colind=sp_lt+2; lt_row=sp_lt+2+n+1;
@@ -40,8 +39,25 @@ void casadi_ldl(const casadi_int* sp_a, const T1* a,
     d[c] = w[p[c]];
     for (k=a_colind[c1]; k<a_colind[c1+1]; ++k) w[a_row[k]] = 0;
   }
+}
+
+// SYMBOL "ldl_cols"
+// Numeric factorization of the columns cols[0], ..., cols[ncols-1] of L^T, second step
+// of casadi_ldl. The columns must be in increasing order and include all their descendants
+// in the elimination tree that have not been factorized before. cols==0 means 0, ..., ncols-1.
+// w must be zero on entry and is zero on exit
+// len[w] >= n
+template<typename T1>
+void casadi_ldl_cols(const casadi_int* sp_lt, T1* lt, T1* d, const casadi_int* cols,
+                     casadi_int ncols, T1* w) {
+  const casadi_int *lt_colind, *lt_row;
+  casadi_int n, r, c, i, k, k2;
+  // Extract sparsity
+  n=sp_lt[1];
+  lt_colind=sp_lt+2; lt_row=sp_lt+2+n+1;
   // Loop over columns of L
-  for (c=0; c<n; ++c) {
+  for (i=0; i<ncols; ++i) {
+    c = cols ? cols[i] : i;
     for (k=lt_colind[c]; k<lt_colind[c+1]; ++k) {
       r = lt_row[k];
       // Calculate l(r,c) with r<c
@@ -58,6 +74,154 @@ void casadi_ldl(const casadi_int* sp_a, const T1* a,
   }
 }
 
+// SYMBOL "ldl"
+// Calculate the nonzeros of the transposed L factor (strictly lower entries only)
+// as well as D for an LDL^T factorization
+// len[w] >= n
+template<typename T1>
+void casadi_ldl(const casadi_int* sp_a, const T1* a,
+                const casadi_int* sp_lt, T1* lt, T1* d, const casadi_int* p, T1* w) {
+  casadi_ldl_copy(sp_a, a, sp_lt, lt, d, p, w);
+  casadi_ldl_cols(sp_lt, lt, d, 0, sp_lt[1], w);
+}
+
+// SYMBOL "ldl_super"
+// Supernodal variant of casadi_ldl, with identical outputs
+// sn: supernode partition [ns, super[ns+1], rowptr[ns+1], poff[ns+1], row[rowptr[ns]], snof[n]]
+//     with the first columns of the supernodes, the start of their row lists (own columns first),
+//     the offsets of their dense column-major panels, the row lists and the supernode of each column
+// lmap: for every strictly lower panel entry, the corresponding nonzero in lt
+// len[iw] >= 2*n + 3*ns, len[w] >= poff[ns] + max(m-k)^2, m rows and k columns of a supernode
+template<typename T1>
+void casadi_ldl_super(const casadi_int* sp_a, const T1* a, const casadi_int* sn,
+                      const casadi_int* lmap, T1* lt, T1* d, const casadi_int* p,
+                      casadi_int* iw, T1* w) {
+  const casadi_int *a_colind, *a_row, *super, *rowptr, *poff, *row, *snof, *rt;
+  casadi_int n, ns, s, t, u, q, f, k, m, i, j, jj, c, r, el, kd, md, m1, m2;
+  casadi_int *pinv, *map, *head, *next, *pos;
+  T1 *buf, *ps, *pd, *pc, *b0, *b1, *b2, *b3, v, v0, v1, v2, v3;
+  // Extract sparsity, supernodes
+  n=sp_a[1];
+  a_colind=sp_a+2; a_row=sp_a+2+n+1;
+  ns=sn[0];
+  super=sn+1; rowptr=super+ns+1; poff=rowptr+ns+1; row=poff+ns+1; snof=row+rowptr[ns];
+  // Work vectors
+  pinv=iw; iw+=n;
+  map=iw; iw+=n;
+  head=iw; iw+=ns;
+  next=iw; iw+=ns;
+  pos=iw;
+  buf=w+poff[ns];
+  // Inverse permutation, empty lists of pending updates
+  for (c=0; c<n; ++c) pinv[p[c]] = c;
+  for (s=0; s<ns; ++s) head[s] = -1;
+  // Loop over supernodes
+  for (s=0; s<ns; ++s) {
+    f = super[s];
+    k = super[s+1]-f;
+    m = rowptr[s+1]-rowptr[s];
+    ps = w+poff[s];
+    // Position of each row in the panel
+    for (i=0; i<m; ++i) map[row[rowptr[s]+i]] = i;
+    // Sparse copy of the lower triangular part of (permuted) A
+    for (i=0; i<m*k; ++i) ps[i] = 0;
+    for (j=0; j<k; ++j) {
+      c = p[f+j];
+      for (el=a_colind[c]; el<a_colind[c+1]; ++el) {
+        r = pinv[a_row[el]];
+        if (r>=f+j) ps[map[r]+j*m] = a[el];
+      }
+    }
+    // Dense block updates from all descendants with a row in the columns of s
+    t = head[s];
+    while (t>=0) {
+      q = next[t];
+      kd = super[t+1]-super[t];
+      md = rowptr[t+1]-rowptr[t];
+      pd = w+poff[t];
+      rt = row+rowptr[t];
+      // Rows pos[t]..pos[t]+m1-1 of t fall in the columns of s, all remaining rows are updated
+      i = pos[t];
+      for (m1=0; i+m1<md && rt[i+m1]<f+k; ++m1) {}
+      m2 = md-i;
+      // buf = L_t(i:md, :) * D_t * L_t(i:i+m1, :)', lower trapezoidal part only.
+      // Blocks of four columns share each load of L_t
+      for (j=0; j+4<=m1; j+=4) {
+        b0 = buf+j*m2; b1 = b0+m2; b2 = b1+m2; b3 = b2+m2;
+        for (r=j; r<m2; ++r) b0[r] = b1[r] = b2[r] = b3[r] = 0;
+        for (c=0; c<kd; ++c) {
+          pc = pd+i+c*md;
+          v = d[super[t]+c];
+          v0 = pc[j]*v; v1 = pc[j+1]*v; v2 = pc[j+2]*v; v3 = pc[j+3]*v;
+          for (r=j; r<m2; ++r) {
+            v = pc[r];
+            b0[r] += v*v0; b1[r] += v*v1; b2[r] += v*v2; b3[r] += v*v3;
+          }
+        }
+      }
+      for (; j<m1; ++j) {
+        for (r=j; r<m2; ++r) buf[r+j*m2] = 0;
+        for (c=0; c<kd; ++c) {
+          v = pd[i+j+c*md] * d[super[t]+c];
+          for (r=j; r<m2; ++r) buf[r+j*m2] += pd[i+r+c*md] * v;
+        }
+      }
+      // Scatter to the panel of s
+      for (j=0; j<m1; ++j) {
+        c = rt[i+j]-f;
+        for (r=j; r<m2; ++r) ps[map[rt[i+r]]+c*m] -= buf[r+j*m2];
+      }
+      // Move t to the list of the supernode containing its next row
+      pos[t] = i+m1;
+      if (pos[t]<md) {
+        u = snof[rt[pos[t]]];
+        next[t] = head[u];
+        head[u] = t;
+      }
+      t = q;
+    }
+    // Dense LDL^T factorization of the panel, in blocks of four columns
+    for (j=0; j<k; j+=4) {
+      // Updates from the columns left of the block, sharing each load of the panel
+      if (j+4<=k) {
+        b0 = ps+j*m; b1 = b0+m; b2 = b1+m; b3 = b2+m;
+        for (c=0; c<j; ++c) {
+          pc = ps+c*m;
+          v = d[f+c];
+          v0 = pc[j]*v; v1 = pc[j+1]*v; v2 = pc[j+2]*v; v3 = pc[j+3]*v;
+          for (r=j; r<m; ++r) {
+            v = pc[r];
+            b0[r] -= v*v0; b1[r] -= v*v1; b2[r] -= v*v2; b3[r] -= v*v3;
+          }
+        }
+        c = j;
+      } else {
+        c = 0;
+      }
+      // Remaining updates and factorization, column by column
+      for (jj=j; jj<j+4 && jj<k; ++jj) {
+        for (i=c; i<jj; ++i) {
+          v = ps[jj+i*m] * d[f+i];
+          for (r=jj; r<m; ++r) ps[r+jj*m] -= ps[r+i*m] * v;
+        }
+        d[f+jj] = ps[jj+jj*m];
+        for (r=jj+1; r<m; ++r) ps[r+jj*m] /= d[f+jj];
+      }
+    }
+    // Schedule the update of the first ancestor
+    pos[s] = k;
+    if (k<m) {
+      u = snof[row[rowptr[s]+k]];
+      next[s] = head[u];
+      head[u] = s;
+    }
+    // Copy strictly lower entries to L^T
+    for (j=0; j<k; ++j) {
+      for (r=j+1; r<m; ++r) lt[*lmap++] = ps[r+j*m];
+    }
+  }
+}
+
 // SYMBOL "ldl_trs"
 // Solve for (I+R) with R an optionally transposed strictly upper triangular matrix.
 template<typename T1>
@@ -40,33 +40,28 @@ T1 casadi_house(T1* v, T1* beta, casadi_int nv) {
   return s;
 }
 
-// SYMBOL "qr"
-// Numeric QR factorization
-// Ref: Chapter 5, Direct Methods for Sparse Linear Systems by Tim Davis
-// len[x] = nrow
-// sp_v = [nrow, ncol, 0, 0, ...] len[3 + ncol + nnz_v]
-// len[v] nnz_v
-// sp_r = [nrow, ncol, 0, 0, ...] len[3 + ncol + nnz_r]
-// len[r] nnz_r
-// len[beta] ncol
+// SYMBOL "qr_cols"
+// Numeric QR factorization of the columns cols[0], ..., cols[ncols-1], cf. casadi_qr.
+// The columns must be in increasing order and include all their descendants in the
+// column elimination tree that have not been factorized before. cols==0 means 0, ..., ncols-1.
+// x must be zero on entry and is zero on exit
 template<typename T1>
-void casadi_qr(const casadi_int* sp_a, const T1* nz_a, T1* x,
-               const casadi_int* sp_v, T1* nz_v, const casadi_int* sp_r, T1* nz_r, T1* beta,
-               const casadi_int* prinv, const casadi_int* pc) {
+void casadi_qr_cols(const casadi_int* sp_a, const T1* nz_a, T1* x,
+                    const casadi_int* sp_v, T1* nz_v, const casadi_int* sp_r, T1* nz_r, T1* beta,
+                    const casadi_int* prinv, const casadi_int* pc,
+                    const casadi_int* cols, casadi_int ncols) {
    // Local variables
-   casadi_int ncol, nrow, r, c, k, k1;
+   casadi_int ncol, r, c, i, k, k1;
    T1 alpha;
    const casadi_int *a_colind, *a_row, *v_colind, *v_row, *r_colind, *r_row;
    // Extract sparsities
    ncol = sp_a[1];
    a_colind=sp_a+2; a_row=sp_a+2+ncol+1;
-   nrow = sp_v[0];
    v_colind=sp_v+2; v_row=sp_v+2+ncol+1;
    r_colind=sp_r+2; r_row=sp_r+2+ncol+1;
-   // Clear work vector
-   for (r=0; r<nrow; ++r) x[r] = 0;
    // Loop over columns of R, A and V
-   for (c=0; c<ncol; ++c) {
+   for (i=0; i<ncols; ++i) {
+     c = cols ? cols[i] : i;
      // Copy (permuted) column of A to x
      for (k=a_colind[pc[c]]; k<a_colind[pc[c]+1]; ++k) x[prinv[a_row[k]]] = nz_a[k];
      // Use the equality R = (I-betan*vn*vn')*...*(I-beta1*v1*v1')*A to get
@@ -79,7 +74,7 @@ void casadi_qr(const casadi_int* sp_a, const T1* nz_a, T1* x,
        // x -= alpha*v(:,r)
        for (k1=v_colind[r]; k1<v_colind[r+1]; ++k1) x[v_row[k1]] -= alpha*nz_v[k1];
        // Get r entry
-       *nz_r++ = x[r];
+       nz_r[k] = x[r];
        // Strictly upper triangular entries in x no longer needed
        x[r] = 0;
      }
@@ -90,10 +85,33 @@ void casadi_qr(const casadi_int* sp_a, const T1* nz_a, T1* x,
        x[v_row[k]] = 0;
      }
      // Get diagonal entry of R, normalize V column
-     *nz_r++ = casadi_house(nz_v + v_colind[c], beta + c, v_colind[c+1] - v_colind[c]);
+     nz_r[r_colind[c+1]-1] = casadi_house(nz_v + v_colind[c], beta + c,
+                                          v_colind[c+1] - v_colind[c]);
    }
  }
 
+// SYMBOL "qr"
+// Numeric QR factorization
+// Ref: Chapter 5, Direct Methods for Sparse Linear Systems by Tim Davis
+// len[x] = nrow
+// sp_v = [nrow, ncol, 0, 0, ...] len[3 + ncol + nnz_v]
+// len[v] nnz_v
+// sp_r = [nrow, ncol, 0, 0, ...] len[3 + ncol + nnz_r]
+// len[r] nnz_r
+// len[beta] ncol
+template<typename T1>
+void casadi_qr(const casadi_int* sp_a, const T1* nz_a, T1* x,
+               const casadi_int* sp_v, T1* nz_v, const casadi_int* sp_r, T1* nz_r, T1* beta,
+               const casadi_int* prinv, const casadi_int* pc) {
+   // Local variables
+   casadi_int nrow, r;
+   nrow = sp_v[0];
+   // Clear work vector
+   for (r=0; r<nrow; ++r) x[r] = 0;
+   // Factorize all columns
+   casadi_qr_cols(sp_a, nz_a, x, sp_v, nz_v, sp_r, nz_r, beta, prinv, pc, 0, sp_a[1]);
+ }
+
 // SYMBOL "qr_mv"
 // Multiply QR Q matrix from the right with a vector, with Q represented
 // by the Householder vectors V and beta
@@ -268,5 +286,5 @@ void casadi_qr_colcomb(T1* v, const T1* nz_r, const casadi_int* sp_r,
     }
   }
   // Normalize v
-  casadi_scal(ncol, 1./sqrt(casadi_dot(ncol, v, v)), v);
+  casadi_scal(ncol, 1/sqrt(casadi_dot(ncol, v, v)), v);
 }
@@ -35,6 +35,8 @@ struct casadi_qrqp_prob {
   const casadi_int *sp_at, *sp_kkt;
   // Symbolic QR factorization
   const casadi_int *prinv, *pc, *sp_v, *sp_r;
+  // Column elimination tree of R
+  const casadi_int *etree;
   // Smallest nonzero number
   T1 dmin;
   // Infinity
@@ -80,9 +82,13 @@ struct casadi_qrqp_data {
   casadi_qrqp_flag_t status;
   // Vectors
   T1 *lbz, *ubz, *z, *infeas, *tinfeas, *sens, *lam, *w, *dz, *dlam;
-  casadi_int *iw, *neverzero, *neverlower, *neverupper, *lincomb;
+  casadi_int *iw, *neverzero, *neverlower, *neverupper, *lincomb, *modified;
   // Numeric QR factorization
   T1 *nz_at, *nz_kkt, *beta, *nz_v, *nz_r;
+  // Does [v,r,beta] hold the factorization of nz_kkt?
+  int has_fact;
+  // Number of full and partial factorizations
+  casadi_int n_fact, n_update;
   // Message buffer
   const char *msg;
   // Message index
@@ -123,7 +129,7 @@ void casadi_qrqp_work(const casadi_qrqp_prob<T1>* p, casadi_int* sz_arg, casadi_
   nnz_r = p->sp_r[2+p->sp_r[1]];
   // Temporary work vectors
   *sz_w = casadi_max(*sz_w, p->qp->nz); // casadi_project, tau memory
-  *sz_iw = casadi_max(*sz_iw, p->qp->nz); // casadi_trans, tau type, allzero
+  *sz_iw = casadi_max(*sz_iw, p->qp->nz); // casadi_trans, tau type, allzero, refactorized cols
   *sz_w = casadi_max(*sz_w, 2*p->qp->nz); // casadi_qr
   // Persistent work vectors
   *sz_w += nnz_kkt; // kkt
@@ -143,6 +149,7 @@ void casadi_qrqp_work(const casadi_qrqp_prob<T1>* p, casadi_int* sz_arg, casadi_
   *sz_iw += p->qp->nz; // neverupper
   *sz_iw += p->qp->nz; // neverlower
   *sz_iw += p->qp->nz; // lincomb
+  *sz_iw += p->qp->nz; // modified
 }
 
 // SYMBOL "qrqp_init"
@@ -173,6 +180,7 @@ void casadi_qrqp_init(casadi_qrqp_data<T1>* d, casadi_int** iw, T1** w) {
   d->neverupper = *iw; *iw += p->qp->nz;
   d->neverlower = *iw; *iw += p->qp->nz;
   d->lincomb = *iw; *iw += p->qp->nz;
+  d->modified = *iw; *iw += p->qp->nz;
   d->w = *w;
   d->iw = *iw;
 
@@ -218,6 +226,10 @@ int casadi_qrqp_reset(casadi_qrqp_data<T1>* d) {
   d->r_sign = 0;
   // Reset iteration counter
   d->iter = 0;
+  // No factorization
+  d->has_fact = 0;
+  d->n_fact = 0;
+  d->n_update = 0;
   return 0;
 }
 
@@ -389,8 +401,10 @@ void casadi_qrqp_kkt(casadi_qrqp_data<T1>* d) {
         }
       }
     }
-    // Copy row to KKT, zero out w
+    // Copy row to KKT, zero out w, keep track of modified entries
+    d->modified[i] = 0;
     for (k=kkt_colind[i]; k<kkt_colind[i+1]; ++k) {
+      if (d->has_fact && d->nz_kkt[k] != d->w[kkt_row[k]]) d->modified[i] = 1;
       d->nz_kkt[k] = d->w[kkt_row[k]];
       d->w[kkt_row[k]] = 0;
     }
@@ -697,6 +711,8 @@ int casadi_qrqp_flip_check(casadi_qrqp_data<T1>* d) {
 // SYMBOL "qrqp_factorize"
 template<typename T1>
 void casadi_qrqp_factorize(casadi_qrqp_data<T1>* d) {
+  // Local variables
+  casadi_int c, ncols, *cols;
   const casadi_qrqp_prob<T1>* p = d->prob;
   // Do we already have a search direction due to lost singularity?
   if (d->has_search_dir) {
@@ -705,9 +721,32 @@ void casadi_qrqp_factorize(casadi_qrqp_data<T1>* d) {
   }
   // Construct the KKT matrix
   casadi_qrqp_kkt(d);
-  // QR factorization
-  casadi_qr(p->sp_kkt, d->nz_kkt, d->w, p->sp_v, d->nz_v, p->sp_r,
-            d->nz_r, d->beta, p->prinv, p->pc);
+  if (d->has_fact) {
+    // An active-set change only modifies a few columns of the (transposed) KKT. Only these
+    // columns of the factorization and their ancestors in the elimination tree need to
+    // be recalculated. Collect them in increasing order, overwriting the markers in-place
+    cols = d->iw;
+    for (c=0; c<p->qp->nz; ++c) cols[c] = d->modified[p->pc[c]];
+    ncols = 0;
+    for (c=0; c<p->qp->nz; ++c) {
+      if (!cols[c]) continue;
+      if (p->etree[c] >= 0) cols[p->etree[c]] = 1;
+      cols[ncols++] = c;
+    }
+    // Partial QR factorization
+    if (ncols > 0) {
+      casadi_clear(d->w, p->sp_v[0]);
+      casadi_qr_cols(p->sp_kkt, d->nz_kkt, d->w, p->sp_v, d->nz_v, p->sp_r,
+                     d->nz_r, d->beta, p->prinv, p->pc, cols, ncols);
+      d->n_update++;
+    }
+  } else {
+    // QR factorization
+    casadi_qr(p->sp_kkt, d->nz_kkt, d->w, p->sp_v, d->nz_v, p->sp_r,
+              d->nz_r, d->beta, p->prinv, p->pc);
+    d->has_fact = 1;
+    d->n_fact++;
+  }
   // Check singularity
   d->sing = casadi_qr_singular(&d->mina, &d->imina, d->nz_r, p->sp_r, p->pc, 1e-12);
 }
@@ -821,7 +860,8 @@ int casadi_qrqp_singular_step(casadi_qrqp_data<T1>* d) {
     // One, given search direction
     nk = 1;
   } else {
-    // QR factorization of the transpose
+    // QR factorization of the transpose, overwrites the factorization of the KKT
+    d->has_fact = 0;
     casadi_trans(d->nz_kkt, p->sp_kkt, d->nz_v, p->sp_kkt, d->iw);
     nnz_kkt = p->sp_kkt[2+p->qp->nz]; // kkt_colind[nz]
     casadi_copy(d->nz_v, nnz_kkt, d->nz_kkt);
@@ -707,6 +707,10 @@ namespace casadi {
     return (*this)->amd();
   }
 
+  std::vector<casadi_int> Sparsity::nested_dissection() const {
+    return (*this)->nested_dissection();
+  }
+
   casadi_int Sparsity::btf(std::vector<casadi_int>& rowperm, std::vector<casadi_int>& colperm,
                             std::vector<casadi_int>& rowblock, std::vector<casadi_int>& colblock,
                             std::vector<casadi_int>& coarse_rowblock,
@@ -1002,6 +1002,18 @@ namespace casadi {
         \identifier{d8} */
     std::vector<casadi_int> amd() const;
 
+    /** \brief Nested dissection preordering
+
+      Fill-reducing ordering applied to the sparsity pattern of a linear system
+      prior to factorization, by recursively removing vertex separators found with
+      multilevel graph bisection. Ordering the separators last confines the fill-in
+      to the separator blocks, which for large meshes and discretized PDEs typically
+      gives less fill than approximate minimum degree.
+      The system must be symmetric, for an unsymmetric matrix A, first form the square
+      of the pattern, A'*A.
+    */
+    std::vector<casadi_int> nested_dissection() const;
+
 #ifndef SWIG
     /** \brief Propagate sparsity through a linear solve
 
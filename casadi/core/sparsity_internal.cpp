@@ -960,6 +960,272 @@ namespace casadi {
     #undef FLIP
   }
 
+  namespace {
+    // Undirected graph with vertex and edge weights, for nested dissection
+    struct NdGraph {
+      std::vector<casadi_int> xadj, adj, vwgt, ewgt;
+      casadi_int size() const { return xadj.size() - 1;}
+    };
+
+    // Coarsen by heavy-edge matching, cmap maps the vertices to the coarse vertices
+    NdGraph nd_coarsen(const NdGraph& g, std::vector<casadi_int>& cmap) {
+      casadi_int n = g.size();
+      // Visit vertices in order of increasing degree
+      std::vector<casadi_int> order = range(n);
+      std::stable_sort(order.begin(), order.end(), [&](casadi_int i, casadi_int j) {
+        return g.xadj[i+1]-g.xadj[i] < g.xadj[j+1]-g.xadj[j];});
+      // Match each vertex with the unmatched neighbor with the heaviest edge, if any
+      std::vector<casadi_int> match(n, -1), first;
+      cmap.assign(n, -1);
+      for (casadi_int v : order) {
+        if (match[v]>=0) continue;
+        casadi_int u = v, wmax = -1;
+        for (casadi_int k=g.xadj[v]; k<g.xadj[v+1]; ++k) {
+          casadi_int i = g.adj[k];
+          if (match[i]<0 && i!=v && g.ewgt[k]>wmax) {
+            u = i;
+            wmax = g.ewgt[k];
+          }
+        }
+        match[v] = u;
+        match[u] = v;
+        cmap[v] = cmap[u] = first.size();
+        first.push_back(v);
+      }
+      // Coarse graph, merging the adjacency lists of matched pairs
+      casadi_int nc = first.size();
+      NdGraph c;
+      c.xadj.push_back(0);
+      c.vwgt.resize(nc);
+      std::vector<casadi_int> mark(nc, -1), pos(nc);
+      for (casadi_int cv=0; cv<nc; ++cv) {
+        casadi_int pair[2] = {first[cv], match[first[cv]]};
+        casadi_int np = pair[0]==pair[1] ? 1 : 2;
+        c.vwgt[cv] = 0;
+        for (casadi_int i=0; i<np; ++i) {
+          casadi_int v = pair[i];
+          c.vwgt[cv] += g.vwgt[v];
+          for (casadi_int k=g.xadj[v]; k<g.xadj[v+1]; ++k) {
+            casadi_int cu = cmap[g.adj[k]];
+            if (cu==cv) continue;
+            if (mark[cu]==cv) {
+              c.ewgt[pos[cu]] += g.ewgt[k];
+            } else {
+              mark[cu] = cv;
+              pos[cu] = c.adj.size();
+              c.adj.push_back(cu);
+              c.ewgt.push_back(g.ewgt[k]);
+            }
+          }
+        }
+        c.xadj.push_back(c.adj.size());
+      }
+      return c;
+    }
+
+    // Maximum weight of either side of a bisection
+    casadi_int nd_maxwgt(const NdGraph& g) {
+      casadi_int wtot = 0, wmax = 0;
+      for (casadi_int w : g.vwgt) {
+        wtot += w;
+        wmax = std::max(wmax, w);
+      }
+      return std::max((11 * wtot) / 20, (wtot + 1) / 2 + wmax);
+    }
+
+    // Initial bisection by breadth-first growth from a pseudo-peripheral vertex
+    void nd_grow(const NdGraph& g, std::vector<casadi_int>& part) {
+      casadi_int n = g.size();
+      casadi_int wtot = 0;
+      for (casadi_int w : g.vwgt) wtot += w;
+      std::vector<casadi_int> queue;
+      std::vector<bool> visited(n);
+      // Last vertex reached by a breadth-first search from vertex 0
+      casadi_int start = 0;
+      queue.push_back(0);
+      visited[0] = true;
+      for (casadi_int i=0; i<queue.size(); ++i) {
+        start = queue[i];
+        for (casadi_int k=g.xadj[start]; k<g.xadj[start+1]; ++k) {
+          if (!visited[g.adj[k]]) {
+            visited[g.adj[k]] = true;
+            queue.push_back(g.adj[k]);
+          }
+        }
+      }
+      // Grow side 0 from there until it holds half of the weight
+      part.assign(n, 1);
+      std::fill(visited.begin(), visited.end(), false);
+      queue.clear();
+      queue.push_back(start);
+      visited[start] = true;
+      casadi_int w0 = 0, next = 0;
+      for (casadi_int i=0; 2*w0<wtot; ++i) {
+        if (i==queue.size()) {
+          // Disconnected: continue from any unvisited vertex
+          while (visited[next]) next++;
+          queue.push_back(next);
+          visited[next] = true;
+        }
+        casadi_int v = queue[i];
+        part[v] = 0;
+        w0 += g.vwgt[v];
+        for (casadi_int k=g.xadj[v]; k<g.xadj[v+1]; ++k) {
+          if (!visited[g.adj[k]]) {
+            visited[g.adj[k]] = true;
+            queue.push_back(g.adj[k]);
+          }
+        }
+      }
+    }
+
+    // Greedy boundary refinement: move vertices that reduce the cut while keeping balance
+    void nd_refine(const NdGraph& g, std::vector<casadi_int>& part) {
+      casadi_int n = g.size(), wmax = nd_maxwgt(g);
+      casadi_int w[2] = {0, 0};
+      for (casadi_int v=0; v<n; ++v) w[part[v]] += g.vwgt[v];
+      for (casadi_int pass=0; pass<8; ++pass) {
+        bool moved = false;
+        for (casadi_int v=0; v<n; ++v) {
+          casadi_int s = part[v], gain = 0;
+          for (casadi_int k=g.xadj[v]; k<g.xadj[v+1]; ++k) {
+            gain += part[g.adj[k]]==s ? -g.ewgt[k] : g.ewgt[k];
+          }
+          if (gain<0 || w[1-s] + g.vwgt[v] > wmax) continue;
+          // Zero gain moves only if they improve the balance
+          if (gain==0 && w[s] <= w[1-s] + g.vwgt[v]) continue;
+          part[v] = 1-s;
+          w[s] -= g.vwgt[v];
+          w[1-s] += g.vwgt[v];
+          moved = true;
+        }
+        if (!moved) break;
+      }
+    }
+
+    // Multilevel bisection
+    std::vector<casadi_int> nd_bisect(const NdGraph& g) {
+      // Coarsen until small, or no longer shrinking
+      std::vector<NdGraph> levels;
+      std::vector<std::vector<casadi_int> > cmaps;
+      const NdGraph* cur = &g;
+      while (cur->size() > 64) {
+        std::vector<casadi_int> cmap;
+        NdGraph c = nd_coarsen(*cur, cmap);
+        if (10 * c.size() > 9 * cur->size()) break;
+        cmaps.push_back(cmap);
+        levels.push_back(c);
+        cur = &levels.back();
+      }
+      // Bisect the coarsest graph
+      std::vector<casadi_int> part;
+      nd_grow(*cur, part);
+      nd_refine(*cur, part);
+      // Project back, refining on each level
+      for (casadi_int l=cmaps.size()-1; l>=0; --l) {
+        const NdGraph& fine = l>0 ? levels[l-1] : g;
+        std::vector<casadi_int> fpart(fine.size());
+        for (casadi_int v=0; v<fine.size(); ++v) fpart[v] = part[cmaps[l][v]];
+        part.swap(fpart);
+        nd_refine(fine, part);
+      }
+      return part;
+    }
+
+    // Subgraph induced by a set of vertices, in the given order
+    NdGraph nd_subgraph(const NdGraph& g, const std::vector<casadi_int>& verts,
+                        std::vector<casadi_int>& loc) {
+      NdGraph s;
+      s.xadj.push_back(0);
+      for (casadi_int i=0; i<verts.size(); ++i) loc[verts[i]] = i;
+      for (casadi_int v : verts) {
+        s.vwgt.push_back(g.vwgt[v]);
+        for (casadi_int k=g.xadj[v]; k<g.xadj[v+1]; ++k) {
+          casadi_int u = loc[g.adj[k]];
+          if (u>=0) {
+            s.adj.push_back(u);
+            s.ewgt.push_back(g.ewgt[k]);
+          }
+        }
+        s.xadj.push_back(s.adj.size());
+      }
+      for (casadi_int v : verts) loc[v] = -1;
+      return s;
+    }
+
+    // Order a leaf of the dissection with approximate minimum degree
+    void nd_leaf(const NdGraph& g, const std::vector<casadi_int>& label,
+                 std::vector<casadi_int>& perm) {
+      casadi_int n = g.size();
+      if (n<=2) {
+        perm.insert(perm.end(), label.begin(), label.end());
+        return;
+      }
+      std::vector<casadi_int> r = g.adj, c;
+      for (casadi_int v=0; v<n; ++v) {
+        c.insert(c.end(), g.xadj[v+1]-g.xadj[v], v);
+        r.push_back(v);
+      }
+      std::vector<casadi_int> diag = range(n);
+      c.insert(c.end(), diag.begin(), diag.end());
+      for (casadi_int k : Sparsity::triplet(n, n, r, c).amd()) perm.push_back(label[k]);
+    }
+
+    // Recursive nested dissection, appending to perm
+    void nd_order(const NdGraph& g, const std::vector<casadi_int>& label,
+                  std::vector<casadi_int>& perm, std::vector<casadi_int>& loc) {
+      casadi_int n = g.size();
+      if (n<=64) return nd_leaf(g, label, perm);
+      std::vector<casadi_int> part = nd_bisect(g);
+      // Vertex separator: the lighter of the two sides of the edge separator
+      std::vector<casadi_int> bnd[2];
+      casadi_int wbnd[2] = {0, 0};
+      for (casadi_int v=0; v<n; ++v) {
+        for (casadi_int k=g.xadj[v]; k<g.xadj[v+1]; ++k) {
+          if (part[g.adj[k]]!=part[v]) {
+            bnd[part[v]].push_back(v);
+            wbnd[part[v]] += g.vwgt[v];
+            break;
+          }
+        }
+      }
+      casadi_int ssep = wbnd[0]<=wbnd[1] ? 0 : 1;
+      for (casadi_int v : bnd[ssep]) part[v] = 2;
+      // Dissect the remaining parts, separator last
+      std::vector<casadi_int> verts[3];
+      for (casadi_int v=0; v<n; ++v) verts[part[v]].push_back(v);
+      if (verts[0].empty() || verts[1].empty()) return nd_leaf(g, label, perm);
+      for (casadi_int s=0; s<2; ++s) {
+        std::vector<casadi_int> slabel;
+        for (casadi_int v : verts[s]) slabel.push_back(label[v]);
+        nd_order(nd_subgraph(g, verts[s], loc), slabel, perm, loc);
+      }
+      for (casadi_int v : verts[2]) perm.push_back(label[v]);
+    }
+  } // namespace
+
+  std::vector<casadi_int> SparsityInternal::nested_dissection() const {
+    casadi_assert(is_symmetric(), "Nested dissection requires a symmetric matrix");
+    casadi_int n = size2();
+    const casadi_int *colind = this->colind(), *row = this->row();
+    // Adjacency graph, without self-loops
+    NdGraph g;
+    g.xadj.push_back(0);
+    for (casadi_int c=0; c<n; ++c) {
+      for (casadi_int k=colind[c]; k<colind[c+1]; ++k) {
+        if (row[k]!=c) g.adj.push_back(row[k]);
+      }
+      g.xadj.push_back(g.adj.size());
+    }
+    g.vwgt.resize(n, 1);
+    g.ewgt.resize(g.adj.size(), 1);
+    // Recursive dissection
+    std::vector<casadi_int> perm, loc(n, -1);
+    perm.reserve(n);
+    nd_order(g, range(n), perm, loc);
+    return perm;
+  }
+
   void SparsityInternal::bfs(casadi_int n, std::vector<casadi_int>& wi, std::vector<casadi_int>& wj,
                               std::vector<casadi_int>& queue, const std::vector<casadi_int>& imatch,
                               const std::vector<casadi_int>& jmatch, casadi_int mark) const {
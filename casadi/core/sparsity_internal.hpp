@@ -141,6 +141,14 @@ namespace casadi {
         \identifier{en} */
     std::vector<casadi_int> amd() const;
 
+    /** \brief Nested dissection ordering by multilevel graph bisection
+
+      * Heavy-edge matching coarsening, breadth-first initial bisection, greedy
+      * boundary refinement on each level. Subgraphs of at most 64 vertices are
+      * ordered with AMD.
+      */
+    std::vector<casadi_int> nested_dissection() const;
+
     /** \brief Calculate the elimination tree for a matrix
 
       * len[w] >= ata ? ncol + nrow : ncol
@@ -42,6 +42,8 @@ namespace casadi {
   // Allocate storage for the caching
   CACHING_MAP<casadi_int, IntegerSX*> IntegerSX::cached_constants_;
   CACHING_MAP<double, RealtypeSX*> RealtypeSX::cached_constants_;
+  SXNodeTable<BinarySX> BinarySX::cached_nodes_;
+  SXNodeTable<UnarySX> UnarySX::cached_nodes_;
 
   SXElem::SXElem() {
     node = casadi_limits<SXElem>::nan.node;
@@ -24,6 +24,8 @@
 
 
 #include "sx_function.hpp"
+#include "sx_reverse.hpp"
+#include "sx_taylor.hpp"
 #include <limits>
 #include <stack>
 #include <deque>
@@ -47,6 +49,7 @@ namespace casadi {
     // Default (persistent) options
     just_in_time_opencl_ = false;
     just_in_time_sparsity_ = false;
+    numeric_reverse_ = false;
   }
 
   SXFunction::~SXFunction() {
@@ -195,7 +198,11 @@ namespace casadi {
         "Allow construction with free variables (Default: false)"}},
       {"allow_duplicate_io_names",
        {OT_BOOL,
-        "Allow construction with duplicate io names (Default: false)"}}
+        "Allow construction with duplicate io names (Default: false)"}},
+      {"numeric_reverse",
+       {OT_BOOL,
+        "Calculate reverse mode derivatives by replaying a numeric tape of the algorithm "
+        "instead of constructing a derivative expression graph (Default: false)"}}
      }
   };
 
@@ -205,6 +212,7 @@ namespace casadi {
     opts["live_variables"] = live_variables_;
     opts["just_in_time_sparsity"] = just_in_time_sparsity_;
     opts["just_in_time_opencl"] = just_in_time_opencl_;
+    opts["numeric_reverse"] = numeric_reverse_;
     return opts;
   }
 
@@ -233,6 +241,8 @@ namespace casadi {
         cse_opt = op.second;
       } else if (op.first=="allow_free") {
         allow_free = op.second;
+      } else if (op.first=="numeric_reverse") {
+        numeric_reverse_ = op.second;
       }
     }
 
@@ -798,6 +808,25 @@ namespace casadi {
     }
   }
 
+  Function SXFunction::get_reverse(casadi_int nadj, const std::string& name,
+                                   const std::vector<std::string>& inames,
+                                   const std::vector<std::string>& onames,
+                                   const Dict& opts) const {
+    // Symbolic reverse mode, unless a numeric tape has been requested
+    if (!numeric_reverse_ || has_free()) {
+      return XFunction<SXFunction, SX, SXNode>::get_reverse(nadj, name, inames, onames, opts);
+    }
+    // Options specific to SXFunction do not apply
+    Dict tape_opts = opts;
+    for (auto&& e : options_.entries) tape_opts.erase(e.first);
+    return Function::create(new SXReverse(name, nadj, inames, onames), tape_opts);
+  }
+
+  Function SXFunction::get_taylor(casadi_int order, const std::string& name,
+                                  const Dict& opts) const {
+    return Function::create(new SXTaylor(name, self(), order), opts);
+  }
+
   int SXFunction::
   sp_forward(const bvec_t** arg, bvec_t** res, casadi_int* iw, bvec_t* w, void* mem) const {
     // Fall back when forward mode not allowed
@@ -975,7 +1004,7 @@ namespace casadi {
 
   SXFunction::SXFunction(DeserializingStream& s) :
     XFunction<SXFunction, SX, SXNode>(s) {
-    s.version("SXFunction", 1);
+    int version = s.version("SXFunction", 1, 2);
     size_t n_instructions;
     s.unpack("SXFunction::n_instr", n_instructions);
 
@@ -999,13 +1028,15 @@ namespace casadi {
     just_in_time_sparsity_ = false;
 
     s.unpack("SXFunction::live_variables", live_variables_);
+    numeric_reverse_ = false;
+    if (version >= 2) s.unpack("SXFunction::numeric_reverse", numeric_reverse_);
 
     XFunction<SXFunction, SX, SXNode>::delayed_deserialize_members(s);
   }
 
   void SXFunction::serialize_body(SerializingStream &s) const {
     XFunction<SXFunction, SX, SXNode>::serialize_body(s);
-    s.version("SXFunction", 1);
+    s.version("SXFunction", 2);
     s.pack("SXFunction::n_instr", algorithm_.size());
 
     s.pack("SXFunction::worksize", worksize_);
@@ -1023,6 +1054,7 @@ namespace casadi {
     }
 
     s.pack("SXFunction::live_variables", live_variables_);
+    s.pack("SXFunction::numeric_reverse", numeric_reverse_);
 
     XFunction<SXFunction, SX, SXNode>::delayed_serialize_members(s);
   }
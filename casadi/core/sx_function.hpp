@@ -95,6 +95,20 @@ class CASADI_EXPORT SXFunction :
   void ad_reverse(const std::vector<std::vector<SX> >& aseed,
                             std::vector<std::vector<SX> >& asens) const;
 
+  /** \brief Generate a function that calculates reverse mode derivatives
+
+      Uses a numeric tape (SXReverse) instead of a symbolic expression graph
+      if the option 'numeric_reverse' has been set.
+  */
+  Function get_reverse(casadi_int nadj, const std::string& name,
+                       const std::vector<std::string>& inames,
+                       const std::vector<std::string>& onames,
+                       const Dict& opts) const override;
+
+  /** \brief Propagate univariate Taylor polynomials numerically (SXTaylor) */
+  Function get_taylor(casadi_int order, const std::string& name,
+                      const Dict& opts) const override;
+
   /** \brief  Check if smooth
 
       \identifier{ui} */
@@ -306,6 +320,9 @@ class CASADI_EXPORT SXFunction :
   /// Live variables?
   bool live_variables_;
 
+  /// Reverse mode derivatives by replaying a numeric tape?
+  bool numeric_reverse_;
+
 protected:
   /** \brief Deserializing constructor
 
@@ -30,11 +30,77 @@
 #include "constant_sx.hpp"
 #include "symbolic_sx.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <limits>
 #include <stack>
+#include <vector>
 
 namespace casadi {
 
+  namespace {
+    // Pool of equally sized blocks, allocated in chunks and never returned to the heap
+    class SXNodePool {
+    public:
+      explicit SXNodePool(size_t block_size) : block_size_(block_size), free_(nullptr) {}
+
+      void* allocate() {
+        if (free_==nullptr) grow();
+        void* ptr = free_;
+        free_ = *static_cast<void**>(free_);
+        return ptr;
+      }
+
+      void deallocate(void* ptr) {
+        *static_cast<void**>(ptr) = free_;
+        free_ = ptr;
+      }
+
+    private:
+      void grow() {
+        // Chunks double in size, up to a limit (clamp the exponent, not the shifted value)
+        size_t n = static_cast<size_t>(64) << std::min(chunks_.size(), static_cast<size_t>(8));
+        char* chunk = static_cast<char*>(::operator new(n * block_size_));
+        chunks_.push_back(chunk);
+        // Thread onto the free list such that blocks are handed out in address order
+        for (size_t i=n; i-->0;) deallocate(chunk + i * block_size_);
+      }
+
+      size_t block_size_;
+      void* free_;
+      std::vector<char*> chunks_;
+    };
+
+    // Granularity of the size classes, largest pooled node
+    const size_t pool_align = alignof(std::max_align_t);
+    const size_t pool_max = 8 * pool_align;
+
+    // Pool for a size class
+    SXNodePool& sx_node_pool(size_t sz) {
+      // Never destroyed, since nodes may be released during static destruction
+      static std::vector<SXNodePool>* pools = [] {
+        auto* p = new std::vector<SXNodePool>();
+        for (size_t k=1; k*pool_align<=pool_max; ++k) p->emplace_back(k*pool_align);
+        return p;
+      }();
+      return (*pools)[(sz - 1) / pool_align];
+    }
+  } // namespace
+
+  void* SXNode::operator new(std::size_t sz) {
+    if (sz>pool_max) return ::operator new(sz);
+    return sx_node_pool(sz).allocate();
+  }
+
+  void SXNode::operator delete(void* ptr, std::size_t sz) {
+    if (ptr==nullptr) return;
+    if (sz>pool_max) {
+      ::operator delete(ptr);
+    } else {
+      sx_node_pool(sz).deallocate(ptr);
+    }
+  }
+
   SXNode::SXNode() {
     count = 0;
     temp = 0;
@@ -155,6 +221,8 @@ namespace casadi {
   void SXNode::safe_delete(SXNode* n) {
     // Quick return if more owners
     if (n->count>0) return;
+    // Remove from hash-consing table before releasing the dependencies
+    n->uncache();
     // Delete straight away if it doesn't have any dependencies
     if (!n->n_dep()) {
       delete n;
@@ -182,6 +250,7 @@ namespace casadi {
             delete n2;
           } else {
             // Add to deletion stack
+            n2->uncache();
             deletion_stack.push(n2);
             added_to_stack = true;
           }
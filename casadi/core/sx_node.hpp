@@ -30,6 +30,7 @@
 #include <math.h>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 /** \brief  Scalar expression (which also works as a smart pointer class to this class)
 
@@ -62,6 +63,17 @@ namespace casadi {
         \identifier{9v} */
     virtual ~SXNode();
 
+    ///@{
+    /** \brief Allocate nodes from per-size-class pools instead of the heap
+
+        Freed nodes are kept on a free list and reused by subsequent allocations
+        of the same size class, which avoids allocator calls and keeps nodes
+        created together close in memory.
+    */
+    static void* operator new(std::size_t sz);
+    static void operator delete(void* ptr, std::size_t sz);
+    ///@}
+
     ///@{
     /** \brief  check properties of a node
 
@@ -157,6 +169,12 @@ namespace casadi {
         \identifier{a9} */
     static void safe_delete(SXNode* n);
 
+    /** \brief Remove from the hash-consing table, if present
+
+        Must be called while the dependencies are still attached
+    */
+    virtual void uncache() {}
+
     // Depth when checking equalities
     static casadi_int eq_depth_;
 
@@ -183,6 +201,33 @@ namespace casadi {
 
   };
 
+  /** \brief Operation and dependencies of a node, key for hash-consing
+
+      Unary operations have a null second dependency
+  */
+  struct SXNodeKey {
+    unsigned char op;
+    const SXNode* dep0;
+    const SXNode* dep1;
+    bool operator==(const SXNodeKey& k) const {
+      return op==k.op && dep0==k.dep0 && dep1==k.dep1;
+    }
+  };
+
+  /// Hash function for SXNodeKey
+  struct SXNodeKeyHash {
+    std::size_t operator()(const SXNodeKey& k) const {
+      std::size_t h = std::hash<const SXNode*>()(k.dep0);
+      h ^= std::hash<const SXNode*>()(k.dep1) + 0x9e3779b9 + (h << 6) + (h >> 2);
+      h ^= static_cast<std::size_t>(k.op) + 0x9e3779b9 + (h << 6) + (h >> 2);
+      return h;
+    }
+  };
+
+  /// Table of nodes for hash-consing
+  template<typename NodeType>
+  using SXNodeTable = std::unordered_map<SXNodeKey, NodeType*, SXNodeKeyHash>;
+
 } // namespace casadi
 /// \endcond
 #endif // CASADI_SX_NODE_HPP
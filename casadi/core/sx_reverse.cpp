@@ -0,0 +1,193 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#include "sx_reverse.hpp"
+
+namespace casadi {
+
+  SXReverse::SXReverse(const std::string& name, casadi_int nadj,
+                       const std::vector<std::string>& name_in,
+                       const std::vector<std::string>& name_out)
+    : FunctionInternal(name), nadj_(nadj) {
+    name_in_ = name_in;
+    name_out_ = name_out;
+  }
+
+  SXReverse::~SXReverse() {
+    clear_mem();
+  }
+
+  void SXReverse::init(const Dict& opts) {
+    // Call the initialization method of the base class
+    FunctionInternal::init(opts);
+
+    // Differentiated function
+    casadi_assert(!derivative_of_.is_null() && derivative_of_.is_a("SXFunction"),
+      "SXReverse requires 'derivative_of' to be an SXFunction");
+    casadi_assert(!f()->has_free(), "Cannot create numeric reverse mode derivatives of '"
+      + derivative_of_.name() + "' since variables " + str(f()->free_sx()) + " are free.");
+
+    // Two partial derivatives for every operation
+    n_tape_ = 2 * f()->operations_.size();
+
+    // Work vectors for nondifferentiated values, adjoints and the tape
+    alloc_w(f()->worksize_, true);
+    alloc_w(f()->worksize_, true);
+    alloc_w(n_tape_, true);
+
+    if (verbose_) {
+      casadi_message("Numeric reverse mode with " + str(nadj_) + " directions and a tape of "
+        + str(n_tape_) + " entries");
+    }
+  }
+
+  Sparsity SXReverse::get_sparsity_in(casadi_int i) {
+    casadi_int n_in = derivative_of_.n_in(), n_out = derivative_of_.n_out();
+    if (i<n_in) {
+      // Non-differentiated input
+      return derivative_of_.sparsity_in(i);
+    } else if (i<n_in+n_out) {
+      // Non-differentiated output
+      return derivative_of_.sparsity_out(i-n_in);
+    } else {
+      // Seeds
+      return repmat(derivative_of_.sparsity_out(i-n_in-n_out), 1, nadj_);
+    }
+  }
+
+  Sparsity SXReverse::get_sparsity_out(casadi_int i) {
+    return repmat(derivative_of_.sparsity_in(i), 1, nadj_);
+  }
+
+  double SXReverse::get_default_in(casadi_int ind) const {
+    if (ind<derivative_of_.n_in()) {
+      return derivative_of_.default_in(ind);
+    } else {
+      return 0;
+    }
+  }
+
+  int SXReverse::eval(const double** arg, double** res,
+      casadi_int* iw, double* w, void* mem) const {
+    const SXFunction* f = this->f();
+    casadi_int n_in = f->n_in_, n_out = f->n_out_;
+
+    // Nondifferentiated values, adjoints and the tape of partial derivatives
+    double* v = w;
+    w += f->worksize_;
+    double* vb = w;
+    w += f->worksize_;
+    double* tape = w;
+
+    // Adjoint seeds
+    const double** seed = arg + n_in + n_out;
+
+    // Forward sweep: evaluate the algorithm, recording the partial derivatives
+    double* t = tape;
+    double r;
+    for (auto&& e : f->algorithm_) {
+      switch (e.op) {
+      case OP_CONST: v[e.i0] = e.d; break;
+      case OP_INPUT: v[e.i0] = arg[e.i1]==nullptr ? 0 : arg[e.i1][e.i2]; break;
+      case OP_OUTPUT: break;
+      default:
+        switch (e.op) {
+          CASADI_MATH_DERF_BUILTIN(v[e.i1], v[e.i2], r, t)
+        default:
+          casadi_error("Unknown operation" + str(e.op));
+        }
+        v[e.i0] = r;
+        t += 2;
+      }
+    }
+    casadi_assert_dev(t==tape+n_tape_);
+
+    // Clear adjoint sensitivities
+    for (casadi_int i=0; i<n_in; ++i) {
+      if (res[i]) casadi_clear(res[i], nadj_ * f->nnz_in(i));
+    }
+
+    // Reverse sweep for each direction
+    std::fill_n(vb, f->worksize_, 0);
+    for (casadi_int d=0; d<nadj_; ++d) {
+      t = tape + n_tape_;
+      for (auto it = f->algorithm_.rbegin(); it!=f->algorithm_.rend(); ++it) {
+        switch (it->op) {
+        case OP_INPUT:
+          if (res[it->i1] && f->is_diff_in_[it->i1]) {
+            res[it->i1][d * f->nnz_in(it->i1) + it->i2] = vb[it->i0];
+          }
+          vb[it->i0] = 0;
+          break;
+        case OP_OUTPUT:
+          if (seed[it->i0]) vb[it->i1] += seed[it->i0][d * f->nnz_out(it->i0) + it->i2];
+          break;
+        case OP_CONST:
+          vb[it->i0] = 0;
+          break;
+        case OP_IF_ELSE_ZERO:
+          t -= 2;
+          r = vb[it->i0];
+          vb[it->i0] = 0;
+          vb[it->i2] += if_else_zero(t[1], r);
+          break;
+        CASADI_MATH_BINARY_BUILTIN // Binary operation
+          t -= 2;
+          r = vb[it->i0];
+          vb[it->i0] = 0;
+          vb[it->i1] += t[0] * r;
+          vb[it->i2] += t[1] * r;
+          break;
+        default: // Unary operation
+          t -= 2;
+          r = vb[it->i0];
+          vb[it->i0] = 0;
+          vb[it->i1] += t[0] * r;
+        }
+      }
+    }
+    return 0;
+  }
+
+  Function SXReverse::symbolic() const {
+    return f()->XFunction<SXFunction, SX, SXNode>::get_reverse(nadj_, name_ + "_sx",
+      name_in_, name_out_, Dict());
+  }
+
+  Function SXReverse::get_forward(casadi_int nfwd, const std::string& name,
+                                  const std::vector<std::string>& inames,
+                                  const std::vector<std::string>& onames,
+                                  const Dict& opts) const {
+    return symbolic()->get_forward(nfwd, name, inames, onames, opts);
+  }
+
+  Function SXReverse::get_reverse(casadi_int nadj, const std::string& name,
+                                  const std::vector<std::string>& inames,
+                                  const std::vector<std::string>& onames,
+                                  const Dict& opts) const {
+    return symbolic()->get_reverse(nadj, name, inames, onames, opts);
+  }
+
+} // namespace casadi
@@ -0,0 +1,107 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef CASADI_SX_REVERSE_HPP
+#define CASADI_SX_REVERSE_HPP
+
+#include "sx_function.hpp"
+
+/// \cond INTERNAL
+
+namespace casadi {
+
+/** \brief Reverse mode directional derivatives of an SXFunction, numerically
+
+    Replays the algorithm of the SXFunction forward while recording the partial
+    derivatives of each operation on a tape, then sweeps the tape backwards once
+    for every adjoint direction. No derivative expression graph is created, so
+    the setup cost is independent of the size of the expression graph.
+*/
+class CASADI_EXPORT SXReverse : public FunctionInternal {
+public:
+  // Constructor (use Function::create)
+  SXReverse(const std::string& name, casadi_int nadj,
+            const std::vector<std::string>& name_in,
+            const std::vector<std::string>& name_out);
+
+  /** \brief Destructor */
+  ~SXReverse() override;
+
+  /** \brief Get type name */
+  std::string class_name() const override {return "SXReverse";}
+
+  /// @{
+  /** \brief Sparsities of function inputs and outputs */
+  Sparsity get_sparsity_in(casadi_int i) override;
+  Sparsity get_sparsity_out(casadi_int i) override;
+  /// @}
+
+  /** \brief Get default input value */
+  double get_default_in(casadi_int ind) const override;
+
+  ///@{
+  /** \brief Number of function inputs and outputs, names are set in the constructor */
+  size_t get_n_in() override { return name_in_.size();}
+  size_t get_n_out() override { return name_out_.size();}
+  ///@}
+
+  /** \brief  Initialize */
+  void init(const Dict& opts) override;
+
+  /** \brief  Evaluate numerically */
+  int eval(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const override;
+
+  ///@{
+  /** \brief Higher order derivatives, via the symbolic adjoint of the SXFunction */
+  bool has_forward(casadi_int nfwd) const override { return true;}
+  Function get_forward(casadi_int nfwd, const std::string& name,
+                       const std::vector<std::string>& inames,
+                       const std::vector<std::string>& onames,
+                       const Dict& opts) const override;
+  bool has_reverse(casadi_int nadj) const override { return true;}
+  Function get_reverse(casadi_int nadj, const std::string& name,
+                       const std::vector<std::string>& inames,
+                       const std::vector<std::string>& onames,
+                       const Dict& opts) const override;
+  ///@}
+
+protected:
+  /// Get the differentiated function
+  const SXFunction* f() const { return derivative_of_.get<SXFunction>();}
+
+  /// Symbolic adjoint function, same signature as this function
+  Function symbolic() const;
+
+  // Number of adjoint directions
+  casadi_int nadj_;
+
+  // Number of entries on the tape
+  casadi_int n_tape_;
+};
+
+} // namespace casadi
+
+/// \endcond
+#endif // CASADI_SX_REVERSE_HPP
@@ -0,0 +1,351 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#include "sx_taylor.hpp"
+
+namespace casadi {
+
+  // All routines below operate on n Taylor coefficients. Unless stated otherwise,
+  // the result z must not alias any of the arguments.
+  namespace {
+
+    // z = x*y
+    void taylor_mul(const double* x, const double* y, double* z, casadi_int n) {
+      for (casadi_int j=0; j<n; ++j) {
+        z[j] = 0;
+        for (casadi_int i=0; i<=j; ++i) z[j] += x[i]*y[j-i];
+      }
+    }
+
+    // z = x/y
+    void taylor_div(const double* x, const double* y, double* z, casadi_int n) {
+      for (casadi_int j=0; j<n; ++j) {
+        z[j] = x[j];
+        for (casadi_int i=0; i<j; ++i) z[j] -= z[i]*y[j-i];
+        z[j] /= y[0];
+      }
+    }
+
+    // Higher order coefficients of z, given z' = a*x'. a may alias z.
+    void taylor_integrate(const double* x, const double* a, double* z, casadi_int n) {
+      for (casadi_int j=1; j<n; ++j) {
+        z[j] = 0;
+        for (casadi_int i=1; i<=j; ++i) z[j] += static_cast<double>(i)*x[i]*a[j-i];
+        z[j] /= static_cast<double>(j);
+      }
+    }
+
+    // Higher order coefficients of z, given r*z' = x'
+    void taylor_quotient(const double* x, const double* r, double* z, casadi_int n) {
+      for (casadi_int j=1; j<n; ++j) {
+        z[j] = static_cast<double>(j)*x[j];
+        for (casadi_int i=1; i<j; ++i) z[j] -= static_cast<double>(i)*z[i]*r[j-i];
+        z[j] /= static_cast<double>(j)*r[0];
+      }
+    }
+
+    // z = exp(x)
+    void taylor_exp(const double* x, double* z, casadi_int n) {
+      z[0] = exp(x[0]);
+      taylor_integrate(x, z, z, n);
+    }
+
+    // z = sqrt(x)
+    void taylor_sqrt(const double* x, double* z, casadi_int n) {
+      z[0] = sqrt(x[0]);
+      for (casadi_int j=1; j<n; ++j) {
+        z[j] = x[j];
+        for (casadi_int i=1; i<j; ++i) z[j] -= z[i]*z[j-i];
+        z[j] /= 2*z[0];
+      }
+    }
+
+    // z = x^a, a constant
+    void taylor_constpow(const double* x, double a, double* z, casadi_int n, double* t) {
+      if (x[0]==0 && a>=0 && a==floor(a)) {
+        // Nonnegative integer power at the origin: repeated multiplication
+        std::fill_n(z, n, 0);
+        z[0] = 1;
+        for (casadi_int k=0; k<static_cast<casadi_int>(a); ++k) {
+          std::copy_n(z, n, t);
+          taylor_mul(t, x, z, n);
+        }
+        return;
+      }
+      z[0] = pow(x[0], a);
+      for (casadi_int j=1; j<n; ++j) {
+        z[j] = 0;
+        for (casadi_int i=1; i<=j; ++i) {
+          z[j] += ((a+1)*static_cast<double>(i) - static_cast<double>(j))*x[i]*z[j-i];
+        }
+        z[j] /= static_cast<double>(j)*x[0];
+      }
+    }
+
+    // s = sin(x), c = cos(x), or sinh/cosh if hyperbolic
+    void taylor_sincos(const double* x, double* s, double* c, casadi_int n, bool hyperbolic) {
+      s[0] = hyperbolic ? sinh(x[0]) : sin(x[0]);
+      c[0] = hyperbolic ? cosh(x[0]) : cos(x[0]);
+      for (casadi_int j=1; j<n; ++j) {
+        s[j] = c[j] = 0;
+        for (casadi_int i=1; i<=j; ++i) {
+          s[j] += static_cast<double>(i)*x[i]*c[j-i];
+          c[j] += static_cast<double>(i)*x[i]*s[j-i];
+        }
+        s[j] /= static_cast<double>(j);
+        c[j] /= hyperbolic ? static_cast<double>(j) : -static_cast<double>(j);
+      }
+    }
+
+    // z = tan(x) or tanh(x), using z' = (1 +/- z^2) x'
+    void taylor_tan(const double* x, double* z, casadi_int n, bool hyperbolic, double* u) {
+      double sgn = hyperbolic ? -1 : 1;
+      z[0] = hyperbolic ? tanh(x[0]) : tan(x[0]);
+      u[0] = 1 + sgn*z[0]*z[0];
+      for (casadi_int j=1; j<n; ++j) {
+        z[j] = 0;
+        for (casadi_int i=1; i<=j; ++i) z[j] += static_cast<double>(i)*x[i]*u[j-i];
+        z[j] /= static_cast<double>(j);
+        u[j] = 0;
+        for (casadi_int i=0; i<=j; ++i) u[j] += z[i]*z[j-i];
+        u[j] *= sgn;
+      }
+    }
+
+    // r = c + s*x^2
+    void taylor_quad(const double* x, double c, double s, double* r, casadi_int n) {
+      taylor_mul(x, x, r, n);
+      for (casadi_int j=0; j<n; ++j) r[j] *= s;
+      r[0] += c;
+    }
+
+    // Taylor coefficients of an elementary operation, z may alias x or y
+    void taylor_op(casadi_int op, const double* x, const double* y, double* z,
+                   casadi_int n, double* w) {
+      // Work vectors
+      double *r = w, *t1 = w + n, *t2 = w + 2*n, *t3 = w + 3*n;
+      // Zeroth order coefficient, partial derivatives
+      double f, d[2];
+      casadi_math<double>::derF(op, x[0], y[0], f, d);
+      switch (op) {
+        case OP_MUL: taylor_mul(x, y, r, n); break;
+        case OP_SQ: taylor_mul(x, x, r, n); break;
+        case OP_DIV: taylor_div(x, y, r, n); break;
+        case OP_INV:
+          std::fill_n(t1, n, 0);
+          t1[0] = 1;
+          taylor_div(t1, x, r, n);
+          break;
+        case OP_EXP: taylor_exp(x, r, n); break;
+        case OP_EXPM1:
+          taylor_exp(x, r, n);
+          r[0] = f;
+          break;
+        case OP_LOG:
+          taylor_quotient(x, x, r, n);
+          break;
+        case OP_LOG1P:
+          std::copy_n(x, n, t1);
+          t1[0] += 1;
+          taylor_quotient(x, t1, r, n);
+          break;
+        case OP_SQRT: taylor_sqrt(x, r, n); break;
+        case OP_CONSTPOW:
+          taylor_constpow(x, y[0], r, n, t1);
+          break;
+        case OP_POW:
+          if (std::all_of(y + 1, y + n, [](double v) { return v==0;})) {
+            // Constant exponent
+            taylor_constpow(x, y[0], r, n, t1);
+          } else {
+            // x^y = exp(y*log(x))
+            t1[0] = log(x[0]);
+            taylor_quotient(x, x, t1, n);
+            taylor_mul(y, t1, t2, n);
+            taylor_exp(t2, r, n);
+          }
+          break;
+        case OP_SIN: taylor_sincos(x, r, t1, n, false); break;
+        case OP_COS: taylor_sincos(x, t1, r, n, false); break;
+        case OP_SINH: taylor_sincos(x, r, t1, n, true); break;
+        case OP_COSH: taylor_sincos(x, t1, r, n, true); break;
+        case OP_TAN: taylor_tan(x, r, n, false, t1); break;
+        case OP_TANH: taylor_tan(x, r, n, true, t1); break;
+        case OP_ASIN:
+        case OP_ACOS:
+          // z' = +/- x' / sqrt(1 - x^2)
+          taylor_quad(x, 1, -1, t1, n);
+          taylor_sqrt(t1, t2, n);
+          taylor_quotient(x, t2, r, n);
+          if (op==OP_ACOS) for (casadi_int j=1; j<n; ++j) r[j] = -r[j];
+          break;
+        case OP_ATAN:
+          taylor_quad(x, 1, 1, t1, n);
+          taylor_quotient(x, t1, r, n);
+          break;
+        case OP_ASINH:
+          taylor_quad(x, 1, 1, t1, n);
+          taylor_sqrt(t1, t2, n);
+          taylor_quotient(x, t2, r, n);
+          break;
+        case OP_ACOSH:
+          taylor_quad(x, -1, 1, t1, n);
+          taylor_sqrt(t1, t2, n);
+          taylor_quotient(x, t2, r, n);
+          break;
+        case OP_ATANH:
+          taylor_quad(x, 1, -1, t1, n);
+          taylor_quotient(x, t1, r, n);
+          break;
+        case OP_ERF:
+          // z' = 2/sqrt(pi) * exp(-x^2) * x'
+          taylor_quad(x, 0, -1, t1, n);
+          taylor_exp(t1, t2, n);
+          for (casadi_int j=0; j<n; ++j) t2[j] *= 2/sqrt(M_PI);
+          taylor_integrate(x, t2, r, n);
+          break;
+        case OP_ERFINV:
+          // z' = sqrt(pi)/2 * exp(z^2) * x', with e = sqrt(pi)/2 * exp(z^2) built up alongside
+          r[0] = f;
+          t1[0] = f*f;
+          t2[0] = sqrt(M_PI)/2*exp(t1[0]);
+          for (casadi_int j=1; j<n; ++j) {
+            r[j] = 0;
+            for (casadi_int i=1; i<=j; ++i) r[j] += static_cast<double>(i)*x[i]*t2[j-i];
+            r[j] /= static_cast<double>(j);
+            t1[j] = 0;
+            for (casadi_int i=0; i<=j; ++i) t1[j] += r[i]*r[j-i];
+            t2[j] = 0;
+            for (casadi_int i=1; i<=j; ++i) t2[j] += static_cast<double>(i)*t1[i]*t2[j-i];
+            t2[j] /= static_cast<double>(j);
+          }
+          break;
+        case OP_ATAN2:
+          // (x^2 + y^2) z' = y x' - x y'
+          taylor_mul(x, x, t1, n);
+          taylor_mul(y, y, t2, n);
+          for (casadi_int j=0; j<n; ++j) t1[j] += t2[j];
+          for (casadi_int j=1; j<n; ++j) {
+            r[j] = 0;
+            for (casadi_int i=1; i<=j; ++i) {
+              r[j] += static_cast<double>(i)*(x[i]*y[j-i] - y[i]*x[j-i]);
+            }
+            for (casadi_int i=1; i<j; ++i) r[j] -= static_cast<double>(i)*r[i]*t1[j-i];
+            r[j] /= static_cast<double>(j)*t1[0];
+          }
+          break;
+        case OP_HYPOT:
+          taylor_mul(x, x, t1, n);
+          taylor_mul(y, y, t2, n);
+          for (casadi_int j=0; j<n; ++j) t3[j] = t1[j] + t2[j];
+          taylor_sqrt(t3, r, n);
+          break;
+        default:
+          // Remaining operations are locally linear (or constant) in their arguments
+          for (casadi_int j=1; j<n; ++j) r[j] = d[0]*x[j] + d[1]*y[j];
+      }
+      // Zeroth order coefficient as in numerical evaluation
+      r[0] = f;
+      std::copy_n(r, n, z);
+    }
+
+  } // namespace
+
+  SXTaylor::SXTaylor(const std::string& name, const Function& f, casadi_int order)
+    : FunctionInternal(name), f_(f), order_(order) {
+  }
+
+  SXTaylor::~SXTaylor() {
+    clear_mem();
+  }
+
+  void SXTaylor::init(const Dict& opts) {
+    // Call the initialization method of the base class
+    FunctionInternal::init(opts);
+
+    casadi_assert(order_>=0, "Taylor polynomial degree must be nonnegative");
+    const SXFunction* f = f_.get<SXFunction>();
+    casadi_assert(!f->has_free(), "Cannot propagate Taylor polynomials through '"
+      + f_.name() + "' since variables " + str(f->free_sx()) + " are free.");
+
+    // Coefficients for every work vector element, temporaries
+    casadi_int n = order_ + 1;
+    alloc_w(f->worksize_ * n, true);
+    alloc_w(4 * n, true);
+
+    if (verbose_) {
+      casadi_message("Taylor polynomials of degree " + str(order_) + " through "
+        + str(f->algorithm_.size()) + " elementary operations");
+    }
+  }
+
+  Sparsity SXTaylor::get_sparsity_in(casadi_int i) {
+    return repmat(f_.sparsity_in(i), 1, order_ + 1);
+  }
+
+  Sparsity SXTaylor::get_sparsity_out(casadi_int i) {
+    return repmat(f_.sparsity_out(i), 1, order_ + 1);
+  }
+
+  double SXTaylor::get_default_in(casadi_int ind) const {
+    return f_.default_in(ind);
+  }
+
+  int SXTaylor::eval(const double** arg, double** res,
+      casadi_int* iw, double* w, void* mem) const {
+    const SXFunction* f = f_.get<SXFunction>();
+    casadi_int n = order_ + 1;
+
+    // Taylor coefficients of all work vector elements, temporaries
+    double* v = w;
+    w += f->worksize_ * n;
+
+    // Propagate Taylor coefficients in a single sweep
+    for (auto&& e : f->algorithm_) {
+      switch (e.op) {
+      case OP_CONST:
+        v[e.i0*n] = e.d;
+        std::fill_n(v + e.i0*n + 1, order_, 0);
+        break;
+      case OP_INPUT:
+        for (casadi_int j=0; j<n; ++j) {
+          v[e.i0*n + j] = arg[e.i1]==nullptr ? 0 : arg[e.i1][j*f->nnz_in(e.i1) + e.i2];
+        }
+        break;
+      case OP_OUTPUT:
+        if (res[e.i0]!=nullptr) {
+          for (casadi_int j=0; j<n; ++j) {
+            res[e.i0][j*f->nnz_out(e.i0) + e.i2] = v[e.i1*n + j];
+          }
+        }
+        break;
+      default:
+        taylor_op(e.op, v + e.i1*n, v + e.i2*n, v + e.i0*n, n, w);
+      }
+    }
+    return 0;
+  }
+
+} // namespace casadi
@@ -0,0 +1,92 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef CASADI_SX_TAYLOR_HPP
+#define CASADI_SX_TAYLOR_HPP
+
+#include "sx_function.hpp"
+
+/// \cond INTERNAL
+
+namespace casadi {
+
+/** \brief Univariate Taylor polynomial propagation through an SXFunction
+
+    Every input holds the Taylor coefficients x_0, ..., x_order of a curve
+    x(t) = x_0 + x_1*t + ... + x_order*t^order, stacked horizontally. The outputs
+    hold the Taylor coefficients of the function outputs along this curve, which
+    are obtained in a single sweep through the algorithm at a cost of O(order^2)
+    per operation.
+*/
+class CASADI_EXPORT SXTaylor : public FunctionInternal {
+public:
+  // Constructor (use Function::create)
+  SXTaylor(const std::string& name, const Function& f, casadi_int order);
+
+  /** \brief Destructor */
+  ~SXTaylor() override;
+
+  /** \brief Get type name */
+  std::string class_name() const override {return "SXTaylor";}
+
+  /// @{
+  /** \brief Sparsities of function inputs and outputs */
+  Sparsity get_sparsity_in(casadi_int i) override;
+  Sparsity get_sparsity_out(casadi_int i) override;
+  /// @}
+
+  /** \brief Get default input value */
+  double get_default_in(casadi_int ind) const override;
+
+  ///@{
+  /** \brief Number of function inputs and outputs */
+  size_t get_n_in() override { return f_.n_in();}
+  size_t get_n_out() override { return f_.n_out();}
+  ///@}
+
+  ///@{
+  /** \brief Names of function input and outputs */
+  std::string get_name_in(casadi_int i) override { return f_.name_in(i);}
+  std::string get_name_out(casadi_int i) override { return f_.name_out(i);}
+  ///@}
+
+  /** \brief  Initialize */
+  void init(const Dict& opts) override;
+
+  /** \brief  Evaluate numerically */
+  int eval(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const override;
+
+protected:
+  // Propagated function
+  Function f_;
+
+  // Polynomial degree
+  casadi_int order_;
+};
+
+} // namespace casadi
+
+/// \endcond
+#endif // CASADI_SX_TAYLOR_HPP
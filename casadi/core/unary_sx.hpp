@@ -28,6 +28,7 @@
 
 #include "sx_node.hpp"
 #include "serializing_stream.hpp"
+#include "global_options.hpp"
 
 /// \cond INTERNAL
 
@@ -45,7 +46,7 @@ class UnarySX : public SXNode {
     /** \brief  Constructor is private, use "create" below
 
         \identifier{du} */
-    UnarySX(unsigned char op, const SXElem& dep) : op_(op), dep_(dep) {}
+    UnarySX(unsigned char op, const SXElem& dep) : op_(op), cached_(false), dep_(dep) {}
 
   public:
 
@@ -59,6 +60,16 @@ class UnarySX : public SXNode {
         double ret_val;
         casadi_math<double>::fun(op, dep_val, dep_val, ret_val);
         return ret_val;
+      } else if (GlobalOptions::hash_consing) {
+        // Reuse a structurally identical node, if any
+        SXNodeKey key = {op, dep.get(), nullptr};
+        auto it = cached_nodes_.find(key);
+        if (it!=cached_nodes_.end()) return SXElem::create(it->second);
+        // Allocate and add to table
+        UnarySX* n = new UnarySX(op, dep);
+        n->cached_ = true;
+        cached_nodes_.insert(std::make_pair(key, n));
+        return SXElem::create(n);
       } else {
         // Expression containing free variables
         return SXElem::create(new UnarySX(op, dep));
@@ -69,12 +80,21 @@ class UnarySX : public SXNode {
 
         \identifier{dw} */
     ~UnarySX() override {
+      uncache();
       safe_delete(dep_.assignNoDelete(casadi_limits<SXElem>::nan));
     }
 
     // Class name
     std::string class_name() const override {return "UnarySX";}
 
+    void uncache() override {
+      if (cached_) {
+        size_t num_erased = cached_nodes_.erase(SXNodeKey{op_, dep_.get(), nullptr});
+        casadi_assert_dev(num_erased==1);
+        cached_ = false;
+      }
+    }
+
     bool is_smooth() const override { return operation_checker<SmoothChecker>(op_);}
 
     bool is_op(casadi_int op) const override { return op_==op; }
@@ -115,6 +135,9 @@ class UnarySX : public SXNode {
         \identifier{e2} */
     unsigned char op_;
 
+    /// Is the node in the hash-consing table
+    bool cached_;
+
     /** \brief  The dependencies of the node
 
         \identifier{e3} */
@@ -129,6 +152,13 @@ class UnarySX : public SXNode {
       s.unpack("UnarySX::dep", dep);
       return new UnarySX(op, dep);
     }
+
+  protected:
+    /** \brief Hash-consing table of unary nodes currently allocated
+
+     * (storage is allocated for it in sx_elem.cpp)
+     */
+    static SXNodeTable<UnarySX> cached_nodes_;
 };
 
 } // namespace casadi
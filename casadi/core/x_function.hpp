@@ -1151,6 +1151,7 @@ namespace casadi {
 
     // Create an expression factory
     Factory<MatType> f;
+    extract_from_dict_inplace(f_options, "hvp_ndir", f.hvp_ndir_);
     for (casadi_int i=0; i<in_.size(); ++i) f.add_input(name_in_[i], in_[i], is_diff_in_[i]);
     for (casadi_int i=0; i<out_.size(); ++i) f.add_output(name_out_[i], out_[i], is_diff_out_[i]);
     f.add_dual(aux);
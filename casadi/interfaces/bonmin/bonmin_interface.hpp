@@ -137,6 +137,11 @@ namespace casadi {
     /// Get all statistics
     Dict get_stats(void* mem) const override;
 
+    /// Iteration count of the last solve
+    casadi_int get_iter_count(void* mem) const override {
+      return static_cast<BonminMemory*>(mem)->iter_count;
+    }
+
     /** \brief Set the (persistent) work vectors */
     void set_work(void* mem, const double**& arg, double**& res,
                           casadi_int*& iw, double*& w) const override;
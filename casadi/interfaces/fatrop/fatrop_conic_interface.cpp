@@ -23,6 +23,7 @@
  */
 
 #include "fatrop_conic_interface.hpp"
+#include "casadi/core/nlp_tools.hpp"
 #include <numeric>
 #include <cstring>
 
@@ -109,6 +110,16 @@ namespace casadi {
     Sparsity lamg_csp_, lam_ulsp_, lam_uusp_, lam_xlsp_, lam_xusp_, lam_clsp_;
 
     if (detect_structure) {
+      // Bring the variables and constraints in stage-wise order, if needed
+      std::vector<casadi_int> perm_x, perm_a, nx_detect, nu_detect, ng_detect;
+      if (detect_ocp_structure(A_, H_, perm_x, perm_a, nx_detect, nu_detect, ng_detect)
+          && (perm_x!=range(nx_) || perm_a!=range(na_))) {
+        if (verbose_) {
+          casadi_message("Permuting variables and constraints into stage-wise order.");
+        }
+        permute(perm_x, perm_a);
+      }
+
       /* General strategy: look for the xk+1 diagonal part in A
       */
 
@@ -53,6 +53,8 @@ In order to use this interface, you must:
 
    where I must be a diagonal sparse matrix
  - Either supply all of N, nx, ng, nu options or rely on automatic detection
+   Automatic detection permutes the variables and constraints into this form
+   if they are not already ordered stage-wise (see detect_ocp_structure)
 
     \identifier{27g} */
 
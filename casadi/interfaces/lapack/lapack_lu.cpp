@@ -58,7 +58,7 @@ namespace casadi {
   }
 
   const Options LapackLu::options_
-  = {{&FunctionInternal::options_},
+  = {{&LinsolInternal::options_},
      {{"equilibration",
        {OT_BOOL,
         "Equilibrate the matrix"}},
@@ -89,6 +89,7 @@ namespace casadi {
     // Allocate matrix
     m->mat.resize(nrow() * ncol());
     m->ipiv.resize(ncol());
+    if (mixed_precision_) m->matf.resize(nrow() * ncol());
 
     // Equilibration
     if (equilibriate_) {
@@ -137,6 +138,15 @@ namespace casadi {
 
     // Factorize the matrix
     int info = -100;
+    if (mixed_precision_) {
+      std::copy(m->mat.begin(), m->mat.end(), m->matf.begin());
+      sgetrf_(&ncol, &ncol, get_ptr(m->matf), &ncol, get_ptr(m->ipiv), &info);
+      if (info) {
+        if (verbose_) casadi_warning("sgetrf_ failed: Info: " + str(info));
+        return 1;
+      }
+      return 0;
+    }
     dgetrf_(&ncol, &ncol, get_ptr(m->mat), &ncol, get_ptr(m->ipiv), &info);
     if (info) {
       if (verbose_) casadi_warning("dgetrf_ failed: Info: " + str(info));
@@ -145,6 +155,17 @@ namespace casadi {
     return 0;
   }
 
+  template<typename T1>
+  void LapackLu::scale(LapackLuMemory* m, T1* x, casadi_int nrhs, bool tr, bool rhs) const {
+    // Row scaling applies to the right-hand-side of A*x=b and the solution of A'*x=b
+    bool col = tr == rhs;
+    if (m->equed!='B' && m->equed!=(col ? 'C' : 'R')) return;
+    const std::vector<double>& s = col ? m->c : m->r;
+    for (casadi_int k=0; k<nrhs; ++k)
+      for (casadi_int i=0; i<nrow(); ++i)
+        x[i+k*nrow()] *= s[i];
+  }
+
   int LapackLu::solve(void* mem, const double* A, double* x, casadi_int nrhs, bool tr) const {
     auto m = static_cast<LapackLuMemory*>(mem);
 
@@ -153,50 +174,47 @@ namespace casadi {
     int ncol = this->ncol();
 
     int n_rhs = nrhs;
+    int info = 100;
+    char trans = tr ? 'T' : 'N';
 
-    // Scale the right hand side
-    if (tr) {
-      if (m->equed=='C' || m->equed=='B')
-        for (casadi_int rhs=0; rhs<nrhs; ++rhs)
-          for (casadi_int i=0; i<nrow; ++i)
-            x[i+rhs*nrow] *= m->c[i];
-    } else {
-      if (m->equed=='R' || m->equed=='B')
-        for (casadi_int rhs=0; rhs<nrhs; ++rhs)
-          for (casadi_int i=0; i<ncol; ++i)
-            x[i+rhs*nrow] *= m->r[i];
+    if (mixed_precision_) {
+      // Single precision factorization with iterative refinement
+      int one = 1;
+      return refine(mem, A, x, nrhs, tr, [&](float* xf) {
+        scale(m, xf, 1, tr, true);
+        sgetrs_(&trans, &ncol, &one, get_ptr(m->matf), &ncol, get_ptr(m->ipiv), xf, &ncol,
+                &info);
+        scale(m, xf, 1, tr, false);
+        return info;
+      });
     }
 
+    // Scale the right hand side
+    scale(m, x, nrhs, tr, true);
+
     // Solve the system of equations
-    int info = 100;
-    char trans = tr ? 'T' : 'N';
     dgetrs_(&trans, &ncol, &n_rhs, get_ptr(m->mat), &ncol, get_ptr(m->ipiv), x, &ncol, &info);
     if (info) return 1;
 
     // Scale the solution
-    if (tr) {
-      if (m->equed=='R' || m->equed=='B')
-        for (casadi_int rhs=0; rhs<nrhs; ++rhs)
-          for (casadi_int i=0; i<ncol; ++i)
-            x[i+rhs*nrow] *= m->r[i];
-    } else {
-      if (m->equed=='C' || m->equed=='B')
-        for (casadi_int rhs=0; rhs<nrhs; ++rhs)
-          for (casadi_int i=0; i<nrow; ++i)
-            x[i+rhs*nrow] *= m->c[i];
-    }
+    scale(m, x, nrhs, tr, false);
     return 0;
   }
 
   LapackLu::LapackLu(DeserializingStream& s) : LinsolInternal(s) {
-    s.version("LapackLu", 1);
+    int version = s.version("LapackLu", 1, 3);
     s.unpack("LapackLu::equilibriate", equilibriate_);
     s.unpack("LapackLu::allow_equilibration_failure", allow_equilibration_failure_);
+    if (version == 2) {
+      s.unpack("LapackLu::mixed_precision", mixed_precision_);
+      s.unpack("LapackLu::refine_max_iter", refine_max_iter_);
+      s.unpack("LapackLu::refine_tol", refine_tol_);
+    }
   }
 
   void LapackLu::serialize_body(SerializingStream &s) const {
     LinsolInternal::serialize_body(s);
-    s.version("LapackLu", 1);
+    s.version("LapackLu", 3);
     s.pack("LapackLu::equilibriate", equilibriate_);
     s.pack("LapackLu::allow_equilibration_failure", allow_equilibration_failure_);
   }
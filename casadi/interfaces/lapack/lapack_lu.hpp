@@ -37,6 +37,13 @@ extern "C" {
   void dgetrs_(char* trans, int *n, int *nrhs, double *a,
                int *lda, int *ipiv, double *b, int *ldb, int *info);
 
+  /// LU-Factorize dense matrix, single precision (lapack)
+  void sgetrf_(int *m, int *n, float *a, int *lda, int *ipiv, int *info);
+
+  /// Solve using an LU-factorized matrix, single precision (lapack)
+  void sgetrs_(char* trans, int *n, int *nrhs, float *a,
+               int *lda, int *ipiv, float *b, int *ldb, int *info);
+
   /// Calculate col and row scaling
   void dgeequ_(int *m, int *n, double *a, int *lda, double *r, double *c,
                double *colcnd, double *rowcnd, double *amax, int *info);
@@ -63,6 +70,9 @@ namespace casadi {
     // Matrix
     std::vector<double> mat;
 
+    // Matrix factorized in single precision
+    std::vector<float> matf;
+
     /// Pivoting elements
     std::vector<int> ipiv;
 
@@ -116,6 +126,9 @@ namespace casadi {
     // Solve the linear system
     int solve(void* mem, const double* A, double* x, casadi_int nrhs, bool tr) const override;
 
+    /// Can the plugin factorize in single precision?
+    bool has_mixed_precision() const override { return true;}
+
     /// A documentation string
     static const std::string meta_doc;
 
@@ -129,6 +142,10 @@ namespace casadi {
     /** \brief Deserializing constructor */
     explicit LapackLu(DeserializingStream& s);
 
+    // Apply the equilibration to a right-hand-side or a solution
+    template<typename T1>
+    void scale(LapackLuMemory* m, T1* x, casadi_int nrhs, bool tr, bool rhs) const;
+
     /// Equilibrate?
     bool equilibriate_;
 
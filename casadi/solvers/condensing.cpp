@@ -0,0 +1,459 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+#include "condensing.hpp"
+#include "casadi/core/nlp_tools.hpp"
+
+namespace casadi {
+
+  extern "C"
+  int CASADI_CONIC_CONDENSING_EXPORT
+  casadi_register_conic_condensing(Conic::Plugin* plugin) {
+    plugin->creator = Condensing::creator;
+    plugin->name = "condensing";
+    plugin->doc = Condensing::meta_doc.c_str();
+    plugin->version = CASADI_VERSION;
+    plugin->options = &Condensing::options_;
+    plugin->deserialize = &Condensing::deserialize;
+    return 0;
+  }
+
+  extern "C"
+  void CASADI_CONIC_CONDENSING_EXPORT casadi_load_conic_condensing() {
+    Conic::registerPlugin(casadi_register_conic_condensing);
+  }
+
+  Condensing::Condensing(const std::string& name, const std::map<std::string, Sparsity> &st)
+    : Conic(name, st) {
+  }
+
+  Condensing::~Condensing() {
+    clear_mem();
+  }
+
+  void* Condensing::alloc_mem() const {
+    CondensingMemory *m = new CondensingMemory();
+    m->qp_mem = qpsol_.checkout();
+    m->h.resize(H_.nnz());
+    m->a.resize(A_.nnz());
+    m->M.resize(mat_fcn_.nnz_out(0));
+    m->hc.resize(mat_fcn_.nnz_out(1));
+    m->ac.resize(mat_fcn_.nnz_out(2));
+    return m;
+  }
+
+  void Condensing::free_mem(void *mem) const {
+    auto m = static_cast<CondensingMemory*>(mem);
+    qpsol_.release(m->qp_mem);
+    delete m;
+  }
+
+  const Options Condensing::options_
+  = {{&Conic::options_},
+     {{"qpsol",
+       {OT_STRING,
+        "Name of the solver for the condensed QP."}},
+      {"qpsol_options",
+       {OT_DICT,
+        "Options to be passed to the solver for the condensed QP."}},
+      {"block_size",
+       {OT_INT,
+        "Number of stages condensed into one block. "
+        "Default 0 means full condensing into a single block."}}
+     }
+  };
+
+  void Condensing::init(const Dict& opts) {
+    // Initialize the base classes
+    Conic::init(opts);
+
+    // Default options
+    std::string qpsol_plugin;
+    Dict qpsol_options;
+    block_size_ = 0;
+
+    // Read user options
+    for (auto&& op : opts) {
+      if (op.first=="qpsol") {
+        qpsol_plugin = op.second.to_string();
+      } else if (op.first=="qpsol_options") {
+        qpsol_options = op.second;
+      } else if (op.first=="block_size") {
+        block_size_ = op.second;
+      }
+    }
+    casadi_assert(!qpsol_plugin.empty(), "'qpsol' option has not been set");
+    casadi_assert(block_size_>=0, "Option 'block_size' must be non-negative");
+    casadi_assert(np_==0, "Condensing does not support psd constraints");
+
+    // Detect the stages, and work with the variables and constraints in stage-wise order
+    std::vector<casadi_int> perm_x, perm_a, nxs, nus, ngs;
+    if (detect_ocp_structure(A_, H_, perm_x, perm_a, nxs, nus, ngs)) {
+      if (perm_x!=range(nx_) || perm_a!=range(na_)) permute(perm_x, perm_a);
+    } else {
+      nxs = {nx_};
+      nus = {0};
+      ngs = {na_};
+    }
+    casadi_int N = nxs.size();
+    casadi_int bs = block_size_==0 ? N : block_size_;
+    if (verbose_) {
+      casadi_message("Detected " + str(N) + " stages, condensing blocks of " + str(bs));
+    }
+
+    // Offsets of the variables and constraints of each stage
+    std::vector<casadi_int> xoff(N+1, 0), aoff(N+1, 0);
+    for (casadi_int k=0; k<N; ++k) {
+      xoff[k+1] = xoff[k] + nxs[k] + nus[k];
+      aoff[k+1] = aoff[k] + (k+1<N ? nxs[k+1] : 0) + ngs[k];
+    }
+
+    // States within a block are eliminated using their gap-closing constraints
+    std::vector<bool> is_kept(nx_, true);
+    std::vector<casadi_int> elim;
+    gap_.clear();
+    for (casadi_int k=1; k<N; ++k) {
+      if (k % bs == 0) continue;
+      for (casadi_int i=0; i<nxs[k]; ++i) {
+        is_kept[xoff[k]+i] = false;
+        elim.push_back(xoff[k]+i);
+        gap_.push_back(aoff[k-1]+i);
+      }
+    }
+    kept_.clear();
+    for (casadi_int c=0; c<nx_; ++c) {
+      if (is_kept[c]) kept_.push_back(c);
+    }
+
+    // Constraints of the condensed QP, block by block: gap-closing constraints
+    // to the next block, then path constraints and bounds of the eliminated states
+    crow_.clear();
+    for (casadi_int s=0; s<N; s+=bs) {
+      casadi_int e = std::min(s+bs, N);
+      if (e<N) {
+        for (casadi_int i=0; i<nxs[e]; ++i) crow_.push_back(aoff[e-1]+i);
+      }
+      for (casadi_int k=s; k<e; ++k) {
+        casadi_int np = k+1<N ? nxs[k+1] : 0;
+        for (casadi_int i=0; i<ngs[k]; ++i) crow_.push_back(aoff[k]+np+i);
+        if (k+1<e) {
+          for (casadi_int i=0; i<nxs[k+1]; ++i) crow_.push_back(na_+xoff[k+1]+i);
+        }
+      }
+    }
+
+    // Symbolic problem data
+    SX h = SX::sym("h", H_), g = SX::sym("g", nx_), a = SX::sym("a", A_);
+    SX lba = SX::sym("lba", na_), uba = SX::sym("uba", na_);
+    SX lbx = SX::sym("lbx", nx_), ubx = SX::sym("ubx", nx_);
+    SX y = SX::sym("y", kept_.size());
+
+    // Access to the rows of A
+    std::vector<casadi_int> mapping;
+    Sparsity AT = A_.transpose(mapping);
+    const casadi_int *AT_colind = AT.colind(), *AT_row = AT.row();
+    const std::vector<SXElem>& a_nz = a.nonzeros();
+
+    // Forward sweep: the variables as an affine function of the kept variables
+    std::vector<SXElem> xv(nx_);
+    std::vector<bool> defined = is_kept;
+    for (casadi_int i=0; i<kept_.size(); ++i) xv[kept_[i]] = y.nonzeros()[i];
+    for (casadi_int i=0; i<gap_.size(); ++i) {
+      casadi_int r = gap_[i], p = elim[i];
+      SXElem rhs = lba.nonzeros()[r], piv = 0;
+      for (casadi_int k=AT_colind[r]; k<AT_colind[r+1]; ++k) {
+        casadi_int c = AT_row[k];
+        if (c==p) {
+          piv = a_nz[mapping[k]];
+        } else {
+          casadi_assert(defined[c], "Gap-closing constraint " + str(r)
+            + " depends on a state that has not been eliminated yet");
+          rhs -= a_nz[mapping[k]] * xv[c];
+        }
+      }
+      xv[p] = rhs / piv;
+      defined[p] = true;
+    }
+    SX x = SX(xv);
+    SX M = SX::densify(SX::jacobian(x, y));
+    SX m = substitute(x, y, SX::zeros(y.sparsity()));
+
+    // Condensed matrices
+    SX hc = triu2symm(triu(mtimes(M.T(), mtimes(h, M))));
+    SX ac = vertcat(mtimes(a, M), M)(crow_, Slice());
+    mat_fcn_ = Function(name_ + "_condense", {h, a}, {M, hc, ac},
+                        {"h", "a"}, {"M", "hc", "ac"});
+
+    // Condensed vectors, given the matrix M
+    SX Ms = SX::sym("M", M.sparsity());
+    SX gc = mtimes(Ms.T(), mtimes(h, m) + g);
+    SX off = vertcat(mtimes(a, m), m)(crow_, Slice());
+    SX lbc = vertcat(lba, lbx)(crow_, Slice()) - off;
+    SX ubc = vertcat(uba, ubx)(crow_, Slice()) - off;
+    vec_fcn_ = Function(name_ + "_condense_vec",
+                        {Ms, h, g, a, lba, uba, lbx, ubx},
+                        {gc, lbc, ubc, lbx(kept_), ubx(kept_), m},
+                        {"M", "h", "g", "a", "lba", "uba", "lbx", "ubx"},
+                        {"gc", "lbc", "ubc", "lby", "uby", "m"});
+
+    // Expansion of the solution
+    SX ms = SX::sym("m", nx_);
+    SX lam_y = SX::sym("lam_y", kept_.size());
+    SX lam_c = SX::sym("lam_c", crow_.size());
+    SX xs = mtimes(Ms, y) + ms;
+    SX cost = dot(xs, mtimes(h, xs))/2 + dot(g, xs);
+    std::vector<SXElem> lam_x(nx_, 0), lam_a(na_, 0);
+    for (casadi_int i=0; i<kept_.size(); ++i) lam_x[kept_[i]] = lam_y.nonzeros()[i];
+    for (casadi_int i=0; i<crow_.size(); ++i) {
+      if (crow_[i]<na_) {
+        lam_a[crow_[i]] = lam_c.nonzeros()[i];
+      } else {
+        lam_x[crow_[i]-na_] = lam_c.nonzeros()[i];
+      }
+    }
+
+    // Backward sweep: multipliers of the eliminated constraints from stationarity,
+    // H x + g + A' lam_a + lam_x = 0
+    SX grad = SX::densify(mtimes(h, xs) + g + mtimes(a.T(), SX(lam_a)) + SX(lam_x));
+    std::vector<SXElem> rv = grad.nonzeros();
+    for (casadi_int i=gap_.size(); i-->0; ) {
+      casadi_int r = gap_[i], p = elim[i];
+      for (casadi_int k=AT_colind[r]; k<AT_colind[r+1]; ++k) {
+        if (AT_row[k]==p) lam_a[r] = -rv[p] / a_nz[mapping[k]];
+      }
+      for (casadi_int k=AT_colind[r]; k<AT_colind[r+1]; ++k) {
+        rv[AT_row[k]] += a_nz[mapping[k]] * lam_a[r];
+      }
+    }
+    exp_fcn_ = Function(name_ + "_expand",
+                        {Ms, ms, h, g, a, y, lam_y, lam_c},
+                        {xs, cost, SX(lam_a), SX(lam_x)},
+                        {"M", "m", "h", "g", "a", "y", "lam_y", "lam_c"},
+                        {"x", "cost", "lam_a", "lam_x"});
+
+    // Solver for the condensed QP
+    qpsol_ = conic("qpsol", qpsol_plugin, {{"h", hc.sparsity()}, {"a", ac.sparsity()}},
+                   qpsol_options);
+    if (verbose_) {
+      casadi_message("Condensed QP: " + str(kept_.size()) + " variables, "
+                     + str(crow_.size()) + " constraints");
+    }
+
+    // Allocate work vectors
+    alloc(mat_fcn_);
+    alloc(vec_fcn_);
+    alloc(exp_fcn_);
+    alloc(qpsol_);
+    alloc_w(nx_ + 7*kept_.size() + 4*crow_.size(), true);
+  }
+
+  bool Condensing::is_condensed(const double* h, const double* a, CondensingMemory* m) const {
+    auto unchanged = [](const double* v, const std::vector<double>& v0) {
+      if (v) return std::equal(v0.begin(), v0.end(), v);
+      return std::all_of(v0.begin(), v0.end(), [](double e) { return e==0;});
+    };
+    return m->n_condense>0 && unchanged(h, m->h) && unchanged(a, m->a);
+  }
+
+  int Condensing::condense(const double** arg, double** res, casadi_int* iw, double* w,
+      CondensingMemory* m) const {
+    const double *h = arg[CONIC_H], *a = arg[CONIC_A];
+    const double** arg1 = arg + n_in_;
+    double** res1 = res + n_out_;
+    arg1[0] = h;
+    arg1[1] = a;
+    res1[0] = get_ptr(m->M);
+    res1[1] = get_ptr(m->hc);
+    res1[2] = get_ptr(m->ac);
+    if (mat_fcn_(arg1, res1, iw, w)) return 1;
+    if (h) {
+      std::copy_n(h, m->h.size(), m->h.begin());
+    } else {
+      std::fill(m->h.begin(), m->h.end(), 0);
+    }
+    if (a) {
+      std::copy_n(a, m->a.size(), m->a.begin());
+    } else {
+      std::fill(m->a.begin(), m->a.end(), 0);
+    }
+    m->n_condense++;
+    return 0;
+  }
+
+  int Condensing::prepare_matrices(const double** arg, double** res,
+      casadi_int* iw, double* w, void* mem) const {
+    auto m = static_cast<CondensingMemory*>(mem);
+    if (is_condensed(arg[CONIC_H], arg[CONIC_A], m)) return 0;
+    return condense(arg, res, iw, w, m);
+  }
+
+  int Condensing::
+  solve(const double** arg, double** res, casadi_int* iw, double* w, void* mem) const {
+    auto m = static_cast<CondensingMemory*>(mem);
+    casadi_int ny = kept_.size(), nc = crow_.size();
+
+    // Get input pointers
+    const double *h = arg[CONIC_H], *a = arg[CONIC_A];
+    const double *lba = arg[CONIC_LBA], *uba = arg[CONIC_UBA];
+    const double *x0 = arg[CONIC_X0], *lam_x0 = arg[CONIC_LAM_X0], *lam_a0 = arg[CONIC_LAM_A0];
+
+    // The eliminated constraints must be equality constraints
+    for (casadi_int r : gap_) {
+      casadi_assert((lba ? lba[r] : 0)==(uba ? uba[r] : 0),
+        "Gap-closing constraint " + str(perm_a_.empty() ? r : perm_a_[r])
+        + " must be an equality constraint");
+    }
+
+    // Work vectors
+    double *mv = w; w += nx_;
+    double *gc = w; w += ny;
+    double *lbc = w; w += nc;
+    double *ubc = w; w += nc;
+    double *lby = w; w += ny;
+    double *uby = w; w += ny;
+    double *y0 = w; w += ny;
+    double *lam_y0 = w; w += ny;
+    double *lam_c0 = w; w += nc;
+    double *y = w; w += ny;
+    double *lam_y = w; w += ny;
+    double *lam_c = w; w += nc;
+
+    // Buffers for calling the functions
+    const double** arg1 = arg + n_in_;
+    double** res1 = res + n_out_;
+
+    // Condensed matrices, reused as long as H and A are unchanged
+    if (is_condensed(h, a, m)) {
+      m->n_reuse++;
+    } else {
+      if (condense(arg, res, iw, w, m)) return 1;
+    }
+
+    // Condensed vectors
+    arg1[0] = get_ptr(m->M);
+    arg1[1] = h;
+    arg1[2] = arg[CONIC_G];
+    arg1[3] = a;
+    arg1[4] = lba;
+    arg1[5] = uba;
+    arg1[6] = arg[CONIC_LBX];
+    arg1[7] = arg[CONIC_UBX];
+    res1[0] = gc;
+    res1[1] = lbc;
+    res1[2] = ubc;
+    res1[3] = lby;
+    res1[4] = uby;
+    res1[5] = mv;
+    if (vec_fcn_(arg1, res1, iw, w)) return 1;
+
+    // Initial guess
+    for (casadi_int i=0; i<ny; ++i) {
+      y0[i] = x0 ? x0[kept_[i]] : 0;
+      lam_y0[i] = lam_x0 ? lam_x0[kept_[i]] : 0;
+    }
+    for (casadi_int i=0; i<nc; ++i) {
+      if (crow_[i]<na_) {
+        lam_c0[i] = lam_a0 ? lam_a0[crow_[i]] : 0;
+      } else {
+        lam_c0[i] = lam_x0 ? lam_x0[crow_[i]-na_] : 0;
+      }
+    }
+
+    // Solve the condensed QP
+    std::fill_n(arg1, static_cast<casadi_int>(CONIC_NUM_IN), nullptr);
+    std::fill_n(res1, static_cast<casadi_int>(CONIC_NUM_OUT), nullptr);
+    arg1[CONIC_H] = get_ptr(m->hc);
+    arg1[CONIC_G] = gc;
+    arg1[CONIC_A] = get_ptr(m->ac);
+    arg1[CONIC_LBA] = lbc;
+    arg1[CONIC_UBA] = ubc;
+    arg1[CONIC_LBX] = lby;
+    arg1[CONIC_UBX] = uby;
+    arg1[CONIC_X0] = y0;
+    arg1[CONIC_LAM_X0] = lam_y0;
+    arg1[CONIC_LAM_A0] = lam_c0;
+    res1[CONIC_X] = y;
+    res1[CONIC_LAM_X] = lam_y;
+    res1[CONIC_LAM_A] = lam_c;
+    int ret = qpsol_(arg1, res1, iw, w, m->qp_mem);
+    auto qp_m = static_cast<ConicMemory*>(qpsol_.memory(m->qp_mem));
+    m->d_qp.success = qp_m->d_qp.success;
+    m->d_qp.unified_return_status = qp_m->d_qp.unified_return_status;
+    m->d_qp.iter_count = qp_m->d_qp.iter_count;
+
+    // Expand the solution
+    arg1[0] = get_ptr(m->M);
+    arg1[1] = mv;
+    arg1[2] = h;
+    arg1[3] = arg[CONIC_G];
+    arg1[4] = a;
+    arg1[5] = y;
+    arg1[6] = lam_y;
+    arg1[7] = lam_c;
+    res1[0] = res[CONIC_X];
+    res1[1] = res[CONIC_COST];
+    res1[2] = res[CONIC_LAM_A];
+    res1[3] = res[CONIC_LAM_X];
+    if (exp_fcn_(arg1, res1, iw, w)) return 1;
+    return ret;
+  }
+
+  Dict Condensing::get_stats(void* mem) const {
+    Dict stats = Conic::get_stats(mem);
+    auto m = static_cast<CondensingMemory*>(mem);
+    stats["solver_stats"] = qpsol_.stats(m->qp_mem);
+    stats["n_condense"] = m->n_condense;
+    stats["n_reuse"] = m->n_reuse;
+    return stats;
+  }
+
+  Condensing::Condensing(DeserializingStream& s) : Conic(s) {
+    s.version("Condensing", 1);
+    s.unpack("Condensing::qpsol", qpsol_);
+    s.unpack("Condensing::mat_fcn", mat_fcn_);
+    s.unpack("Condensing::vec_fcn", vec_fcn_);
+    s.unpack("Condensing::exp_fcn", exp_fcn_);
+    s.unpack("Condensing::block_size", block_size_);
+    s.unpack("Condensing::kept", kept_);
+    s.unpack("Condensing::gap", gap_);
+    s.unpack("Condensing::crow", crow_);
+  }
+
+  void Condensing::serialize_body(SerializingStream &s) const {
+    Conic::serialize_body(s);
+
+    s.version("Condensing", 1);
+    s.pack("Condensing::qpsol", qpsol_);
+    s.pack("Condensing::mat_fcn", mat_fcn_);
+    s.pack("Condensing::vec_fcn", vec_fcn_);
+    s.pack("Condensing::exp_fcn", exp_fcn_);
+    s.pack("Condensing::block_size", block_size_);
+    s.pack("Condensing::kept", kept_);
+    s.pack("Condensing::gap", gap_);
+    s.pack("Condensing::crow", crow_);
+  }
+
+} // namespace casadi
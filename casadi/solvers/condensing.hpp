@@ -0,0 +1,184 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+#ifndef CASADI_CONDENSING_HPP
+#define CASADI_CONDENSING_HPP
+
+#include "casadi/core/conic_impl.hpp"
+#include <casadi/solvers/casadi_conic_condensing_export.h>
+
+
+/** \defgroup plugin_Conic_condensing Title
+    \par
+
+   Eliminate the states of an optimal control structured QP and solve the
+   condensed QP with another Conic.
+
+   The stage structure is detected from the sparsity of H and A, see detect_ocp_structure.
+   The gap-closing constraints are used to express the states as an affine function of
+   the kept variables: the initial state, the controls and the states at the start of
+   each block of 'block_size' stages. The remaining states are eliminated and their bounds
+   become general constraints of the condensed QP.
+
+   With the default block_size of 0, all states but the initial one are eliminated
+   (full condensing) and the condensed QP is dense. A positive block_size gives a
+   smaller QP with the same stage structure (partial condensing), suitable for
+   structure-exploiting solvers such as hpipm.
+
+   The condensed matrices are cached in the memory object and only recomputed
+   when H or A change, e.g. not in linear MPC. In real-time iterations, where H and A
+   change every time, the condensing of the matrices is done in the preparation phase.
+
+   The condensing is formed at construction with dense SX expressions, so the
+   construction time grows quickly with the horizon length, also for partial
+   condensing: several seconds for 80 stages with 8 states and one control.
+
+   The gap-closing constraints must be equality constraints.
+*/
+
+/** \pluginsection{Conic,condensing} */
+
+/// \cond INTERNAL
+namespace casadi {
+
+  struct CASADI_CONIC_CONDENSING_EXPORT CondensingMemory : public ConicMemory {
+    // Memory of the condensed QP solver
+    casadi_int qp_mem;
+
+    // Data of the last condensation
+    std::vector<double> h, a;
+
+    // Condensed matrices
+    std::vector<double> M, hc, ac;
+
+    // Number of condensations performed and reused
+    casadi_int n_condense, n_reuse;
+
+    /// Constructor
+    CondensingMemory() : n_condense(0), n_reuse(0) {}
+
+    /// Destructor
+    ~CondensingMemory() {}
+  };
+
+  /** \brief \pluginbrief{Conic,condensing}
+
+      @copydoc Conic_doc
+      @copydoc plugin_Conic_condensing
+  */
+  class CASADI_CONIC_CONDENSING_EXPORT Condensing : public Conic {
+  public:
+    /** \brief  Create a new Solver */
+    explicit Condensing(const std::string& name,
+                        const std::map<std::string, Sparsity> &st);
+
+    /** \brief  Create a new QP Solver */
+    static Conic* creator(const std::string& name,
+                          const std::map<std::string, Sparsity>& st) {
+      return new Condensing(name, st);
+    }
+
+    /** \brief  Destructor */
+    ~Condensing() override;
+
+    // Get name of the plugin
+    const char* plugin_name() const override { return "condensing";}
+
+    // Get name of the class
+    std::string class_name() const override { return "Condensing";}
+
+    /** \brief Create memory block */
+    void* alloc_mem() const override;
+
+    /** \brief Free memory block */
+    void free_mem(void *mem) const override;
+
+    ///@{
+    /** \brief Options */
+    static const Options options_;
+    const Options& get_options() const override { return options_;}
+    ///@}
+
+    /// Get all statistics
+    Dict get_stats(void* mem) const override;
+
+    /** \brief  Initialize */
+    void init(const Dict& opts) override;
+
+    int solve(const double** arg, double** res,
+      casadi_int* iw, double* w, void* mem) const override;
+
+    /// Condense the matrices ahead of the solve
+    int prepare_matrices(const double** arg, double** res,
+      casadi_int* iw, double* w, void* mem) const override;
+
+    /// Are the condensed matrices in the memory up to date for H and A
+    bool is_condensed(const double* h, const double* a, CondensingMemory* m) const;
+
+    /// Compute the condensed matrices for H and A
+    int condense(const double** arg, double** res, casadi_int* iw, double* w,
+      CondensingMemory* m) const;
+
+    /// A documentation string
+    static const std::string meta_doc;
+
+    /// Solver for the condensed QP
+    Function qpsol_;
+
+    /// Condensed matrices: (h, a) -> (M, hc, ac)
+    Function mat_fcn_;
+
+    /// Condensed vectors: (M, h, g, a, lba, uba, lbx, ubx) -> (gc, lbc, ubc, m)
+    Function vec_fcn_;
+
+    /// Expansion of the solution: (M, m, h, g, a, y, lam_y, lam_c) -> (x, cost, lam_a, lam_x)
+    Function exp_fcn_;
+
+    /// Number of stages per block, 0 for full condensing
+    casadi_int block_size_;
+
+    /// Kept variables
+    std::vector<casadi_int> kept_;
+
+    /// Eliminated gap-closing constraints
+    std::vector<casadi_int> gap_;
+
+    /// Constraints of the condensed QP: constraint i<na or bound of variable i-na
+    std::vector<casadi_int> crow_;
+
+    void serialize_body(SerializingStream &s) const override;
+
+    /** \brief Deserialize with type disambiguation */
+    static ProtoFunction* deserialize(DeserializingStream& s) { return new Condensing(s); }
+
+  protected:
+     /** \brief Deserializing constructor */
+    explicit Condensing(DeserializingStream& s);
+  };
+
+} // namespace casadi
+/// \endcond
+#endif // CASADI_CONDENSING_HPP
@@ -168,6 +168,7 @@ namespace casadi {
   }
 
   void FastNewton::codegen_body(CodeGenerator& g) const {
+    casadi_assert(!tearing_, "Code generation is not supported with tearing.");
     g.add_auxiliary(CodeGenerator::AUX_NEWTON);
 
     g.local("m", "struct casadi_newton_mem");
@@ -992,6 +992,10 @@ int Feasiblesqpmethod::solve(void* mem) const {
 
     casadi_clear(d->dx, nx_);
 
+    // Return flags of concurrent oracle evaluations
+    int jac_flag, hess_flag = 0;
+    bool hess_done = false;
+
     // ------------------------------------------------------------------------
     // MAIN OPTIMIZATION LOOP
     // ------------------------------------------------------------------------
@@ -1017,32 +1021,62 @@ int Feasiblesqpmethod::solve(void* mem) const {
       }*/
       if (m->iter_count == 0) {
         // Evaluate the sensitivities -------------------------------------------
-        // Evaluate f
-        m->arg[0] = d_nlp->z;
-        m->arg[1] = d_nlp->p;
-        m->res[0] = &d_nlp->objective;
-        if (calc_function(m, "nlp_f")) {
-          uout() << "What does it mean that calc_function fails here??" << std::endl;
-        }
-        // Evaluate g
-        m->arg[0] = d_nlp->z;
-        m->arg[1] = d_nlp->p;
-        m->res[0] = d_nlp->z + nx_;
-        if (calc_function(m, "nlp_g")) {
-          uout() << "What does it mean that calc_function fails here??" << std::endl;
-        }
-        // Evaluate grad_f
-        m->arg[0] = d_nlp->z;
-        m->arg[1] = d_nlp->p;
-        m->res[0] = d->gf;
-        if (calc_function(m, "nlp_grad_f")) {
-          uout() << "What does it mean that calc_function fails here??" << std::endl;
+        if (max_num_threads_ > 1) {
+          // Evaluate f, g, grad_f, jac_g and the exact Hessian concurrently
+          std::vector<OracleCall> calls(use_sqp_ && exact_hessian_ ? 5 : 4);
+          calls[0].fcn = "nlp_f";
+          calls[0].res = {&d_nlp->objective};
+          calls[1].fcn = "nlp_g";
+          calls[1].res = {d_nlp->z + nx_};
+          calls[2].fcn = "nlp_grad_f";
+          calls[2].res = {d->gf};
+          calls[3].fcn = "nlp_jac_g";
+          calls[3].res = {d->Jk};
+          if (calls.size() > 4) {
+            calls[4].fcn = "nlp_hess_l";
+            calls[4].arg = {d_nlp->z, d_nlp->p, &one, d_nlp->lam + nx_};
+            calls[4].res = {d->Bk};
+          }
+          for (casadi_int i = 0; i < 4; ++i) calls[i].arg = {d_nlp->z, d_nlp->p};
+          calc_functions(m, calls);
+          for (casadi_int i = 0; i < 3; ++i) {
+            if (calls[i].flag) {
+              uout() << "What does it mean that calc_function fails here??" << std::endl;
+            }
+          }
+          jac_flag = calls[3].flag;
+          hess_flag = calls.size() > 4 ? calls[4].flag : 0;
+          hess_done = calls.size() > 4;
+        } else {
+          // Evaluate f
+          m->arg[0] = d_nlp->z;
+          m->arg[1] = d_nlp->p;
+          m->res[0] = &d_nlp->objective;
+          if (calc_function(m, "nlp_f")) {
+            uout() << "What does it mean that calc_function fails here??" << std::endl;
+          }
+          // Evaluate g
+          m->arg[0] = d_nlp->z;
+          m->arg[1] = d_nlp->p;
+          m->res[0] = d_nlp->z + nx_;
+          if (calc_function(m, "nlp_g")) {
+            uout() << "What does it mean that calc_function fails here??" << std::endl;
+          }
+          // Evaluate grad_f
+          m->arg[0] = d_nlp->z;
+          m->arg[1] = d_nlp->p;
+          m->res[0] = d->gf;
+          if (calc_function(m, "nlp_grad_f")) {
+            uout() << "What does it mean that calc_function fails here??" << std::endl;
+          }
+          // Evaluate jac_g
+          m->arg[0] = d_nlp->z;
+          m->arg[1] = d_nlp->p;
+          m->res[0] = d->Jk;
+          jac_flag = calc_function(m, "nlp_jac_g");
+          hess_done = false;
         }
-        // Evaluate jac_g
-        m->arg[0] = d_nlp->z;
-        m->arg[1] = d_nlp->p;
-        m->res[0] = d->Jk;
-        switch (calc_function(m, "nlp_jac_g")) {
+        switch (jac_flag) {
           case -1:
             m->return_status = "Non_Regular_Sensitivities";
             m->unified_return_status = SOLVER_RET_NAN;
@@ -1063,12 +1097,16 @@ int Feasiblesqpmethod::solve(void* mem) const {
         if (use_sqp_) {
           if (exact_hessian_) {
             // Update/reset exact Hessian
-            m->arg[0] = d_nlp->z;
-            m->arg[1] = d_nlp->p;
-            m->arg[2] = &one;
-            m->arg[3] = d_nlp->lam + nx_;
-            m->res[0] = d->Bk;
-            if (calc_function(m, "nlp_hess_l")) return 1;
+            if (hess_done) {
+              if (hess_flag) return 1;
+            } else {
+              m->arg[0] = d_nlp->z;
+              m->arg[1] = d_nlp->p;
+              m->arg[2] = &one;
+              m->arg[3] = d_nlp->lam + nx_;
+              m->res[0] = d->Bk;
+              if (calc_function(m, "nlp_hess_l")) return 1;
+            }
             if (convexify_) {
               ScopedTiming tic(m->fstats.at("convexify"));
               if (convexify_eval(&convexify_data_.config, d->Bk, d->Bk, m->iw, m->w)) return 1;
@@ -1097,18 +1135,43 @@ int Feasiblesqpmethod::solve(void* mem) const {
         }
 
       } else if (step_accepted == 0) {
-        // Evaluate grad_f
-        m->arg[0] = d_nlp->z;
-        m->arg[1] = d_nlp->p;
-        m->res[0] = d->gf;
-        if (calc_function(m, "nlp_grad_f")) {
-          uout() << "What does it mean that calc_function fails here??" << std::endl;
+        if (max_num_threads_ > 1) {
+          // Evaluate grad_f, jac_g and the exact Hessian concurrently
+          std::vector<OracleCall> calls(use_sqp_ && exact_hessian_ ? 3 : 2);
+          calls[0].fcn = "nlp_grad_f";
+          calls[0].arg = {d_nlp->z, d_nlp->p};
+          calls[0].res = {d->gf};
+          calls[1].fcn = "nlp_jac_g";
+          calls[1].arg = {d_nlp->z, d_nlp->p};
+          calls[1].res = {d->Jk};
+          if (calls.size() > 2) {
+            calls[2].fcn = "nlp_hess_l";
+            calls[2].arg = {d_nlp->z, d_nlp->p, &one, d_nlp->lam + nx_};
+            calls[2].res = {d->Bk};
+          }
+          calc_functions(m, calls);
+          if (calls[0].flag) {
+            uout() << "What does it mean that calc_function fails here??" << std::endl;
+          }
+          jac_flag = calls[1].flag;
+          hess_flag = calls.size() > 2 ? calls[2].flag : 0;
+          hess_done = calls.size() > 2;
+        } else {
+          // Evaluate grad_f
+          m->arg[0] = d_nlp->z;
+          m->arg[1] = d_nlp->p;
+          m->res[0] = d->gf;
+          if (calc_function(m, "nlp_grad_f")) {
+            uout() << "What does it mean that calc_function fails here??" << std::endl;
+          }
+          // Evaluate jac_g
+          m->arg[0] = d_nlp->z;
+          m->arg[1] = d_nlp->p;
+          m->res[0] = d->Jk;
+          jac_flag = calc_function(m, "nlp_jac_g");
+          hess_done = false;
         }
-        // Evaluate jac_g
-        m->arg[0] = d_nlp->z;
-        m->arg[1] = d_nlp->p;
-        m->res[0] = d->Jk;
-        switch (calc_function(m, "nlp_jac_g")) {
+        switch (jac_flag) {
           case -1:
             m->return_status = "Non_Regular_Sensitivities";
             m->unified_return_status = SOLVER_RET_NAN;
@@ -1128,12 +1191,16 @@ int Feasiblesqpmethod::solve(void* mem) const {
         if (use_sqp_) {
           if (exact_hessian_) {
             // Update/reset exact Hessian
-            m->arg[0] = d_nlp->z;
-            m->arg[1] = d_nlp->p;
-            m->arg[2] = &one;
-            m->arg[3] = d_nlp->lam + nx_;
-            m->res[0] = d->Bk;
-            if (calc_function(m, "nlp_hess_l")) return 1;
+            if (hess_done) {
+              if (hess_flag) return 1;
+            } else {
+              m->arg[0] = d_nlp->z;
+              m->arg[1] = d_nlp->p;
+              m->arg[2] = &one;
+              m->arg[3] = d_nlp->lam + nx_;
+              m->res[0] = d->Bk;
+              if (calc_function(m, "nlp_hess_l")) return 1;
+            }
             if (convexify_) {
               ScopedTiming tic(m->fstats.at("convexify"));
               if (convexify_eval(&convexify_data_.config, d->Bk, d->Bk, m->iw, m->w)) return 1;
@@ -87,6 +87,11 @@ namespace casadi {
     /// Get all statistics
     Dict get_stats(void* mem) const override;
 
+    /// Iteration count of the last solve
+    casadi_int get_iter_count(void* mem) const override {
+      return static_cast<FeasiblesqpmethodMemory*>(mem)->iter_count;
+    }
+
     // Initialize the solver
     void init(const Dict& opts) override;
 
@@ -87,7 +87,17 @@ namespace casadi {
         "Options to be passed to the linear solver"}},
       {"min_lam",
        {OT_DOUBLE,
-        "Smallest multiplier treated as inactive for the initial active set [0]."}}
+        "Smallest multiplier treated as inactive for the initial active set [0]."}},
+      {"max_mcc",
+       {OT_INT,
+        "Maximum number of Gondzio multiple centrality correctors per iteration [0]."}},
+      {"warm_start",
+       {OT_BOOL,
+        "Start from the initial guess for x, lam_x and lam_a, e.g. the solution of "
+        "a nearby QP, instead of a default interior point [false]."}},
+      {"warm_start_mu",
+       {OT_DOUBLE,
+        "Smallest complementarity product of the warm-started initial point [1e-4]."}}
      }
   };
 
@@ -115,6 +125,12 @@ namespace casadi {
         p_.co_tol = op.second;
       } else if (op.first=="mu_tol") {
         p_.mu_tol = op.second;
+      } else if (op.first=="max_mcc") {
+        p_.max_mcc = op.second;
+      } else if (op.first=="warm_start") {
+        p_.warm_start = op.second.to_bool();
+      } else if (op.first=="warm_start_mu") {
+        p_.warm_start_mu = op.second;
       } else if (op.first=="print_iter") {
         print_iter_ = op.second;
       } else if (op.first=="print_header") {
@@ -156,6 +172,7 @@ namespace casadi {
     if (Conic::init_mem(mem)) return 1;
     auto m = static_cast<IpqpMemory*>(mem);
     m->return_status = "";
+    m->n_mcc = 0;
     return 0;
   }
 
@@ -175,6 +192,8 @@ namespace casadi {
     casadi_ipqp_bounds(&d, arg[CONIC_G],
       arg[CONIC_LBX], arg[CONIC_UBX], arg[CONIC_LBA], arg[CONIC_UBA]);
     casadi_ipqp_guess(&d, arg[CONIC_X0], arg[CONIC_LAM_X0], arg[CONIC_LAM_A0]);
+    // Constraint values at the initial guess
+    if (p_.warm_start) casadi_mv(arg[CONIC_A], A_, d.z, d.z + p_.nx, 0);
     // Reverse communication loop
     while (casadi_ipqp(&d)) {
       switch (d.task) {
@@ -218,6 +237,8 @@ namespace casadi {
     linsol_.release(linsol_mem);
     // Read return status
     m->return_status = casadi_ipqp_return_status(d.status);
+    m->d_qp.iter_count = d.iter;
+    m->n_mcc = d.n_mcc_tot;
     if (d.status == IPQP_MAX_ITER)
       m->d_qp.unified_return_status = SOLVER_RET_LIMITED;
     // Get solution
@@ -236,11 +257,12 @@ namespace casadi {
     Dict stats = Conic::get_stats(mem);
     auto m = static_cast<IpqpMemory*>(mem);
     stats["return_status"] = m->return_status;
+    stats["n_mcc"] = m->n_mcc;
     return stats;
   }
 
   Ipqp::Ipqp(DeserializingStream& s) : Conic(s) {
-    s.version("Ipqp", 1);
+    int version = s.version("Ipqp", 1, 2);
     s.unpack("Ipqp::kkt", kkt_);
     s.unpack("Ipqp::print_iter", print_iter_);
     s.unpack("Ipqp::print_header", print_header_);
@@ -253,12 +275,17 @@ namespace casadi {
     s.unpack("Ipqp::du_tol", p_.du_tol);
     s.unpack("Ipqp::co_tol", p_.co_tol);
     s.unpack("Ipqp::mu_tol", p_.mu_tol);
+    if (version >= 2) {
+      s.unpack("Ipqp::max_mcc", p_.max_mcc);
+      s.unpack("Ipqp::warm_start", p_.warm_start);
+      s.unpack("Ipqp::warm_start_mu", p_.warm_start_mu);
+    }
   }
 
   void Ipqp::serialize_body(SerializingStream &s) const {
     Conic::serialize_body(s);
 
-    s.version("Ipqp", 1);
+    s.version("Ipqp", 2);
     s.pack("Ipqp::kkt", kkt_);
     s.pack("Ipqp::print_iter", print_iter_);
     s.pack("Ipqp::print_header", print_header_);
@@ -270,6 +297,9 @@ namespace casadi {
     s.pack("Ipqp::du_tol", p_.du_tol);
     s.pack("Ipqp::co_tol", p_.co_tol);
     s.pack("Ipqp::mu_tol", p_.mu_tol);
+    s.pack("Ipqp::max_mcc", p_.max_mcc);
+    s.pack("Ipqp::warm_start", p_.warm_start);
+    s.pack("Ipqp::warm_start_mu", p_.warm_start_mu);
   }
 
 } // namespace casadi
@@ -43,6 +43,8 @@
 namespace casadi {
   struct CASADI_CONIC_IPQP_EXPORT IpqpMemory : public ConicMemory {
     const char* return_status;
+    // Number of centrality correctors
+    casadi_int n_mcc;
   };
 
   /** \brief \pluginbrief{Conic,ipqp}
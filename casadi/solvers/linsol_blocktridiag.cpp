@@ -0,0 +1,228 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+#include "linsol_blocktridiag.hpp"
+#include "casadi/core/global_options.hpp"
+
+namespace casadi {
+
+  extern "C"
+  int CASADI_LINSOL_BLOCKTRIDIAG_EXPORT
+  casadi_register_linsol_blocktridiag(LinsolInternal::Plugin* plugin) {
+    plugin->creator = LinsolBlocktridiag::creator;
+    plugin->name = "blocktridiag";
+    plugin->doc = LinsolBlocktridiag::meta_doc.c_str();
+    plugin->version = CASADI_VERSION;
+    plugin->options = &LinsolBlocktridiag::options_;
+    plugin->deserialize = &LinsolBlocktridiag::deserialize;
+    return 0;
+  }
+
+  extern "C"
+  void CASADI_LINSOL_BLOCKTRIDIAG_EXPORT casadi_load_linsol_blocktridiag() {
+    LinsolInternal::registerPlugin(casadi_register_linsol_blocktridiag);
+  }
+
+  LinsolBlocktridiag::LinsolBlocktridiag(const std::string& name, const Sparsity& sp)
+    : LinsolInternal(name, sp) {
+  }
+
+  LinsolBlocktridiag::~LinsolBlocktridiag() {
+    clear_mem();
+  }
+
+  const Options LinsolBlocktridiag::options_
+  = {{&LinsolInternal::options_},
+     {{"block_sizes",
+       {OT_INTVECTOR,
+        "Sizes of the diagonal blocks. Default: the smallest blocks for which the "
+        "matrix is block tridiagonal, detected from the sparsity pattern"}}
+     }
+  };
+
+  void LinsolBlocktridiag::init(const Dict& opts) {
+    // Call the init method of the base class
+    LinsolInternal::init(opts);
+
+    // Read options
+    std::vector<casadi_int> block_sizes;
+    for (auto&& op : opts) {
+      if (op.first=="block_sizes") {
+        block_sizes = op.second;
+      }
+    }
+    casadi_assert(nrow()==ncol(), "Matrix must be square");
+
+    // Block offsets
+    if (block_sizes.empty()) {
+      blk_ = detect_blocks();
+    } else {
+      blk_ = {0};
+      for (casadi_int n : block_sizes) {
+        casadi_assert(n>0, "Option 'block_sizes' must be positive");
+        blk_.push_back(blk_.back() + n);
+      }
+      casadi_assert(blk_.back()==nrow(), "Option 'block_sizes' must add up to "
+        + str(nrow()) + ", got " + str(blk_.back()));
+    }
+    casadi_int nb = blk_.size() - 1;
+
+    // Block index of each row and column
+    std::vector<casadi_int> bind(nrow());
+    for (casadi_int b=0; b<nb; ++b) {
+      std::fill(bind.begin() + blk_[b], bind.begin() + blk_[b+1], b);
+    }
+
+    // Offset of the factors of each block: S_k, L_k, G_k
+    std::vector<casadi_int> off(nb+1, 0);
+    for (casadi_int b=0; b<nb; ++b) {
+      casadi_int n_prev = b>0 ? blk_[b]-blk_[b-1] : 0;
+      casadi_int n_next = b<nb-1 ? blk_[b+2]-blk_[b+1] : 0;
+      casadi_int n = blk_[b+1]-blk_[b];
+      off[b+1] = off[b] + n*(n_prev + n + n_next);
+    }
+    nf_ = off.back();
+
+    // Location of the nonzeros in the dense blocks
+    const casadi_int *colind = this->colind(), *row = this->row();
+    amap_.resize(nnz());
+    for (casadi_int c=0; c<ncol(); ++c) {
+      casadi_int bc = bind[c];
+      for (casadi_int k=colind[c]; k<colind[c+1]; ++k) {
+        casadi_int r = row[k], br = bind[r];
+        casadi_assert(std::abs(br-bc)<=1, "Matrix is not block tridiagonal: entry ("
+          + str(r) + ", " + str(c) + ") couples blocks " + str(br) + " and " + str(bc));
+        casadi_int n = blk_[br+1]-blk_[br];
+        casadi_int n_prev = br>0 ? blk_[br]-blk_[br-1] : 0;
+        amap_[k] = off[br] + (r-blk_[br]) + (c-blk_[bc])*n;
+        if (bc<br) {
+          amap_[k] += n*n;
+        } else if (bc>br) {
+          amap_[k] += n*(n + n_prev);
+        }
+      }
+    }
+
+    if (verbose_) {
+      casadi_int max_block = 0;
+      for (casadi_int b=0; b<nb; ++b) max_block = std::max(max_block, blk_[b+1]-blk_[b]);
+      casadi_message(str(nb) + " diagonal blocks, largest block "
+        + str(max_block) + "x" + str(max_block));
+    }
+  }
+
+  std::vector<casadi_int> LinsolBlocktridiag::detect_blocks() const {
+    // Largest index coupled to each row or column in the symmetrized pattern
+    casadi_int n = nrow();
+    std::vector<casadi_int> reach = range(n);
+    const casadi_int *colind = this->colind(), *row = this->row();
+    for (casadi_int c=0; c<n; ++c) {
+      for (casadi_int k=colind[c]; k<colind[c+1]; ++k) {
+        casadi_int r = row[k];
+        reach[std::min(r, c)] = std::max(reach[std::min(r, c)], std::max(r, c));
+      }
+    }
+    // Starting from a scalar block, each block ends where the coupling of the previous ends
+    std::vector<casadi_int> blk = {0};
+    casadi_int end = std::min(n, casadi_int(1));
+    while (blk.back()<n) {
+      casadi_int start = blk.back();
+      blk.push_back(end);
+      casadi_int next = end + 1;
+      for (casadi_int i=start; i<end; ++i) next = std::max(next, reach[i] + 1);
+      end = std::min(next, n);
+    }
+    return blk;
+  }
+
+  int LinsolBlocktridiag::init_mem(void* mem) const {
+    if (LinsolInternal::init_mem(mem)) return 1;
+    auto m = static_cast<LinsolBlocktridiagMemory*>(mem);
+    m->f.resize(nf_);
+    m->ipiv.resize(nrow());
+    return 0;
+  }
+
+  int LinsolBlocktridiag::sfact(void* mem, const double* A) const {
+    return 0;
+  }
+
+  int LinsolBlocktridiag::nfact(void* mem, const double* A) const {
+    auto m = static_cast<LinsolBlocktridiagMemory*>(mem);
+    if (casadi_blocktridiag(sp_, A, get_ptr(amap_), get_ptr(blk_), blk_.size()-1,
+        get_ptr(m->f), get_ptr(m->ipiv))) {
+      if (verbose_) casadi_warning("Singular Schur complement in block tridiagonal factorization");
+      return 1;
+    }
+    return 0;
+  }
+
+  int LinsolBlocktridiag::solve(void* mem, const double* A, double* x, casadi_int nrhs,
+      bool tr) const {
+    auto m = static_cast<LinsolBlocktridiagMemory*>(mem);
+    casadi_blocktridiag_solve(x, nrhs, tr, get_ptr(blk_), blk_.size()-1,
+      get_ptr(m->f), get_ptr(m->ipiv));
+    return 0;
+  }
+
+  void LinsolBlocktridiag::generate(CodeGenerator& g, const std::string& A,
+      const std::string& x, casadi_int nrhs, bool tr) const {
+    // Codegen the integer vectors
+    std::string sp = g.sparsity(sp_);
+    std::string amap = g.constant(amap_);
+    std::string blk = g.constant(blk_);
+
+    // Place in block to avoid conflicts caused by local variables
+    g << "{\n";
+    g << "casadi_real f[" << nf_ << "];\n";
+    g << "casadi_int ipiv[" << nrow() << "];\n";
+
+    // Factorize
+    g << g.blocktridiag(sp, A, amap, blk, blk_.size()-1, "f", "ipiv") << "\n";
+
+    // Solve
+    g << g.blocktridiag_solve(x, nrhs, tr, blk, blk_.size()-1, "f", "ipiv") << "\n";
+
+    // End of block
+    g << "}\n";
+  }
+
+  LinsolBlocktridiag::LinsolBlocktridiag(DeserializingStream& s) : LinsolInternal(s) {
+    s.version("LinsolBlocktridiag", 1);
+    s.unpack("LinsolBlocktridiag::blk", blk_);
+    s.unpack("LinsolBlocktridiag::amap", amap_);
+    s.unpack("LinsolBlocktridiag::nf", nf_);
+  }
+
+  void LinsolBlocktridiag::serialize_body(SerializingStream &s) const {
+    LinsolInternal::serialize_body(s);
+    s.version("LinsolBlocktridiag", 1);
+    s.pack("LinsolBlocktridiag::blk", blk_);
+    s.pack("LinsolBlocktridiag::amap", amap_);
+    s.pack("LinsolBlocktridiag::nf", nf_);
+  }
+
+} // namespace casadi
@@ -0,0 +1,146 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+#ifndef CASADI_LINSOL_BLOCKTRIDIAG_HPP
+#define CASADI_LINSOL_BLOCKTRIDIAG_HPP
+
+/** \defgroup plugin_Linsol_blocktridiag Title
+    \par
+
+  * Linear solver for block tridiagonal matrices, e.g. the KKT systems of
+  * multiple shooting discretizations with the variables ordered by stage.
+  * The diagonal blocks are given by the option block_sizes or detected from
+  * the sparsity pattern. The factorization is a block LU recursion, which
+  * reduces to a Riccati recursion for symmetric matrices, with dense LU
+  * factorizations of the Schur complements. The cost is linear in the number
+  * of blocks and cubic in the block size.
+
+*/
+
+/** \pluginsection{Linsol,blocktridiag} */
+
+/// \cond INTERNAL
+#include "casadi/core/linsol_internal.hpp"
+#include <casadi/solvers/casadi_linsol_blocktridiag_export.h>
+
+namespace casadi {
+  struct CASADI_LINSOL_BLOCKTRIDIAG_EXPORT LinsolBlocktridiagMemory : public LinsolMemory {
+    // Dense factors of the blocks
+    std::vector<double> f;
+    // Pivots of the Schur complements
+    std::vector<casadi_int> ipiv;
+  };
+
+  /** \brief \pluginbrief{LinsolInternal,blocktridiag}
+   * @copydoc LinsolInternal_doc
+   * @copydoc plugin_LinsolInternal_blocktridiag
+   */
+  class CASADI_LINSOL_BLOCKTRIDIAG_EXPORT LinsolBlocktridiag : public LinsolInternal {
+  public:
+
+    // Create a linear solver given a sparsity pattern and a number of right hand sides
+    LinsolBlocktridiag(const std::string& name, const Sparsity& sp);
+
+    /** \brief  Create a new LinsolInternal */
+    static LinsolInternal* creator(const std::string& name, const Sparsity& sp) {
+      return new LinsolBlocktridiag(name, sp);
+    }
+
+    // Destructor
+    ~LinsolBlocktridiag() override;
+
+    ///@{
+    /** \brief Options */
+    static const Options options_;
+    const Options& get_options() const override { return options_;}
+    ///@}
+
+    // Initialize the solver
+    void init(const Dict& opts) override;
+
+    /** \brief Create memory block */
+    void* alloc_mem() const override { return new LinsolBlocktridiagMemory();}
+
+    /** \brief Initalize memory block */
+    int init_mem(void* mem) const override;
+
+    /** \brief Free memory block */
+    void free_mem(void *mem) const override {
+      delete static_cast<LinsolBlocktridiagMemory*>(mem);
+    }
+
+    // Symbolic factorization
+    int sfact(void* mem, const double* A) const override;
+
+    // Factorize the linear system
+    int nfact(void* mem, const double* A) const override;
+
+    // Solve the linear system
+    int solve(void* mem, const double* A, double* x, casadi_int nrhs, bool tr) const override;
+
+    /// Generate C code
+    void generate(CodeGenerator& g, const std::string& A, const std::string& x,
+                  casadi_int nrhs, bool tr) const override;
+
+    /// A documentation string
+    static const std::string meta_doc;
+
+    // Get name of the plugin
+    const char* plugin_name() const override { return "blocktridiag";}
+
+    // Get name of the class
+    std::string class_name() const override { return "LinsolBlocktridiag";}
+
+    // Smallest block partition for which the matrix is block tridiagonal
+    std::vector<casadi_int> detect_blocks() const;
+
+    // Block offsets
+    std::vector<casadi_int> blk_;
+
+    // Location of each nonzero of A in the dense factors
+    std::vector<casadi_int> amap_;
+
+    // Length of the dense factors
+    casadi_int nf_;
+
+    /** \brief Serialize an object without type information */
+    void serialize_body(SerializingStream &s) const override;
+
+    /** \brief Deserialize with type disambiguation */
+    static ProtoFunction* deserialize(DeserializingStream& s) {
+      return new LinsolBlocktridiag(s);
+    }
+
+  protected:
+    /** \brief Deserializing constructor */
+    explicit LinsolBlocktridiag(DeserializingStream& s);
+  };
+
+} // namespace casadi
+
+/// \endcond
+
+#endif // CASADI_LINSOL_BLOCKTRIDIAG_HPP
@@ -0,0 +1,322 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#include "linsol_btf.hpp"
+#include "casadi/core/global_options.hpp"
+
+namespace casadi {
+
+  extern "C"
+  int CASADI_LINSOL_BTF_EXPORT
+  casadi_register_linsol_btf(LinsolInternal::Plugin* plugin) {
+    plugin->creator = LinsolBtf::creator;
+    plugin->name = "btf";
+    plugin->doc = LinsolBtf::meta_doc.c_str();
+    plugin->version = CASADI_VERSION;
+    plugin->options = &LinsolBtf::options_;
+    plugin->deserialize = &LinsolBtf::deserialize;
+    return 0;
+  }
+
+  extern "C"
+  void CASADI_LINSOL_BTF_EXPORT casadi_load_linsol_btf() {
+    LinsolInternal::registerPlugin(casadi_register_linsol_btf);
+  }
+
+  LinsolBtf::LinsolBtf(const std::string& name, const Sparsity& sp)
+    : LinsolInternal(name, sp) {
+  }
+
+  LinsolBtf::~LinsolBtf() {
+    clear_mem();
+  }
+
+  const Options LinsolBtf::options_
+  = {{&LinsolInternal::options_},
+     {{"linear_solver",
+       {OT_STRING,
+        "Linear solver for the non-scalar diagonal blocks [qr]"}},
+      {"linear_solver_options",
+       {OT_DICT,
+        "Options to be passed to the block linear solvers"}},
+      {"max_threads",
+       {OT_INT,
+        "Maximum number of threads for the numeric factorization. "
+        "The diagonal blocks are factorized in parallel [1]"}}
+     }
+  };
+
+  void LinsolBtf::init(const Dict& opts) {
+    // Call the init method of the base class
+    LinsolInternal::init(opts);
+
+    // Read options
+    linear_solver_ = "qr";
+    max_threads_ = 1;
+    for (auto&& op : opts) {
+      if (op.first=="linear_solver") {
+        linear_solver_ = op.second.to_string();
+      } else if (op.first=="linear_solver_options") {
+        linear_solver_options_ = op.second;
+      } else if (op.first=="max_threads") {
+        max_threads_ = op.second;
+      }
+    }
+    casadi_assert(max_threads_>=1, "Option 'max_threads' must be positive");
+    casadi_assert(!sp_.is_singular(), "Matrix is structurally singular, "
+      "sprank(A)=" + str(sprank(sp_)) + " (instead of " + str(nrow()) + ")");
+
+    // Block triangular form, the fine blocks of a structurally nonsingular matrix are square
+    std::vector<casadi_int> rowblock, colblock, coarse_rowblock, coarse_colblock;
+    nb_ = sp_.btf(rowperm_, colperm_, rowblock, colblock, coarse_rowblock, coarse_colblock);
+    casadi_assert_dev(rowblock==colblock);
+    blk_ = rowblock;
+    rblk_.resize(nrow());
+    cblk_.resize(ncol());
+    for (casadi_int b=0; b<nb_; ++b) {
+      for (casadi_int k=blk_[b]; k<blk_[b+1]; ++k) {
+        rblk_[rowperm_[k]] = b;
+        cblk_[colperm_[k]] = b;
+      }
+    }
+
+    // Off-diagonal entries are either all below or all above the diagonal blocks
+    const casadi_int *colind = this->colind(), *row = this->row();
+    bool has_lower = false, has_upper = false;
+    for (casadi_int c=0; c<ncol(); ++c) {
+      for (casadi_int k=colind[c]; k<colind[c+1]; ++k) {
+        if (rblk_[row[k]]>cblk_[c]) has_lower = true;
+        if (rblk_[row[k]]<cblk_[c]) has_upper = true;
+      }
+    }
+    casadi_assert_dev(!(has_lower && has_upper));
+    lower_ = !has_upper;
+
+    // Diagonal blocks
+    nzoff_ = {0};
+    ls_ind_.resize(nb_, -1);
+    casadi_int max_block = 0;
+    for (casadi_int b=0; b<nb_; ++b) {
+      std::vector<casadi_int> rr(rowperm_.begin()+blk_[b], rowperm_.begin()+blk_[b+1]);
+      std::vector<casadi_int> cc(colperm_.begin()+blk_[b], colperm_.begin()+blk_[b+1]);
+      std::vector<casadi_int> mapping;
+      Sparsity sp_b = sp_.sub(rr, cc, mapping);
+      nz_.insert(nz_.end(), mapping.begin(), mapping.end());
+      nzoff_.push_back(nz_.size());
+      max_block = std::max(max_block, sp_b.size1());
+      if (sp_b.size1()>1) {
+        ls_ind_[b] = ls_.size();
+        ls_.push_back(Linsol(name_ + "_" + str(b), linear_solver_, sp_b,
+          linear_solver_options_));
+      }
+    }
+    init_tasks();
+    if (verbose_) {
+      casadi_message(str(nb_) + " diagonal blocks, " + str(ls_.size()) + " non-scalar, "
+        + "largest block " + str(max_block) + "x" + str(max_block));
+    }
+  }
+
+  void LinsolBtf::init_tasks() {
+    tasks_.clear();
+    casadi_int nt = std::min(max_threads_, static_cast<casadi_int>(ls_.size()));
+    if (nt<=1) return;
+    // Largest blocks first, each to the task with the fewest nonzeros so far
+    std::vector<casadi_int> order;
+    for (casadi_int b=0; b<nb_; ++b) if (ls_ind_[b]>=0) order.push_back(b);
+    std::stable_sort(order.begin(), order.end(), [&](casadi_int i, casadi_int j) {
+      return nzoff_[i+1]-nzoff_[i] > nzoff_[j+1]-nzoff_[j];});
+    tasks_.resize(nt);
+    std::vector<casadi_int> load(nt, 0);
+    for (casadi_int b : order) {
+      casadi_int t = std::min_element(load.begin(), load.end()) - load.begin();
+      tasks_[t].push_back(b);
+      load[t] += nzoff_[b+1] - nzoff_[b];
+    }
+  }
+
+  int LinsolBtf::init_mem(void* mem) const {
+    if (LinsolInternal::init_mem(mem)) return 1;
+    auto m = static_cast<LinsolBtfMemory*>(mem);
+
+    // Work vectors
+    m->a.resize(nz_.size());
+    m->w.resize(nrow());
+    m->wb.resize(nrow());
+
+    // Memory for the block linear solvers
+    m->mem.resize(ls_.size());
+    for (casadi_int i=0; i<ls_.size(); ++i) m->mem[i] = ls_[i].checkout();
+    return 0;
+  }
+
+  void LinsolBtf::free_mem(void *mem) const {
+    auto m = static_cast<LinsolBtfMemory*>(mem);
+    for (casadi_int i=0; i<m->mem.size(); ++i) ls_[i].release(m->mem[i]);
+    delete m;
+  }
+
+  int LinsolBtf::sfact(void* mem, const double* A) const {
+    auto m = static_cast<LinsolBtfMemory*>(mem);
+    for (casadi_int k=0; k<nz_.size(); ++k) m->a[k] = A[nz_[k]];
+    for (casadi_int b=0; b<nb_; ++b) {
+      casadi_int i = ls_ind_[b];
+      if (i<0) continue;
+      if (ls_[i].sfact(get_ptr(m->a) + nzoff_[b], m->mem[i])) return 1;
+    }
+    return 0;
+  }
+
+  int LinsolBtf::nfact(void* mem, const double* A) const {
+    auto m = static_cast<LinsolBtfMemory*>(mem);
+    // Gather the nonzeros of the diagonal blocks
+    for (casadi_int k=0; k<nz_.size(); ++k) m->a[k] = A[nz_[k]];
+    for (casadi_int b=0; b<nb_; ++b) {
+      if (ls_ind_[b]<0 && m->a[nzoff_[b]]==0) {
+        casadi_warning("BTF factorization has a zero scalar block");
+      }
+    }
+    // Factorize the non-scalar blocks, in parallel if requested
+    if (tasks_.empty()) {
+      for (casadi_int b=0; b<nb_; ++b) {
+        casadi_int i = ls_ind_[b];
+        if (i<0) continue;
+        if (ls_[i].nfact(get_ptr(m->a) + nzoff_[b], m->mem[i])) return 1;
+      }
+    } else {
+      std::vector<int> flag(tasks_.size(), 0);
+      parallel_for(tasks_.size(), [&](casadi_int t) {
+        for (casadi_int b : tasks_[t]) {
+          casadi_int i = ls_ind_[b];
+          if (ls_[i].nfact(get_ptr(m->a) + nzoff_[b], m->mem[i])) flag[t] = 1;
+        }
+      });
+      for (int f : flag) if (f) return 1;
+    }
+    return 0;
+  }
+
+  int LinsolBtf::solve(void* mem, const double* A, double* x, casadi_int nrhs, bool tr) const {
+    auto m = static_cast<LinsolBtfMemory*>(mem);
+    const casadi_int *colind = this->colind(), *row = this->row();
+    casadi_int n = nrow();
+    double *w = get_ptr(m->w), *wb = get_ptr(m->wb);
+    // Blocks in order of substitution
+    bool forward = lower_ != tr;
+    for (casadi_int r=0; r<nrhs; ++r) {
+      // Right-hand-side
+      casadi_copy(x, n, w);
+      for (casadi_int bb=0; bb<nb_; ++bb) {
+        casadi_int b = forward ? bb : nb_ - 1 - bb;
+        casadi_int sz = blk_[b+1] - blk_[b];
+        // Unknowns of the block are columns of A, equations are rows (reversed if transposed)
+        const casadi_int* eq = get_ptr(tr ? colperm_ : rowperm_) + blk_[b];
+        const casadi_int* var = get_ptr(tr ? rowperm_ : colperm_) + blk_[b];
+        if (tr) {
+          // Eliminate the contributions from the blocks already solved
+          for (casadi_int j=0; j<sz; ++j) {
+            casadi_int c = eq[j];
+            wb[j] = w[c];
+            for (casadi_int k=colind[c]; k<colind[c+1]; ++k) {
+              if (rblk_[row[k]]!=b) wb[j] -= A[k] * x[row[k]];
+            }
+          }
+        } else {
+          for (casadi_int j=0; j<sz; ++j) wb[j] = w[eq[j]];
+        }
+        // Solve the diagonal block
+        casadi_int i = ls_ind_[b];
+        if (i<0) {
+          wb[0] /= m->a[nzoff_[b]];
+        } else {
+          if (ls_[i].solve(get_ptr(m->a) + nzoff_[b], wb, 1, tr, m->mem[i])) return 1;
+        }
+        for (casadi_int j=0; j<sz; ++j) x[var[j]] = wb[j];
+        if (!tr) {
+          // Update the right-hand-sides of the remaining blocks
+          for (casadi_int j=0; j<sz; ++j) {
+            casadi_int c = var[j];
+            for (casadi_int k=colind[c]; k<colind[c+1]; ++k) {
+              if (rblk_[row[k]]!=b) w[row[k]] -= A[k] * x[c];
+            }
+          }
+        }
+      }
+      x += n;
+    }
+    return 0;
+  }
+
+  casadi_int LinsolBtf::rank(void* mem, const double* A) const {
+    auto m = static_cast<LinsolBtfMemory*>(mem);
+    casadi_int ret = 0;
+    for (casadi_int b=0; b<nb_; ++b) {
+      casadi_int i = ls_ind_[b];
+      if (i<0) {
+        if (m->a[nzoff_[b]]!=0) ret++;
+      } else {
+        casadi_int r = ls_[i].rank(get_ptr(m->a) + nzoff_[b], m->mem[i]);
+        if (r<0) return -1;
+        ret += r;
+      }
+    }
+    return ret;
+  }
+
+  LinsolBtf::LinsolBtf(DeserializingStream& s) : LinsolInternal(s) {
+    s.version("LinsolBtf", 1);
+    s.unpack("LinsolBtf::nb", nb_);
+    s.unpack("LinsolBtf::rowperm", rowperm_);
+    s.unpack("LinsolBtf::colperm", colperm_);
+    s.unpack("LinsolBtf::blk", blk_);
+    s.unpack("LinsolBtf::rblk", rblk_);
+    s.unpack("LinsolBtf::cblk", cblk_);
+    s.unpack("LinsolBtf::nz", nz_);
+    s.unpack("LinsolBtf::nzoff", nzoff_);
+    s.unpack("LinsolBtf::ls", ls_);
+    s.unpack("LinsolBtf::ls_ind", ls_ind_);
+    s.unpack("LinsolBtf::lower", lower_);
+    s.unpack("LinsolBtf::max_threads", max_threads_);
+    init_tasks();
+  }
+
+  void LinsolBtf::serialize_body(SerializingStream &s) const {
+    LinsolInternal::serialize_body(s);
+    s.version("LinsolBtf", 1);
+    s.pack("LinsolBtf::nb", nb_);
+    s.pack("LinsolBtf::rowperm", rowperm_);
+    s.pack("LinsolBtf::colperm", colperm_);
+    s.pack("LinsolBtf::blk", blk_);
+    s.pack("LinsolBtf::rblk", rblk_);
+    s.pack("LinsolBtf::cblk", cblk_);
+    s.pack("LinsolBtf::nz", nz_);
+    s.pack("LinsolBtf::nzoff", nzoff_);
+    s.pack("LinsolBtf::ls", ls_);
+    s.pack("LinsolBtf::ls_ind", ls_ind_);
+    s.pack("LinsolBtf::lower", lower_);
+    s.pack("LinsolBtf::max_threads", max_threads_);
+  }
+
+} // namespace casadi
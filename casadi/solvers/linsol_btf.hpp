@@ -0,0 +1,159 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010-2023 Joel Andersson, Joris Gillis, Moritz Diehl,
+ *                            KU Leuven. All rights reserved.
+ *    Copyright (C) 2011-2014 Greg Horn
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+#ifndef CASADI_LINSOL_BTF_HPP
+#define CASADI_LINSOL_BTF_HPP
+
+/** \defgroup plugin_Linsol_btf Title
+    \par
+
+  * Linear solver using the block triangular form (BTF) of the matrix.
+  * Only the diagonal blocks are factorized, each with a separate linear solver,
+  * and the system is solved by block substitution. Scalar blocks are handled
+  * directly.
+
+*/
+
+/** \pluginsection{Linsol,btf} */
+
+/// \cond INTERNAL
+#include "casadi/core/linsol_internal.hpp"
+#include <casadi/solvers/casadi_linsol_btf_export.h>
+
+namespace casadi {
+  struct CASADI_LINSOL_BTF_EXPORT LinsolBtfMemory : public LinsolMemory {
+    // Nonzeros of the diagonal blocks
+    std::vector<double> a;
+    // Right-hand-side and block work vectors
+    std::vector<double> w, wb;
+    // Memory objects of the block linear solvers
+    std::vector<int> mem;
+  };
+
+  /** \brief \pluginbrief{LinsolInternal,btf}
+   * @copydoc LinsolInternal_doc
+   * @copydoc plugin_LinsolInternal_btf
+   */
+  class CASADI_LINSOL_BTF_EXPORT LinsolBtf : public LinsolInternal {
+  public:
+
+    // Create a linear solver given a sparsity pattern and a number of right hand sides
+    LinsolBtf(const std::string& name, const Sparsity& sp);
+
+    /** \brief  Create a new LinsolInternal */
+    static LinsolInternal* creator(const std::string& name, const Sparsity& sp) {
+      return new LinsolBtf(name, sp);
+    }
+
+    // Destructor
+    ~LinsolBtf() override;
+
+    ///@{
+    /** \brief Options */
+    static const Options options_;
+    const Options& get_options() const override { return options_;}
+    ///@}
+
+    // Initialize the solver
+    void init(const Dict& opts) override;
+
+    /** \brief Create memory block */
+    void* alloc_mem() const override { return new LinsolBtfMemory();}
+
+    /** \brief Initalize memory block */
+    int init_mem(void* mem) const override;
+
+    /** \brief Free memory block */
+    void free_mem(void *mem) const override;
+
+    // Symbolic factorization
+    int sfact(void* mem, const double* A) const override;
+
+    // Factorize the linear system
+    int nfact(void* mem, const double* A) const override;
+
+    // Solve the linear system
+    int solve(void* mem, const double* A, double* x, casadi_int nrhs, bool tr) const override;
+
+    /// Matrix rank
+    casadi_int rank(void* mem, const double* A) const override;
+
+    /// A documentation string
+    static const std::string meta_doc;
+
+    // Get name of the plugin
+    const char* plugin_name() const override { return "btf";}
+
+    // Get name of the class
+    std::string class_name() const override { return "LinsolBtf";}
+
+    // Number of diagonal blocks
+    casadi_int nb_;
+
+    // Row and column permutation, block offsets
+    std::vector<casadi_int> rowperm_, colperm_, blk_;
+
+    // Block index of each row and column
+    std::vector<casadi_int> rblk_, cblk_;
+
+    // Nonzeros of A in each diagonal block, with offsets
+    std::vector<casadi_int> nz_, nzoff_;
+
+    // Linear solvers for the non-scalar blocks, index into ls_ (-1 if scalar)
+    std::vector<Linsol> ls_;
+    std::vector<casadi_int> ls_ind_;
+
+    // Off-diagonal blocks below (true) or above (false) the diagonal
+    bool lower_;
+
+    // Non-scalar blocks factorized by each parallel task
+    std::vector<std::vector<casadi_int> > tasks_;
+
+    ///@{
+    // Options
+    std::string linear_solver_;
+    Dict linear_solver_options_;
+    casadi_int max_threads_;
+    ///@}
+
+    /** \brief Serialize an object without type information */
+    void serialize_body(SerializingStream &s) const override;
+
+    /** \brief Deserialize with type disambiguation */
+    static ProtoFunction* deserialize(DeserializingStream& s) { return new LinsolBtf(s); }
+
+  protected:
+    /** \brief Deserializing constructor */
+    explicit LinsolBtf(DeserializingStream& s);
+
+    // Distribute the non-scalar blocks over parallel tasks
+    void init_tasks();
+  };
+
+} // namespace casadi
+
+/// \endcond
+
+#endif // CASADI_LINSOL_BTF_HPP
@@ -54,13 +54,28 @@ namespace casadi {
   }
 
   const Options LinsolLdl::options_
-  = {{&ProtoFunction::options_},
+  = {{&LinsolInternal::options_},
      {{"incomplete",
       {OT_BOOL,
        "Incomplete factorization, without any fill-in"}},
       {"preordering",
        {OT_BOOL,
-       "Approximate minimal degree (AMD) preordering"}}
+       "Approximate minimal degree (AMD) preordering"}},
+      {"ordering",
+       {OT_STRING,
+       "Fill-reducing preordering: 'amd' (approximate minimal degree), "
+       "'nd' (nested dissection) or 'none' [amd]"}},
+      {"supernodal",
+       {OT_BOOL,
+       "Supernodal factorization with dense block updates, "
+       "for factors with dense columns [false]"}},
+      {"max_threads",
+       {OT_INT,
+       "Maximum number of threads for the numeric factorization. Independent subtrees "
+       "of the elimination tree are factorized in parallel, unless 'supernodal' is set [1]"}},
+      {"subtree_cutoff",
+       {OT_INT,
+       "Minimum number of columns of a subtree factorized by a separate thread [256]"}}
      }
   };
 
@@ -70,32 +85,130 @@ namespace casadi {
 
     // Default options
     incomplete_ = false;
-    amd_ = true;
+    ordering_ = "amd";
+    supernodal_ = false;
+    max_threads_ = 1;
+    subtree_cutoff_ = 256;
 
     // Read user options
     for (auto&& op : opts) {
       if (op.first=="incomplete") {
         incomplete_ = op.second;
-      } else if (op.first=="amd") {
-        amd_ = op.second;
+      } else if (op.first=="amd" || op.first=="preordering") {
+        if (!op.second.to_bool()) ordering_ = "none";
+      } else if (op.first=="ordering") {
+        ordering_ = op.second.to_string();
+      } else if (op.first=="supernodal") {
+        supernodal_ = op.second;
+      } else if (op.first=="max_threads") {
+        max_threads_ = op.second;
+      } else if (op.first=="subtree_cutoff") {
+        subtree_cutoff_ = op.second;
       }
     }
 
+    casadi_assert(!(supernodal_ && incomplete_),
+      "Options 'supernodal' and 'incomplete' are mutually exclusive");
+    casadi_assert(max_threads_>=1, "Option 'max_threads' must be positive");
+
+    // Symbolic analysis, shared between instances with the same pattern and options
+    sym_ = symbolic_cache<LinsolLdlSymbolic>(symbolic_key(), [&]() { return analyze(); });
+  }
+
+  std::string LinsolLdl::symbolic_key() const {
+    return ordering_ + ":" + str(incomplete_) + ":" + str(supernodal_) + ":"
+      + str(max_threads_) + ":" + str(subtree_cutoff_);
+  }
+
+  LinsolLdlSymbolic LinsolLdl::analyze() const {
+    LinsolLdlSymbolic r;
+    r.sn_niw = r.sn_nw = 0;
+
+    // Fill-reducing permutation
+    if (ordering_=="amd") {
+      r.p = sp_.amd();
+    } else if (ordering_=="nd") {
+      r.p = sp_.nested_dissection();
+    } else if (ordering_=="none") {
+      r.p = range(sp_.size1());
+    } else {
+      casadi_error("Unknown ordering '" + ordering_ + "', expected 'amd', 'nd' or 'none'");
+    }
+    std::vector<casadi_int> tmp;
+    Sparsity Aperm = sp_.sub(r.p, r.p, tmp);
+
     // Symbolic factorization
     if (incomplete_) {
-      if (amd_) {
-        // Incomplete LDL^T, AMD permutation
-        p_ = sp_.amd();
-        std::vector<casadi_int> tmp;
-        Sparsity Aperm = sp_.sub(p_, p_, tmp);
-        sp_Lt_ = triu(Aperm, false);  // no fill-in
-      } else {
-        p_ = range(sp_.size1());  // no reordering
-        sp_Lt_ = triu(sp_, false);  // no fill-in
-      }
+      // Incomplete LDL^T
+      r.sp_Lt = triu(Aperm, false);  // no fill-in
     } else {
       // Regular LDL^T
-      sp_Lt_ = sp_.ldl(p_, amd_);
+      r.sp_Lt = Aperm.ldl(tmp, false);
+    }
+    if (verbose_) {
+      casadi_message("'" + ordering_ + "' ordering, " + str(r.sp_Lt.nnz())
+        + " nonzeros in L");
+    }
+
+    // Supernodes require the complete fill-in pattern
+    if (supernodal_) init_supernodes(r);
+
+    // Parallel factorization of independent subtrees
+    if (!supernodal_) etree_tasks(r.sp_Lt, max_threads_, subtree_cutoff_, r.tasks, r.rest);
+    if (verbose_ && !r.tasks.empty()) {
+      casadi_message(str(r.tasks.size()) + " parallel tasks, " + str(r.rest.size())
+        + " of " + str(r.sp_Lt.size2()) + " columns factorized serially");
+    }
+    return r;
+  }
+
+  void LinsolLdl::init_supernodes(LinsolLdlSymbolic& r) const {
+    casadi_int n = r.sp_Lt.size2();
+    // Strictly lower triangular factor, nonzeros of L^T for each nonzero of L
+    std::vector<casadi_int> mapping;
+    Sparsity sp_L = r.sp_Lt.transpose(mapping);
+    const casadi_int *colind = sp_L.colind(), *row = sp_L.row();
+    // Fundamental supernodes: column c continues the supernode of c-1 if the structure
+    // of column c-1 is {c} followed by the structure of column c
+    std::vector<casadi_int> super;
+    for (casadi_int c=0; c<n; ++c) {
+      bool cont = c>0 && colind[c]-colind[c-1]==colind[c+1]-colind[c]+1
+        && row[colind[c-1]]==c && std::equal(row+colind[c], row+colind[c+1], row+colind[c-1]+1);
+      if (!cont) super.push_back(c);
+    }
+    casadi_int ns = super.size();
+    super.push_back(n);
+    // Row lists: the own columns followed by the structure of the last column
+    std::vector<casadi_int> rowptr(1, 0), poff(1, 0), rows, snof(n);
+    casadi_int max_upd = 0;
+    for (casadi_int s=0; s<ns; ++s) {
+      casadi_int f = super[s], l = super[s+1] - 1;
+      for (casadi_int c=f; c<=l; ++c) {
+        rows.push_back(c);
+        snof[c] = s;
+      }
+      rows.insert(rows.end(), row+colind[l], row+colind[l+1]);
+      casadi_int m = rows.size() - rowptr.back(), k = l - f + 1;
+      rowptr.push_back(rows.size());
+      poff.push_back(poff.back() + m*k);
+      max_upd = std::max(max_upd, (m-k)*(m-k));
+      // Panel column j holds the strictly lower entries of column f+j in rows j+1, ..., m-1
+      for (casadi_int c=f; c<=l; ++c) {
+        for (casadi_int el=colind[c]; el<colind[c+1]; ++el) r.lmap.push_back(mapping[el]);
+      }
+    }
+    // Assemble
+    r.sn = {ns};
+    r.sn.insert(r.sn.end(), super.begin(), super.end());
+    r.sn.insert(r.sn.end(), rowptr.begin(), rowptr.end());
+    r.sn.insert(r.sn.end(), poff.begin(), poff.end());
+    r.sn.insert(r.sn.end(), rows.begin(), rows.end());
+    r.sn.insert(r.sn.end(), snof.begin(), snof.end());
+    r.sn_niw = 2*n + 3*ns;
+    r.sn_nw = poff.back() + max_upd;
+    if (verbose_) {
+      casadi_message(str(ns) + " supernodes for " + str(n) + " columns, "
+        + str(poff.back()) + " panel entries");
     }
   }
 
@@ -105,9 +218,19 @@ namespace casadi {
 
     // Work vectors
     casadi_int nrow = this->nrow();
-    m->d.resize(nrow);
-    m->l.resize(sp_Lt_.nnz());
-    m->w.resize(nrow);
+    casadi_int nw = supernodal_ ? std::max(nrow, sym_->sn_nw) : nrow * (sym_->tasks.size() + 1);
+    if (mixed_precision_) {
+      // Factors in single precision
+      m->af.resize(sp_.nnz());
+      m->df.resize(nrow);
+      m->lf.resize(sym_->sp_Lt.nnz());
+      m->wf.resize(nw);
+    } else {
+      m->d.resize(nrow);
+      m->l.resize(sym_->sp_Lt.nnz());
+      m->w.resize(nw);
+    }
+    if (supernodal_) m->iw.resize(sym_->sn_niw);
 
     return 0;
   }
@@ -116,18 +239,52 @@ namespace casadi {
     return 0;
   }
 
+  template<typename T1>
+  void LinsolLdl::factorize(LinsolLdlMemory* m, const T1* A, T1* l, T1* d, T1* w) const {
+    const LinsolLdlSymbolic& sym = *sym_;
+    if (supernodal_) {
+      casadi_ldl_super(sp_, A, get_ptr(sym.sn), get_ptr(sym.lmap), l, d,
+        get_ptr(sym.p), get_ptr(m->iw), w);
+    } else if (!sym.tasks.empty()) {
+      casadi_int n = nrow();
+      casadi_ldl_copy(sp_, A, sym.sp_Lt, l, d, get_ptr(sym.p), w);
+      // Independent subtrees in parallel, then the remaining columns
+      casadi_clear(w + n, n * sym.tasks.size());
+      parallel_for(sym.tasks.size(), [&](casadi_int t) {
+        casadi_ldl_cols(sym.sp_Lt, l, d, get_ptr(sym.tasks[t]), sym.tasks[t].size(),
+          w + (t + 1) * n);
+      });
+      casadi_ldl_cols(sym.sp_Lt, l, d, get_ptr(sym.rest), sym.rest.size(), w);
+    } else {
+      casadi_ldl(sp_, A, sym.sp_Lt, l, d, get_ptr(sym.p), w);
+    }
+    for (casadi_int i=0; i<nrow(); ++i) {
+      if (d[i]==0) casadi_warning("LDL factorization has zeros in D");
+    }
+  }
+
   int LinsolLdl::nfact(void* mem, const double* A) const {
     auto m = static_cast<LinsolLdlMemory*>(mem);
-    casadi_ldl(sp_, A, sp_Lt_, get_ptr(m->l), get_ptr(m->d), get_ptr(p_), get_ptr(m->w));
-    for (double d : m->d) {
-      if (d==0) casadi_warning("LDL factorization has zeros in D");
+    if (mixed_precision_) {
+      std::copy_n(A, sp_.nnz(), m->af.begin());
+      factorize(m, get_ptr(m->af), get_ptr(m->lf), get_ptr(m->df), get_ptr(m->wf));
+    } else {
+      factorize(m, A, get_ptr(m->l), get_ptr(m->d), get_ptr(m->w));
     }
     return 0;
   }
 
   int LinsolLdl::solve(void* mem, const double* A, double* x, casadi_int nrhs, bool tr) const {
     auto m = static_cast<LinsolLdlMemory*>(mem);
-    casadi_ldl_solve(x, nrhs, sp_Lt_, get_ptr(m->l), get_ptr(m->d), get_ptr(p_), get_ptr(m->w));
+    if (mixed_precision_) {
+      return refine(mem, A, x, nrhs, tr, [&](float* xf) {
+        casadi_ldl_solve(xf, 1, sym_->sp_Lt, get_ptr(m->lf), get_ptr(m->df), get_ptr(sym_->p),
+          get_ptr(m->wf));
+        return 0;
+      });
+    }
+    casadi_ldl_solve(x, nrhs, sym_->sp_Lt, get_ptr(m->l), get_ptr(m->d), get_ptr(sym_->p),
+      get_ptr(m->w));
     return 0;
   }
 
@@ -136,7 +293,9 @@ namespace casadi {
     auto m = static_cast<LinsolLdlMemory*>(mem);
     casadi_int nrow = this->nrow();
     casadi_int ret = 0;
-    for (casadi_int i=0; i<nrow; ++i) if (m->d[i]<0) ret++;
+    for (casadi_int i=0; i<nrow; ++i) {
+      if ((mixed_precision_ ? m->df[i] : m->d[i])<0) ret++;
+    }
     return ret;
   }
 
@@ -145,7 +304,9 @@ namespace casadi {
     auto m = static_cast<LinsolLdlMemory*>(mem);
     casadi_int nrow = this->nrow();
     casadi_int ret = 0;
-    for (casadi_int i=0; i<nrow; ++i) if (m->d[i]!=0) ret++;
+    for (casadi_int i=0; i<nrow; ++i) {
+      if ((mixed_precision_ ? m->df[i] : m->d[i])!=0) ret++;
+    }
     return ret;
   }
 
@@ -153,18 +314,24 @@ namespace casadi {
                           casadi_int nrhs, bool tr) const {
     // Codegen the integer vectors
     std::string sp = g.sparsity(sp_);
-    std::string sp_Lt = g.sparsity(sp_Lt_);
-    std::string p = g.constant(p_);
+    std::string sp_Lt = g.sparsity(sym_->sp_Lt);
+    std::string p = g.constant(sym_->p);
 
     // Place in block to avoid conflicts caused by local variables
     g << "{\n";
     g.comment("FIXME(@jaeandersson): Memory allocation can be avoided");
-    g << "casadi_real lt[" << sp_Lt_.nnz() << "], "
+    g << "casadi_real lt[" << sym_->sp_Lt.nnz() << "], "
          "d[" << nrow() << "], "
-         "w[" << nrow() << "];\n";
+         "w[" << (supernodal_ ? std::max(nrow(), sym_->sn_nw) : nrow()) << "];\n";
 
     // Factorize
-    g << g.ldl(sp, A, sp_Lt, "lt", "d", p, "w") << "\n";
+    if (supernodal_) {
+      g << "casadi_int iw[" << sym_->sn_niw << "];\n";
+      g << g.ldl_super(sp, A, g.constant(sym_->sn), g.constant(sym_->lmap), "lt", "d", p,
+        "iw", "w") << "\n";
+    } else {
+      g << g.ldl(sp, A, sp_Lt, "lt", "d", p, "w") << "\n";
+    }
 
     // Solve
     g << g.ldl_solve(x, nrhs, sp_Lt, "lt", "d", p, "w") << "\n";
@@ -174,16 +341,62 @@ namespace casadi {
   }
 
   LinsolLdl::LinsolLdl(DeserializingStream& s) : LinsolInternal(s) {
-    s.version("LinsolLdl", 1);
-    s.unpack("LinsolLdl::p", p_);
-    s.unpack("LinsolLdl::sp_Lt", sp_Lt_);
+    int version = s.version("LinsolLdl", 1, 6);
+    LinsolLdlSymbolic r;
+    r.sn_niw = r.sn_nw = 0;
+    s.unpack("LinsolLdl::p", r.p);
+    s.unpack("LinsolLdl::sp_Lt", r.sp_Lt);
+    if (version >= 2) {
+      s.unpack("LinsolLdl::supernodal", supernodal_);
+      s.unpack("LinsolLdl::sn", r.sn);
+      s.unpack("LinsolLdl::lmap", r.lmap);
+      s.unpack("LinsolLdl::sn_niw", r.sn_niw);
+      s.unpack("LinsolLdl::sn_nw", r.sn_nw);
+    } else {
+      supernodal_ = false;
+    }
+    if (version >= 3) {
+      s.unpack("LinsolLdl::max_threads", max_threads_);
+      s.unpack("LinsolLdl::subtree_cutoff", subtree_cutoff_);
+    } else {
+      max_threads_ = 1;
+      subtree_cutoff_ = 256;
+    }
+    if (version >= 4 && version < 6) {
+      s.unpack("LinsolLdl::mixed_precision", mixed_precision_);
+      s.unpack("LinsolLdl::refine_max_iter", refine_max_iter_);
+      s.unpack("LinsolLdl::refine_tol", refine_tol_);
+    }
+    if (version >= 5) {
+      s.unpack("LinsolLdl::incomplete", incomplete_);
+      s.unpack("LinsolLdl::ordering", ordering_);
+    } else {
+      // Options of the analysis unknown, do not share it
+      incomplete_ = false;
+      ordering_ = "amd";
+      symbolic_cache_ = false;
+    }
+    // Share the analysis with instances created from the same pattern and options
+    sym_ = symbolic_cache<LinsolLdlSymbolic>(symbolic_key(), [&]() {
+      if (!supernodal_) etree_tasks(r.sp_Lt, max_threads_, subtree_cutoff_, r.tasks, r.rest);
+      return std::move(r);
+    });
   }
 
   void LinsolLdl::serialize_body(SerializingStream &s) const {
     LinsolInternal::serialize_body(s);
-    s.version("LinsolLdl", 1);
-    s.pack("LinsolLdl::p", p_);
-    s.pack("LinsolLdl::sp_Lt", sp_Lt_);
+    s.version("LinsolLdl", 6);
+    s.pack("LinsolLdl::p", sym_->p);
+    s.pack("LinsolLdl::sp_Lt", sym_->sp_Lt);
+    s.pack("LinsolLdl::supernodal", supernodal_);
+    s.pack("LinsolLdl::sn", sym_->sn);
+    s.pack("LinsolLdl::lmap", sym_->lmap);
+    s.pack("LinsolLdl::sn_niw", sym_->sn_niw);
+    s.pack("LinsolLdl::sn_nw", sym_->sn_nw);
+    s.pack("LinsolLdl::max_threads", max_threads_);
+    s.pack("LinsolLdl::subtree_cutoff", subtree_cutoff_);
+    s.pack("LinsolLdl::incomplete", incomplete_);
+    s.pack("LinsolLdl::ordering", ordering_);
   }
 
 } // namespace casadi
@@ -42,6 +42,23 @@
 namespace casadi {
   struct CASADI_LINSOL_LDL_EXPORT LinsolLdlMemory : public LinsolMemory {
     std::vector<double> l, d, w;
+    std::vector<casadi_int> iw;
+    // Single precision matrix, factors and work vector
+    std::vector<float> af, lf, df, wf;
+  };
+
+  // Symbolic analysis, shared between instances
+  struct CASADI_LINSOL_LDL_EXPORT LinsolLdlSymbolic {
+    // Fill-reducing permutation, pattern of L^T
+    std::vector<casadi_int> p;
+    Sparsity sp_Lt;
+    // Supernode partition and map to the nonzeros of L^T, cf. casadi_ldl_super
+    std::vector<casadi_int> sn, lmap;
+    // Work vector sizes for the supernodal factorization
+    casadi_int sn_niw, sn_nw;
+    // Columns factorized by each parallel task, remaining columns
+    std::vector<std::vector<casadi_int> > tasks;
+    std::vector<casadi_int> rest;
   };
 
   /** \brief \pluginbrief{LinsolInternal,ldl}
@@ -99,6 +116,9 @@ namespace casadi {
     /// Matrix rank
     casadi_int rank(void* mem, const double* A) const override;
 
+    /// Can the plugin factorize in single precision?
+    bool has_mixed_precision() const override { return true;}
+
     /// A documentation string
     static const std::string meta_doc;
 
@@ -108,15 +128,29 @@ namespace casadi {
     // Get name of the class
     std::string class_name() const override { return "LinsolLdl";}
 
-    // Symbolic factorization
-    std::vector<casadi_int> p_;
-    Sparsity sp_Lt_;
+    // Symbolic analysis, shared with other instances through the symbolic cache
+    std::shared_ptr<const LinsolLdlSymbolic> sym_;
 
     ///@{
     // Options
-    bool incomplete_, amd_;
+    bool incomplete_, supernodal_;
+    casadi_int max_threads_, subtree_cutoff_;
+    std::string ordering_;
     ///@}
 
+    // Options that the symbolic analysis depends on, as a cache key
+    std::string symbolic_key() const;
+
+    // Ordering, symbolic factorization, supernodes and parallel tasks
+    LinsolLdlSymbolic analyze() const;
+
+    // Numeric factorization in double or single precision
+    template<typename T1>
+    void factorize(LinsolLdlMemory* m, const T1* A, T1* l, T1* d, T1* w) const;
+
+    // Detect supernodes from the symbolic factorization
+    void init_supernodes(LinsolLdlSymbolic& r) const;
+
     /** \brief Serialize an object without type information */
     void serialize_body(SerializingStream &s) const override;
 
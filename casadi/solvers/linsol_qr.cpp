@@ -60,7 +60,18 @@ namespace casadi {
         "Minimum R entry before singularity is declared [1e-12]"}},
       {"cache",
        {OT_DOUBLE,
-        "Amount of factorisations to remember (thread-local) [0]"}}
+        "Amount of factorisations to remember (thread-local) [0]"}},
+      {"max_threads",
+       {OT_INT,
+        "Maximum number of threads for the numeric factorization. Independent subtrees "
+        "of the column elimination tree are factorized in parallel [1]"}},
+      {"subtree_cutoff",
+       {OT_INT,
+        "Minimum number of columns of a subtree factorized by a separate thread [256]"}},
+      {"ordering",
+       {OT_STRING,
+        "Fill-reducing column preordering, applied to the pattern of A'*A: "
+        "'amd' (approximate minimal degree), 'nd' (nested dissection) or 'none' [amd]"}}
      }
   };
 
@@ -71,20 +82,60 @@ namespace casadi {
     // Read options
     eps_ = 1e-12;
     n_cache_ = 0;
+    max_threads_ = 1;
+    subtree_cutoff_ = 256;
+    ordering_ = "amd";
     for (auto&& op : opts) {
       if (op.first=="eps") {
         eps_ = op.second;
       } else if (op.first=="cache") {
         n_cache_ = op.second;
+      } else if (op.first=="max_threads") {
+        max_threads_ = op.second;
+      } else if (op.first=="subtree_cutoff") {
+        subtree_cutoff_ = op.second;
+      } else if (op.first=="ordering") {
+        ordering_ = op.second.to_string();
       }
     }
 
+    casadi_assert(ordering_=="amd" || ordering_=="nd" || ordering_=="none",
+      "Unknown ordering '" + ordering_ + "', expected 'amd', 'nd' or 'none'");
+    casadi_assert(max_threads_>=1, "Option 'max_threads' must be positive");
+    casadi_assert(!mixed_precision_ || n_cache_==0,
+      "Option 'cache' cannot be combined with 'mixed_precision'");
+
+    // Symbolic analysis, shared between instances with the same pattern and options
+    sym_ = symbolic_cache<LinsolQrSymbolic>(symbolic_key(), [&]() { return analyze(); });
+  }
+
+  std::string LinsolQr::symbolic_key() const {
+    return ordering_ + ":" + str(max_threads_) + ":" + str(subtree_cutoff_);
+  }
+
+  LinsolQrSymbolic LinsolQr::analyze() const {
+    LinsolQrSymbolic r;
     // Symbolic factorization
-    sp_.qr_sparse(sp_v_, sp_r_, prinv_, pc_);
+    if (ordering_=="nd") {
+      // Nested dissection of the column intersection graph, cf. Sparsity::qr_sparse
+      r.pc = mtimes(sp_.T(), sp_).nested_dissection();
+      std::vector<casadi_int> tmp;
+      Sparsity Aperm = sp_.sub(range(nrow()), r.pc, tmp);
+      Aperm.qr_sparse(r.sp_v, r.sp_r, r.prinv, tmp, false);
+    } else {
+      sp_.qr_sparse(r.sp_v, r.sp_r, r.prinv, r.pc, ordering_=="amd");
+    }
+    // Parallel factorization of independent subtrees
+    etree_tasks(r.sp_r, max_threads_, subtree_cutoff_, r.tasks, r.rest);
+    if (verbose_ && !r.tasks.empty()) {
+      casadi_message(str(r.tasks.size()) + " parallel tasks, " + str(r.rest.size())
+        + " of " + str(ncol()) + " columns factorized serially");
+    }
+    return r;
   }
 
   void LinsolQr::finalize() {
-    cache_stride_ = sp_.nnz()+sp_v_.nnz()+sp_r_.nnz()+ncol();
+    cache_stride_ = sp_.nnz()+sym_->sp_v.nnz()+sym_->sp_r.nnz()+ncol();
     LinsolInternal::finalize();
   }
 
@@ -93,10 +144,20 @@ namespace casadi {
     auto m = static_cast<LinsolQrMemory*>(mem);
 
     // Memory for numerical solution
-    m->v.resize(sp_v_.nnz());
-    m->r.resize(sp_r_.nnz());
-    m->beta.resize(ncol());
-    m->w.resize(nrow() + ncol());
+    casadi_int nw = nrow() + ncol() + sym_->sp_v.size1() * sym_->tasks.size();
+    if (mixed_precision_) {
+      // Factors in single precision
+      m->af.resize(sp_.nnz());
+      m->vf.resize(sym_->sp_v.nnz());
+      m->rf.resize(sym_->sp_r.nnz());
+      m->betaf.resize(ncol());
+      m->wf.resize(nw);
+    } else {
+      m->v.resize(sym_->sp_v.nnz());
+      m->r.resize(sym_->sp_r.nnz());
+      m->beta.resize(ncol());
+      m->w.resize(nw);
+    }
 
     m->cache.resize(cache_stride_*n_cache_);
     m->cache_loc.resize(n_cache_, -1);
@@ -119,63 +180,101 @@ namespace casadi {
     if (cache && cache_hit) {
       cache += sp_.nnz();
       // Retrieve from cache and return early
-      casadi_copy(cache, sp_v_.nnz(), get_ptr(m->v)); cache+=sp_v_.nnz();
-      casadi_copy(cache, sp_r_.nnz(), get_ptr(m->r)); cache+=sp_r_.nnz();
+      casadi_copy(cache, sym_->sp_v.nnz(), get_ptr(m->v)); cache+=sym_->sp_v.nnz();
+      casadi_copy(cache, sym_->sp_r.nnz(), get_ptr(m->r)); cache+=sym_->sp_r.nnz();
       casadi_copy(cache, ncol(), get_ptr(m->beta)); cache+=ncol();
       return 0;
     }
 
     // Cache miss -> compute result
-    casadi_qr(sp_, A, get_ptr(m->w),
-              sp_v_, get_ptr(m->v), sp_r_, get_ptr(m->r),
-              get_ptr(m->beta), get_ptr(prinv_), get_ptr(pc_));
-    // Check singularity
-    double rmin;
+    if (mixed_precision_) {
+      std::copy_n(A, sp_.nnz(), m->af.begin());
+      if (factorize(get_ptr(m->af), get_ptr(m->wf), get_ptr(m->vf), get_ptr(m->rf),
+                    get_ptr(m->betaf))) return 1;
+    } else {
+      if (factorize(A, get_ptr(m->w), get_ptr(m->v), get_ptr(m->r),
+                    get_ptr(m->beta))) return 1;
+    }
+
+    if (cache) { // Store result in cache
+      casadi_copy(A, sp_.nnz(), cache); cache+=sp_.nnz();
+      casadi_copy(get_ptr(m->v), sym_->sp_v.nnz(), cache); cache+=sym_->sp_v.nnz();
+      casadi_copy(get_ptr(m->r), sym_->sp_r.nnz(), cache); cache+=sym_->sp_r.nnz();
+      casadi_copy(get_ptr(m->beta), ncol(), cache); cache+=ncol();
+    }
+    return 0;
+  }
+
+  template<typename T1>
+  int LinsolQr::factorize(const T1* A, T1* w, T1* v, T1* r, T1* beta) const {
+    const LinsolQrSymbolic& sym = *sym_;
+    if (!sym.tasks.empty()) {
+      // Independent subtrees in parallel, then the remaining columns
+      casadi_int nrow_ext = sym.sp_v.size1();
+      T1* wt = w + nrow() + ncol();
+      casadi_clear(w, nrow_ext);
+      casadi_clear(wt, nrow_ext * sym.tasks.size());
+      parallel_for(sym.tasks.size(), [&](casadi_int t) {
+        casadi_qr_cols(sp_, A, wt + t * nrow_ext, sym.sp_v, v, sym.sp_r, r, beta,
+                       get_ptr(sym.prinv), get_ptr(sym.pc), get_ptr(sym.tasks[t]),
+                       sym.tasks[t].size());
+      });
+      casadi_qr_cols(sp_, A, w, sym.sp_v, v, sym.sp_r, r, beta,
+                     get_ptr(sym.prinv), get_ptr(sym.pc), get_ptr(sym.rest), sym.rest.size());
+    } else {
+      casadi_qr(sp_, A, w, sym.sp_v, v, sym.sp_r, r, beta, get_ptr(sym.prinv), get_ptr(sym.pc));
+    }
+    // Check singularity, no tighter than the working precision
+    T1 eps = std::max(static_cast<T1>(eps_), std::numeric_limits<T1>::epsilon());
+    T1 rmin;
     casadi_int irmin, nullity;
-    nullity = casadi_qr_singular(&rmin, &irmin, get_ptr(m->r), sp_r_, get_ptr(pc_), eps_);
+    nullity = casadi_qr_singular(&rmin, &irmin, r, sym_->sp_r, get_ptr(sym_->pc), eps);
     if (nullity) {
       if (verbose_) {
         print("Singularity detected: Rank %lld<%lld\n", ncol()-nullity, ncol());
-        print("First singular R entry: %g<%g, corresponding to row %lld\n", rmin, eps_, irmin);
-        casadi_qr_colcomb(get_ptr(m->w), get_ptr(m->r), sp_r_, get_ptr(pc_), eps_, 0);
+        print("First singular R entry: %g<%g, corresponding to row %lld\n",
+          static_cast<double>(rmin), static_cast<double>(eps), irmin);
+        casadi_qr_colcomb(w, r, sym_->sp_r, get_ptr(sym_->pc), eps, 0);
         print("Linear combination of columns:\n[");
-        for (casadi_int k=0; k<ncol(); ++k) print(k==0 ? "%g" : ", %g", m->w[k]);
+        for (casadi_int k=0; k<ncol(); ++k) {
+          print(k==0 ? "%g" : ", %g", static_cast<double>(w[k]));
+        }
         print("]\n");
       }
       return 1;
     }
-
-    if (cache) { // Store result in cache
-      casadi_copy(A, sp_.nnz(), cache); cache+=sp_.nnz();
-      casadi_copy(get_ptr(m->v), sp_v_.nnz(), cache); cache+=sp_v_.nnz();
-      casadi_copy(get_ptr(m->r), sp_r_.nnz(), cache); cache+=sp_r_.nnz();
-      casadi_copy(get_ptr(m->beta), ncol(), cache); cache+=ncol();
-    }
     return 0;
   }
 
   int LinsolQr::solve(void* mem, const double* A, double* x, casadi_int nrhs, bool tr) const {
     auto m = static_cast<LinsolQrMemory*>(mem);
+    if (mixed_precision_) {
+      return refine(mem, A, x, nrhs, tr, [&](float* xf) {
+        casadi_qr_solve(xf, 1, tr, sym_->sp_v, get_ptr(m->vf), sym_->sp_r, get_ptr(m->rf),
+                        get_ptr(m->betaf), get_ptr(sym_->prinv), get_ptr(sym_->pc), get_ptr(m->wf));
+        return 0;
+      });
+    }
     casadi_qr_solve(x, nrhs, tr,
-                    sp_v_, get_ptr(m->v), sp_r_, get_ptr(m->r),
-                    get_ptr(m->beta), get_ptr(prinv_), get_ptr(pc_), get_ptr(m->w));
+                    sym_->sp_v, get_ptr(m->v), sym_->sp_r, get_ptr(m->r),
+                    get_ptr(m->beta), get_ptr(sym_->prinv), get_ptr(sym_->pc), get_ptr(m->w));
     return 0;
   }
 
   void LinsolQr::generate(CodeGenerator& g, const std::string& A, const std::string& x,
                           casadi_int nrhs, bool tr) const {
     // Codegen the integer vectors
-    std::string prinv = g.constant(prinv_);
-    std::string pc = g.constant(pc_);
+    std::string prinv = g.constant(sym_->prinv);
+    std::string pc = g.constant(sym_->pc);
     std::string sp = g.sparsity(sp_);
-    std::string sp_v = g.sparsity(sp_v_);
-    std::string sp_r = g.sparsity(sp_r_);
+    std::string sp_v = g.sparsity(sym_->sp_v);
+    std::string sp_r = g.sparsity(sym_->sp_r);
 
     // Place in block to avoid conflicts caused by local variables
     g << "{\n";
     g.comment("FIXME(@jaeandersson): Memory allocation can be avoided");
-    g << "casadi_real v[" << sp_v_.nnz() << "], "
-         "r[" << sp_r_.nnz() << "], "
+    g << "casadi_real v[" << sym_->sp_v.nnz() << "], "
+         "r[" << sym_->sp_r.nnz() << "], "
          "beta[" << ncol() << "], "
          "w[" << nrow() + ncol() << "];\n";
 
@@ -191,8 +290,8 @@ namespace casadi {
         cache_stride_, n_cache_, sp_.nnz(), "&c") << ") {\n";
       casadi_int offset = sp_.nnz();
       g.comment("Retrieve from cache");
-      g << g.copy("c+" + str(offset), sp_v_.nnz(), "v") << "\n"; offset+=sp_v_.nnz();
-      g << g.copy("c+" + str(offset), sp_r_.nnz(), "r") << "\n"; offset+=sp_r_.nnz();
+      g << g.copy("c+" + str(offset), sym_->sp_v.nnz(), "v") << "\n"; offset+=sym_->sp_v.nnz();
+      g << g.copy("c+" + str(offset), sym_->sp_r.nnz(), "r") << "\n"; offset+=sym_->sp_r.nnz();
       g << g.copy("c+" + str(offset), ncol(), "beta") << "\n"; offset+=ncol();
       g << "} else {\n";
     }
@@ -204,8 +303,8 @@ namespace casadi {
       casadi_int offset = 0;
       g.comment("Store in cache");
       g << g.copy(A, sp_.nnz(), "c") << "\n";; offset+=sp_.nnz();
-      g << g.copy("v", sp_v_.nnz(), "c+"+str(offset)) << "\n"; offset+=sp_v_.nnz();
-      g << g.copy("r", sp_r_.nnz(), "c+"+str(offset)) << "\n"; offset+=sp_r_.nnz();
+      g << g.copy("v", sym_->sp_v.nnz(), "c+"+str(offset)) << "\n"; offset+=sym_->sp_v.nnz();
+      g << g.copy("r", sym_->sp_r.nnz(), "c+"+str(offset)) << "\n"; offset+=sym_->sp_r.nnz();
       g << g.copy("beta", ncol(), "c+"+str(offset)) << "\n"; offset+=ncol();
       g << "}\n";
     }
@@ -218,28 +317,56 @@ namespace casadi {
   }
 
   LinsolQr::LinsolQr(DeserializingStream& s) : LinsolInternal(s) {
-    int version = s.version("LinsolQr", 1, 2);
-    s.unpack("LinsolQr::prinv", prinv_);
-    s.unpack("LinsolQr::pc", pc_);
-    s.unpack("LinsolQr::sp_v", sp_v_);
-    s.unpack("LinsolQr::sp_r", sp_r_);
+    int version = s.version("LinsolQr", 1, 6);
+    LinsolQrSymbolic r;
+    s.unpack("LinsolQr::prinv", r.prinv);
+    s.unpack("LinsolQr::pc", r.pc);
+    s.unpack("LinsolQr::sp_v", r.sp_v);
+    s.unpack("LinsolQr::sp_r", r.sp_r);
     s.unpack("LinsolQr::eps", eps_);
     if (version>1) {
       s.unpack("LinsolQr::n_cache", n_cache_);
     } else {
       n_cache_ = 1;
     }
+    if (version>2) {
+      s.unpack("LinsolQr::max_threads", max_threads_);
+      s.unpack("LinsolQr::subtree_cutoff", subtree_cutoff_);
+    } else {
+      max_threads_ = 1;
+      subtree_cutoff_ = 256;
+    }
+    if (version>3 && version<6) {
+      s.unpack("LinsolQr::mixed_precision", mixed_precision_);
+      s.unpack("LinsolQr::refine_max_iter", refine_max_iter_);
+      s.unpack("LinsolQr::refine_tol", refine_tol_);
+    }
+    if (version>4) {
+      s.unpack("LinsolQr::ordering", ordering_);
+    } else {
+      // Ordering of the analysis unknown, do not share it
+      ordering_ = "amd";
+      symbolic_cache_ = false;
+    }
+    // Share the analysis with instances created from the same pattern and options
+    sym_ = symbolic_cache<LinsolQrSymbolic>(symbolic_key(), [&]() {
+      etree_tasks(r.sp_r, max_threads_, subtree_cutoff_, r.tasks, r.rest);
+      return std::move(r);
+    });
   }
 
   void LinsolQr::serialize_body(SerializingStream &s) const {
     LinsolInternal::serialize_body(s);
-    s.version("LinsolQr", 2);
-    s.pack("LinsolQr::prinv", prinv_);
-    s.pack("LinsolQr::pc", pc_);
-    s.pack("LinsolQr::sp_v", sp_v_);
-    s.pack("LinsolQr::sp_r", sp_r_);
+    s.version("LinsolQr", 6);
+    s.pack("LinsolQr::prinv", sym_->prinv);
+    s.pack("LinsolQr::pc", sym_->pc);
+    s.pack("LinsolQr::sp_v", sym_->sp_v);
+    s.pack("LinsolQr::sp_r", sym_->sp_r);
     s.pack("LinsolQr::eps", eps_);
     s.pack("LinsolQr::n_cache", n_cache_);
+    s.pack("LinsolQr::max_threads", max_threads_);
+    s.pack("LinsolQr::subtree_cutoff", subtree_cutoff_);
+    s.pack("LinsolQr::ordering", ordering_);
   }
 
 } // namespace casadi
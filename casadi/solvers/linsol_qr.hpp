@@ -43,11 +43,23 @@ namespace casadi {
   struct CASADI_LINSOL_QR_EXPORT LinsolQrMemory : public LinsolMemory {
     std::vector<double> v, r, beta, w;
     std::vector<double> cache;
+    // Single precision matrix, factors and work vector
+    std::vector<float> af, vf, rf, betaf, wf;
 
     // Cache locations sorted by access time
     std::vector<int> cache_loc;
   };
 
+  // Symbolic analysis, shared between instances
+  struct CASADI_LINSOL_QR_EXPORT LinsolQrSymbolic {
+    // Patterns of V and R, row and column permutations
+    Sparsity sp_v, sp_r;
+    std::vector<casadi_int> prinv, pc;
+    // Columns factorized by each parallel task, remaining columns
+    std::vector<std::vector<casadi_int> > tasks;
+    std::vector<casadi_int> rest;
+  };
+
   /** \brief \pluginbrief{LinsolInternal,qr}
    * @copydoc LinsolInternal_doc
    * @copydoc plugin_LinsolInternal_qr
@@ -96,6 +108,13 @@ namespace casadi {
     // Solve the linear system
     int solve(void* mem, const double* A, double* x, casadi_int nrhs, bool tr) const override;
 
+    /// Can the plugin factorize in single precision?
+    bool has_mixed_precision() const override { return true;}
+
+    // Numeric factorization in double or single precision, nonzero if singular
+    template<typename T1>
+    int factorize(const T1* A, T1* w, T1* v, T1* r, T1* beta) const;
+
     /// Generate C code
     void generate(CodeGenerator& g, const std::string& A, const std::string& x,
                   casadi_int nrhs, bool tr) const override;
@@ -109,15 +128,26 @@ namespace casadi {
     /// A documentation string
     static const std::string meta_doc;
 
-    /// Symbolic factorization
-    std::vector<casadi_int> prinv_, pc_;
-    Sparsity sp_v_, sp_r_;
+    /// Symbolic analysis, shared with other instances through the symbolic cache
+    std::shared_ptr<const LinsolQrSymbolic> sym_;
     double eps_;
 
     /// Cache size
     casadi_int n_cache_;
     casadi_int cache_stride_;
 
+    ///@{
+    /// Options of the symbolic analysis
+    casadi_int max_threads_, subtree_cutoff_;
+    std::string ordering_;
+    ///@}
+
+    // Options that the symbolic analysis depends on, as a cache key
+    std::string symbolic_key() const;
+
+    // Ordering, symbolic factorization and parallel tasks
+    LinsolQrSymbolic analyze() const;
+
     /** \brief Serialize an object without type information */
     void serialize_body(SerializingStream &s) const override;
 
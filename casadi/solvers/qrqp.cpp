@@ -79,7 +79,11 @@ namespace casadi {
         "Printed numbers are 0-based indices into the vector of [simple bounds;linear bounds]"}},
       {"min_lam",
        {OT_DOUBLE,
-        "Smallest multiplier treated as inactive for the initial active set [0]."}}
+        "Smallest multiplier treated as inactive for the initial active set [0]."}},
+      {"reuse_factorization",
+       {OT_BOOL,
+        "Keep the factorization of the KKT system between calls and only refactorize "
+        "the columns that changed, e.g. when solving a sequence of similar QPs [false]."}}
      }
   };
 
@@ -104,6 +108,7 @@ namespace casadi {
     print_header_ = true;
     print_info_ = true;
     print_lincomb_ = false;
+    reuse_factorization_ = false;
 
     // Read user options
     for (auto&& op : opts) {
@@ -123,6 +128,8 @@ namespace casadi {
         print_info_ = op.second;
       } else if (op.first=="print_lincomb") {
         print_lincomb_ = op.second;
+      } else if (op.first=="reuse_factorization") {
+        reuse_factorization_ = op.second;
       }
     }
 
@@ -170,6 +177,16 @@ namespace casadi {
     p_.sp_r = sp_r_;
     p_.prinv = get_ptr(prinv_);
     p_.pc = get_ptr(pc_);
+    // Column elimination tree of R: parent of column c is the first column with a nonzero in row c
+    etree_.assign(sp_r_.size2(), -1);
+    const casadi_int *r_colind = sp_r_.colind(), *r_row = sp_r_.row();
+    for (casadi_int c=0; c<sp_r_.size2(); ++c) {
+      for (casadi_int k=r_colind[c]; k<r_colind[c+1]; ++k) {
+        casadi_int r = r_row[k];
+        if (r<c && etree_[r]<0) etree_[r] = c;
+      }
+    }
+    p_.etree = get_ptr(etree_);
     casadi_qrqp_setup(&p_);
   }
 
@@ -177,6 +194,13 @@ namespace casadi {
     if (Conic::init_mem(mem)) return 1;
     auto m = static_cast<QrqpMemory*>(mem);
     m->return_status = "";
+    if (reuse_factorization_) {
+      m->kkt.resize(kkt_.nnz());
+      m->vr.resize(sp_v_.nnz() + sp_r_.nnz());
+      m->beta.resize(nx_ + na_);
+    }
+    m->has_fact = false;
+    m->d.n_fact = m->d.n_update = 0;
     return 0;
   }
 
@@ -202,6 +226,13 @@ namespace casadi {
 
     // Reset solver
     if (casadi_qrqp_reset(&d)) return 1;
+    // Restore the factorization from the previous call
+    if (reuse_factorization_ && m->has_fact) {
+      casadi_copy(get_ptr(m->kkt), m->kkt.size(), d.nz_kkt);
+      casadi_copy(get_ptr(m->vr), m->vr.size(), d.nz_v);
+      casadi_copy(get_ptr(m->beta), m->beta.size(), d.beta);
+      d.has_fact = 1;
+    }
     while (true) {
       // Prepare QP
       int flag = casadi_qrqp_prepare(&d);
@@ -231,6 +262,15 @@ namespace casadi {
       // User interrupt
       InterruptHandler::check();
     }
+    // Save the factorization for the next call
+    if (reuse_factorization_) {
+      m->has_fact = d.has_fact;
+      if (m->has_fact) {
+        casadi_copy(d.nz_kkt, m->kkt.size(), get_ptr(m->kkt));
+        casadi_copy(d.nz_v, m->vr.size(), get_ptr(m->vr));
+        casadi_copy(d.beta, m->beta.size(), get_ptr(m->beta));
+      }
+    }
     // Check return flag
     switch (d.status) {
       case QP_SUCCESS:
@@ -277,6 +317,7 @@ namespace casadi {
     g << "p.sp_r = " << g.sparsity(sp_r_) << ";\n";
     g << "p.prinv = " << g.constant(prinv_) << ";\n";
     g << "p.pc =  " << g.constant(pc_) << ";\n";
+    g << "p.etree = " << g.constant(etree_) << ";\n";
     g << "casadi_qrqp_setup(&p);\n";
 
     // Copy options
@@ -348,11 +389,13 @@ namespace casadi {
     Dict stats = Conic::get_stats(mem);
     auto m = static_cast<QrqpMemory*>(mem);
     stats["return_status"] = m->return_status;
+    stats["n_factorize"] = m->d.n_fact;
+    stats["n_update"] = m->d.n_update;
     return stats;
   }
 
   Qrqp::Qrqp(DeserializingStream& s) : Conic(s) {
-    s.version("Qrqp", 1);
+    int version = s.version("Qrqp", 1, 2);
     s.unpack("Qrqp::AT", AT_);
     s.unpack("Qrqp::kkt", kkt_);
     s.unpack("Qrqp::sp_v", sp_v_);
@@ -368,12 +411,17 @@ namespace casadi {
     s.unpack("Qrqp::min_lam", p_.min_lam);
     s.unpack("Qrqp::constr_viol_tol", p_.constr_viol_tol);
     s.unpack("Qrqp::dual_inf_tol", p_.dual_inf_tol);
+    if (version >= 2) {
+      s.unpack("Qrqp::reuse_factorization", reuse_factorization_);
+    } else {
+      reuse_factorization_ = false;
+    }
   }
 
   void Qrqp::serialize_body(SerializingStream &s) const {
     Conic::serialize_body(s);
 
-    s.version("Qrqp", 1);
+    s.version("Qrqp", 2);
     s.pack("Qrqp::AT", AT_);
     s.pack("Qrqp::kkt", kkt_);
     s.pack("Qrqp::sp_v", sp_v_);
@@ -388,6 +436,7 @@ namespace casadi {
     s.pack("Qrqp::min_lam", p_.min_lam);
     s.pack("Qrqp::constr_viol_tol", p_.constr_viol_tol);
     s.pack("Qrqp::dual_inf_tol", p_.dual_inf_tol);
+    s.pack("Qrqp::reuse_factorization", reuse_factorization_);
   }
 
 } // namespace casadi
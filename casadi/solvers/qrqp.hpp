@@ -45,6 +45,9 @@ namespace casadi {
     // Problem data structure
     casadi_qrqp_data<double> d;
     const char* return_status;
+    // KKT factorization kept from the previous call
+    std::vector<double> kkt, vr, beta;
+    bool has_fact;
   };
 
   /** \brief \pluginbrief{Conic,qrqp}
@@ -116,9 +119,12 @@ namespace casadi {
     Sparsity AT_, kkt_, sp_v_, sp_r_;
     // KKT system permutation
     std::vector<casadi_int> prinv_, pc_;
+    // Column elimination tree of R
+    std::vector<casadi_int> etree_;
     ///@{
     // Options
     bool print_iter_, print_header_, print_info_, print_lincomb_;
+    bool reuse_factorization_;
     ///@}
 
     void serialize_body(SerializingStream &s) const override;
@@ -83,6 +83,11 @@ const Options Sqpmethod::options_
     {"max_iter_ls",
       {OT_INT,
       "Maximum number of linesearch iterations"}},
+    {"max_batch_ls",
+      {OT_INT,
+      "Maximum number of line-search step lengths whose objective and constraints "
+      "are evaluated concurrently, using the thread-local memories (see max_num_threads). "
+      "The accepted step is the same as with sequential backtracking (default: 1)"}},
     {"tol_pr",
       {OT_DOUBLE,
       "Stopping criterion for primal infeasibility"}},
@@ -150,7 +155,18 @@ const Options Sqpmethod::options_
       "(default: false)."}},
     {"init_feasible",
       {OT_BOOL,
-      "Initialize the QP subproblems with a feasible initial value (default: false)."}}
+      "Initialize the QP subproblems with a feasible initial value (default: false)."}},
+    {"rti",
+      {OT_BOOL,
+      "Real-time iteration mode: each call performs a single full SQP step, split into a "
+      "preparation phase that linearizes at the initial guess and a feedback phase that "
+      "solves the QP for the current bounds and parameters. A change of the parameters "
+      "since the preparation phase enters the QP to first order (default: false)."}},
+    {"rti_split",
+      {OT_BOOL,
+      "Perform a single phase of a real-time iteration per call, alternating between "
+      "preparation and feedback. The next phase is kept in the solver memory, so that "
+      "several controllers can share the solver, each with its own memory (default: false)."}}
     }
 };
 
@@ -162,6 +178,7 @@ void Sqpmethod::init(const Dict& opts) {
   min_iter_ = 0;
   max_iter_ = 50;
   max_iter_ls_ = 3;
+  max_batch_ls_ = 1;
   c1_ = 1e-4;
   beta_ = 0.8;
   merit_memsize_ = 4;
@@ -181,6 +198,8 @@ void Sqpmethod::init(const Dict& opts) {
   gamma_1_min_ = 1e-5;
   so_corr_ = false;
   init_feasible_ = false;
+  rti_ = false;
+  rti_split_ = false;
 
   std::string convexify_strategy = "none";
   double convexify_margin = 1e-7;
@@ -194,6 +213,8 @@ void Sqpmethod::init(const Dict& opts) {
       min_iter_ = op.second;
     } else if (op.first=="max_iter_ls") {
       max_iter_ls_ = op.second;
+    } else if (op.first=="max_batch_ls") {
+      max_batch_ls_ = op.second;
     } else if (op.first=="c1") {
       c1_ = op.second;
     } else if (op.first=="beta") {
@@ -248,9 +269,15 @@ void Sqpmethod::init(const Dict& opts) {
       so_corr_ = op.second;
     } else if (op.first=="init_feasible") {
       init_feasible_ = op.second;
+    } else if (op.first=="rti") {
+      rti_ = op.second;
+    } else if (op.first=="rti_split") {
+      rti_split_ = op.second;
     }
   }
 
+  casadi_assert(max_batch_ls_>=1, "Option 'max_batch_ls' must be positive");
+
   if (elastic_mode_) {
     auto it = qpsol_options.find("error_on_fail");
     if (it==qpsol_options.end()) {
@@ -263,6 +290,9 @@ void Sqpmethod::init(const Dict& opts) {
 
   // Use exact Hessian?
   exact_hessian_ = hessian_approximation =="exact";
+  casadi_assert(!rti_ || exact_hessian_,
+    "Real-time iteration mode requires hessian_approximation 'exact' "
+    "(a Gauss-Newton Hessian can be passed with the 'hess_lag' option)");
 
   convexify_ = false;
 
@@ -296,6 +326,14 @@ void Sqpmethod::init(const Dict& opts) {
     Hsp_ = Sparsity::dense(nx_, nx_);
   }
 
+  // Sensitivities with respect to the parameters, for the feedback phase
+  if (rti_ && np_>0) {
+    create_function("nlp_rti_p", {"x", "p", "lam:f", "lam:g"},
+                    {"grad:f:p", "jac:g:p", "hess:gamma:x:p"}, {{"gamma", {"f", "g"}}});
+    Jpsp_ = get_function("nlp_rti_p").sparsity_out(1);
+    Hxpsp_ = get_function("nlp_rti_p").sparsity_out(2);
+  }
+
   casadi_assert(!qpsol_plugin.empty(), "'qpsol' option has not been set");
   qpsol_ = conic("qpsol", qpsol_plugin, {{"h", Hsp_}, {"a", Asp_}},
                   qpsol_options);
@@ -386,6 +424,25 @@ int Sqpmethod::init_mem(void* mem) const {
   m->add_stat("BFGS");
   m->add_stat("QP");
   m->add_stat("linesearch");
+  if (rti_) {
+    m->add_stat("preparation");
+    m->add_stat("feedback");
+    m->rti_z.resize(nx_+ng_);
+    m->rti_lam.resize(nx_+ng_);
+    m->rti_p.resize(np_);
+    m->rti_gf.resize(nx_);
+    m->rti_Jk.resize(Asp_.nnz());
+    m->rti_Bk.resize(Hsp_.nnz());
+    m->rti_gfp.resize(np_);
+    m->rti_Jp.resize(Jpsp_.nnz());
+    m->rti_Hxp.resize(Hxpsp_.nnz());
+    m->rti_dp.resize(np_);
+  }
+  if (max_batch_ls_>1) {
+    m->ls_z.resize(max_batch_ls_*(nx_+ng_));
+    m->ls_f.resize(max_batch_ls_);
+  }
+  m->rti_prepared = false;
   m->mem_qp = qpsol_->checkout();
   return 0;
 }
@@ -401,6 +458,14 @@ int Sqpmethod::solve(void* mem) const {
   auto d_nlp = &m->d_nlp;
   auto d = &m->d;
 
+  // Real-time iteration
+  if (rti_) {
+    m->iter_count = 0;
+    if (!rti_split_) return rti_preparation(m) || rti_feedback(m);
+    // One phase per call, the next one follows from the memory
+    return m->rti_prepared ? rti_feedback(m) : rti_preparation(m);
+  }
+
   // Number of SQP iterations
   m->iter_count = 0;
 
@@ -435,16 +500,35 @@ int Sqpmethod::solve(void* mem) const {
 
   casadi_clear(d->dx, nx_);
 
+  // Evaluate the exact Hessian concurrently with the first order derivative information
+  bool concurrent_hess = exact_hessian_ && max_num_threads_ > 1;
+  int hess_flag = 0;
+
   // MAIN OPTIMIZATION LOOP
   while (true) {
     // Evaluate f, g and first order derivative information
-    m->arg[0] = d_nlp->z;
-    m->arg[1] = d_nlp->p;
-    m->res[0] = &d_nlp->objective;
-    m->res[1] = d->gf;
-    m->res[2] = d_nlp->z + nx_;
-    m->res[3] = d->Jk;
-    switch (calc_function(m, "nlp_jac_fg")) {
+    int flag;
+    if (concurrent_hess) {
+      std::vector<OracleCall> calls(2);
+      calls[0].fcn = "nlp_jac_fg";
+      calls[0].arg = {d_nlp->z, d_nlp->p};
+      calls[0].res = {&d_nlp->objective, d->gf, d_nlp->z + nx_, d->Jk};
+      calls[1].fcn = "nlp_hess_l";
+      calls[1].arg = {d_nlp->z, d_nlp->p, &one, d_nlp->lam + nx_};
+      calls[1].res = {d->Bk};
+      calc_functions(m, calls);
+      flag = calls[0].flag;
+      hess_flag = calls[1].flag;
+    } else {
+      m->arg[0] = d_nlp->z;
+      m->arg[1] = d_nlp->p;
+      m->res[0] = &d_nlp->objective;
+      m->res[1] = d->gf;
+      m->res[2] = d_nlp->z + nx_;
+      m->res[3] = d->Jk;
+      flag = calc_function(m, "nlp_jac_fg");
+    }
+    switch (flag) {
       case -1:
         m->return_status = "Non_Regular_Sensitivities";
         m->unified_return_status = SOLVER_RET_NAN;
@@ -512,12 +596,16 @@ int Sqpmethod::solve(void* mem) const {
 
     if (exact_hessian_) {
       // Update/reset exact Hessian
-      m->arg[0] = d_nlp->z;
-      m->arg[1] = d_nlp->p;
-      m->arg[2] = &one;
-      m->arg[3] = d_nlp->lam + nx_;
-      m->res[0] = d->Bk;
-      if (calc_function(m, "nlp_hess_l")) return 1;
+      if (concurrent_hess) {
+        if (hess_flag) return 1;
+      } else {
+        m->arg[0] = d_nlp->z;
+        m->arg[1] = d_nlp->p;
+        m->arg[2] = &one;
+        m->arg[3] = d_nlp->lam + nx_;
+        m->res[0] = d->Bk;
+        if (calc_function(m, "nlp_hess_l")) return 1;
+      }
       if (convexify_) {
         ScopedTiming tic(m->fstats.at("convexify"));
         if (convexify_eval(&convexify_data_.config, d->Bk, d->Bk, m->iw, m->w)) return 1;
@@ -735,48 +823,53 @@ int Sqpmethod::solve(void* mem) const {
       //double meritmax = casadi_vfmax(d->merit_mem+1,
       //  std::min(merit_memsize_, static_cast<casadi_int>(m->iter_count))-1, d->merit_mem[0]);
 
-      // Line-search loop
-      while (true) {
-        // Increase counter
-        ls_iter++;
-
-        // Candidate step
-        casadi_copy(d_nlp->z, nx_, d->z_cand);
-        casadi_axpy(nx_, t, d->dx, d->z_cand);
-
-        // Evaluating objective and constraints
-        if (!so_corr_ || !so_succes) {
-          m->arg[0] = d->z_cand;
-          m->arg[1] = d_nlp->p;
-          m->res[0] = &fk_cand;
-          m->res[1] = d->z_cand + nx_;
-          if (calc_function(m, "nlp_fg")) {
-            // Avoid infinite recursion
-            if (ls_iter == max_iter_ls_) {
-              ls_success = false;
-              l1_infeas = nan;
-              break;
+      if (max_batch_ls_>1 && (!so_corr_ || !so_succes)) {
+        // Evaluate several step lengths at once
+        linesearch_batch(m, l1, tl1, t, ls_iter, ls_success, l1_infeas);
+      } else {
+        // Line-search loop
+        while (true) {
+          // Increase counter
+          ls_iter++;
+
+          // Candidate step
+          casadi_copy(d_nlp->z, nx_, d->z_cand);
+          casadi_axpy(nx_, t, d->dx, d->z_cand);
+
+          // Evaluating objective and constraints
+          if (!so_corr_ || !so_succes) {
+            m->arg[0] = d->z_cand;
+            m->arg[1] = d_nlp->p;
+            m->res[0] = &fk_cand;
+            m->res[1] = d->z_cand + nx_;
+            if (calc_function(m, "nlp_fg")) {
+              // Avoid infinite recursion
+              if (ls_iter == max_iter_ls_) {
+                ls_success = false;
+                l1_infeas = nan;
+                break;
+              }
+              // line-search failed, skip iteration
+              t = beta_ * t;
+              continue;
             }
-            // line-search failed, skip iteration
-            t = beta_ * t;
-            continue;
           }
-        }
 
-        // Calculating merit-function in candidate
-        l1_cand = fk_cand + m->sigma*casadi_sum_viol(nx_+ng_, d->z_cand, d_nlp->lbz, d_nlp->ubz);
-        if (l1_cand <= l1 + t * c1_ * tl1) {
-          break;
-        }
+          // Calculating merit-function in candidate
+          l1_cand = fk_cand + m->sigma*casadi_sum_viol(nx_+ng_, d->z_cand, d_nlp->lbz, d_nlp->ubz);
+          if (l1_cand <= l1 + t * c1_ * tl1) {
+            break;
+          }
 
-        // Line-search not successful, but we accept it.
-        if (ls_iter == max_iter_ls_) {
-          ls_success = false;
-          break;
-        }
+          // Line-search not successful, but we accept it.
+          if (ls_iter == max_iter_ls_) {
+            ls_success = false;
+            break;
+          }
 
-        // Backtracking
-        t = beta_ * t;
+          // Backtracking
+          t = beta_ * t;
+        }
       }
 
       // Candidate accepted, update dual variables
@@ -809,6 +902,187 @@ int Sqpmethod::solve(void* mem) const {
   return 0;
 }
 
+void Sqpmethod::linesearch_batch(SqpmethodMemory* m, double l1, double tl1, double& t,
+    casadi_int& ls_iter, bool& ls_success, double& l1_infeas) const {
+  auto d_nlp = &m->d_nlp;
+  auto d = &m->d;
+  casadi_int nz = nx_ + ng_;
+
+  // Reset line-search counter, success marker
+  ls_iter = 0;
+  ls_success = true;
+  t = 1.0;
+
+  while (true) {
+    // Candidate steps t, beta*t, beta^2*t, ...
+    casadi_int n_cand = std::min(max_batch_ls_, max_iter_ls_ - ls_iter);
+    std::vector<OracleCall> calls(n_cand);
+    double t_k = t;
+    for (casadi_int k=0; k<n_cand; ++k) {
+      double* z_k = get_ptr(m->ls_z) + k*nz;
+      casadi_copy(d_nlp->z, nx_, z_k);
+      casadi_axpy(nx_, t_k, d->dx, z_k);
+      calls[k].fcn = "nlp_fg";
+      calls[k].arg = {z_k, d_nlp->p};
+      calls[k].res = {&m->ls_f[k], z_k + nx_};
+      t_k *= beta_;
+    }
+
+    // Evaluating objective and constraints of all candidates
+    calc_functions(m, calls);
+
+    // Accept the longest step satisfying the Armijo condition
+    for (casadi_int k=0; k<n_cand; ++k) {
+      const double* z_k = get_ptr(m->ls_z) + k*nz;
+      ls_iter++;
+      bool accept = false;
+      if (calls[k].flag) {
+        // Avoid infinite recursion
+        if (ls_iter == max_iter_ls_) {
+          ls_success = false;
+          l1_infeas = nan;
+          accept = true;
+        }
+      } else {
+        // Calculating merit-function in candidate
+        double l1_cand = m->ls_f[k] + m->sigma*casadi_sum_viol(nz, z_k, d_nlp->lbz, d_nlp->ubz);
+        if (l1_cand <= l1 + t * c1_ * tl1) {
+          accept = true;
+        } else if (ls_iter == max_iter_ls_) {
+          // Line-search not successful, but we accept it.
+          ls_success = false;
+          accept = true;
+        }
+      }
+      if (accept) {
+        casadi_copy(z_k, nz, d->z_cand);
+        return;
+      }
+
+      // Backtracking
+      t = beta_ * t;
+    }
+  }
+}
+
+int Sqpmethod::rti_preparation(SqpmethodMemory* m) const {
+  ScopedTiming tic(m->fstats.at("preparation"));
+  auto d_nlp = &m->d_nlp;
+  auto d = &m->d;
+  const double one = 1.;
+  m->rti_prepared = false;
+
+  // Linearize at the initial guess: f, g and derivatives, Hessian of the Lagrangian
+  // and, if there are parameters, the derivatives with respect to them
+  std::vector<OracleCall> calls(np_>0 ? 3 : 2);
+  calls[0].fcn = "nlp_jac_fg";
+  calls[0].arg = {d_nlp->z, d_nlp->p};
+  calls[0].res = {&d_nlp->objective, d->gf, d_nlp->z + nx_, d->Jk};
+  calls[1].fcn = "nlp_hess_l";
+  calls[1].arg = {d_nlp->z, d_nlp->p, &one, d_nlp->lam + nx_};
+  calls[1].res = {d->Bk};
+  if (np_>0) {
+    calls[2].fcn = "nlp_rti_p";
+    calls[2].arg = {d_nlp->z, d_nlp->p, &one, d_nlp->lam + nx_};
+    calls[2].res = {get_ptr(m->rti_gfp), get_ptr(m->rti_Jp), get_ptr(m->rti_Hxp)};
+  }
+  calc_functions(m, calls);
+  if (calls[0].flag || calls[1].flag || (np_>0 && calls[2].flag)) {
+    m->return_status = "Non_Regular_Sensitivities";
+    m->unified_return_status = SOLVER_RET_NAN;
+    if (print_status_)
+      print("MESSAGE(sqpmethod): No regularity of sensitivities at current point.\n");
+    return 1;
+  }
+  if (convexify_) {
+    ScopedTiming tic(m->fstats.at("convexify"));
+    if (convexify_eval(&convexify_data_.config, d->Bk, d->Bk, m->iw, m->w)) return 1;
+  }
+
+  // Store the linearization for the feedback phase
+  casadi_copy(d_nlp->z, nx_+ng_, get_ptr(m->rti_z));
+  casadi_copy(d_nlp->lam, nx_+ng_, get_ptr(m->rti_lam));
+  casadi_copy(d_nlp->p, np_, get_ptr(m->rti_p));
+  casadi_copy(d->gf, nx_, get_ptr(m->rti_gf));
+  casadi_copy(d->Jk, Asp_.nnz(), get_ptr(m->rti_Jk));
+  casadi_copy(d->Bk, Hsp_.nnz(), get_ptr(m->rti_Bk));
+  m->rti_f = d_nlp->objective;
+
+  // Let the QP solver do the work that depends on the matrices only
+  std::fill_n(m->arg, qpsol_.n_in(), nullptr);
+  std::fill_n(m->res, qpsol_.n_out(), nullptr);
+  m->arg[CONIC_H] = d->Bk;
+  m->arg[CONIC_A] = d->Jk;
+  if (static_cast<const Conic*>(qpsol_.get())->prepare(m->arg, m->res, m->iw, m->w,
+      qpsol_->memory(m->mem_qp))) return 1;
+  m->rti_prepared = true;
+
+  m->return_status = "Preparation_Finished";
+  m->success = true;
+  m->unified_return_status = SOLVER_RET_SUCCESS;
+  return 0;
+}
+
+int Sqpmethod::rti_feedback(SqpmethodMemory* m) const {
+  ScopedTiming tic(m->fstats.at("feedback"));
+  auto d_nlp = &m->d_nlp;
+  auto d = &m->d;
+  casadi_assert(m->rti_prepared,
+    "sqpmethod: the feedback phase requires a preceding preparation phase");
+  m->rti_prepared = false;
+
+  // Restore the linearization
+  casadi_copy(get_ptr(m->rti_gf), nx_, d->gf);
+  casadi_copy(get_ptr(m->rti_Jk), Asp_.nnz(), d->Jk);
+  casadi_copy(get_ptr(m->rti_Bk), Hsp_.nnz(), d->Bk);
+  casadi_copy(get_ptr(m->rti_z), nx_+ng_, d_nlp->z);
+  double f = m->rti_f;
+
+  // Change of the parameters since the preparation phase, to first order
+  if (np_>0) {
+    double* dp = get_ptr(m->rti_dp);
+    casadi_copy(d_nlp->p, np_, dp);
+    casadi_axpy(np_, -1., get_ptr(m->rti_p), dp);
+    f += casadi_dot(np_, get_ptr(m->rti_gfp), dp);
+    casadi_mv(get_ptr(m->rti_Hxp), Hxpsp_, dp, d->gf, false);
+    casadi_mv(get_ptr(m->rti_Jp), Jpsp_, dp, d_nlp->z + nx_, false);
+  }
+
+  // Formulate the QP with the current bounds
+  casadi_copy(d_nlp->lbz, nx_+ng_, d->lbdz);
+  casadi_axpy(nx_+ng_, -1., d_nlp->z, d->lbdz);
+  casadi_copy(d_nlp->ubz, nx_+ng_, d->ubdz);
+  casadi_axpy(nx_+ng_, -1., d_nlp->z, d->ubdz);
+
+  // Initial guess
+  casadi_copy(get_ptr(m->rti_lam), nx_+ng_, d->dlam);
+  casadi_clear(d->dx, nx_);
+
+  // Solve the QP
+  m->iter_count = 1;
+  if (solve_QP(m, d->Bk, d->gf, d->lbdz, d->ubdz, d->Jk, d->dx, d->dlam, 0)) return 1;
+  auto m_qpsol = static_cast<ConicMemory*>(qpsol_->memory(m->mem_qp));
+
+  // Full step, f and g from the quadratic and linear models
+  casadi_axpy(nx_, 1., d->dx, d_nlp->z);
+  casadi_mv(d->Jk, Asp_, d->dx, d_nlp->z + nx_, false);
+  d_nlp->objective = f + casadi_dot(nx_, d->gf, d->dx)
+    + 0.5*casadi_bilin(d->Bk, Hsp_, d->dx, d->dx);
+  casadi_copy(d->dlam, nx_+ng_, d_nlp->lam);
+
+  if (m_qpsol->d_qp.success) {
+    m->return_status = "Solve_Succeeded";
+    m->success = true;
+    m->unified_return_status = SOLVER_RET_SUCCESS;
+  } else {
+    if (print_status_) print("MESSAGE(sqpmethod): QP solver failed in feedback phase.\n");
+    m->return_status = "QP_Failed";
+    m->success = false;
+    m->unified_return_status = SOLVER_RET_UNKNOWN;
+  }
+  return 0;
+}
+
 void Sqpmethod::print_iteration() const {
   print("%4s %14s %9s %9s %9s %7s %2s %7s\n", "iter", "objective", "inf_pr",
         "inf_du", "||d||", "lg(rg)", "ls", "info");
@@ -1038,6 +1312,7 @@ void Sqpmethod::codegen_body(CodeGenerator& g) const {
   codegen_body_enter(g);
   // From nlpsol
   casadi_assert(exact_hessian_, "Codegen implemented for exact Hessian only.", false);
+  casadi_assert(!rti_, "Codegen not implemented for real-time iteration mode.", false);
 
   g.local("d", "struct casadi_sqpmethod_data*");
   g.init_local("d", "&" + codegen_mem(g));
@@ -1512,11 +1787,12 @@ Dict Sqpmethod::get_stats(void* mem) const {
   auto m = static_cast<SqpmethodMemory*>(mem);
   stats["return_status"] = m->return_status;
   stats["iter_count"] = m->iter_count;
+  stats["qpsol_stats"] = qpsol_.stats(m->mem_qp);
   return stats;
 }
 
 Sqpmethod::Sqpmethod(DeserializingStream& s) : Nlpsol(s) {
-  int version = s.version("Sqpmethod", 1, 3);
+  int version = s.version("Sqpmethod", 1, 6);
   s.unpack("Sqpmethod::qpsol", qpsol_);
   if (version>=3) {
     s.unpack("Sqpmethod::qpsol_ela", qpsol_ela_);
@@ -1585,12 +1861,33 @@ Sqpmethod::Sqpmethod(DeserializingStream& s) : Nlpsol(s) {
     s.unpack("Sqpmethod::convexify", convexify_);
     if (convexify_) Convexify::deserialize(s, "Sqpmethod::", convexify_data_);
   }
+  if (version>=6) {
+    s.unpack("Sqpmethod::rti", rti_);
+    s.unpack("Sqpmethod::rti_split", rti_split_);
+    s.unpack("Sqpmethod::Jpsp", Jpsp_);
+    s.unpack("Sqpmethod::Hxpsp", Hxpsp_);
+  } else if (version>=4) {
+    s.unpack("Sqpmethod::rti", rti_);
+    casadi_int rti_phase;
+    s.unpack("Sqpmethod::rti_phase", rti_phase);
+    casadi_assert(!rti_ || np_==0,
+      "Real-time iteration mode with parameters requires a newer serialization");
+    rti_split_ = rti_phase!=0;
+  } else {
+    rti_ = false;
+    rti_split_ = false;
+  }
+  if (version>=5) {
+    s.unpack("Sqpmethod::max_batch_ls", max_batch_ls_);
+  } else {
+    max_batch_ls_ = 1;
+  }
   set_sqpmethod_prob();
 }
 
 void Sqpmethod::serialize_body(SerializingStream &s) const {
   Nlpsol::serialize_body(s);
-  s.version("Sqpmethod", 3);
+  s.version("Sqpmethod", 6);
   s.pack("Sqpmethod::qpsol", qpsol_);
   s.pack("Sqpmethod::qpsol_ela", qpsol_ela_);
   s.pack("Sqpmethod::exact_hessian", exact_hessian_);
@@ -1621,6 +1918,11 @@ void Sqpmethod::serialize_body(SerializingStream &s) const {
   s.pack("Sqpmethod::Asp", Asp_);
   s.pack("Sqpmethod::convexify", convexify_);
   if (convexify_) Convexify::serialize(s, "Sqpmethod::", convexify_data_);
+  s.pack("Sqpmethod::rti", rti_);
+  s.pack("Sqpmethod::rti_split", rti_split_);
+  s.pack("Sqpmethod::Jpsp", Jpsp_);
+  s.pack("Sqpmethod::Hxpsp", Hxpsp_);
+  s.pack("Sqpmethod::max_batch_ls", max_batch_ls_);
 }
 
 } // namespace casadi
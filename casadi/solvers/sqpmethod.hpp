@@ -59,6 +59,16 @@ namespace casadi {
 
     /// Iteration count
     int iter_count;
+
+    /// Real-time iterations: linearization stored by the preparation phase
+    std::vector<double> rti_z, rti_lam, rti_p, rti_gf, rti_Jk, rti_Bk;
+    /// Real-time iterations: derivatives with respect to the parameters, parameter change
+    std::vector<double> rti_gfp, rti_Jp, rti_Hxp, rti_dp;
+    double rti_f;
+    bool rti_prepared;
+
+    /// Line-search candidates evaluated concurrently
+    std::vector<double> ls_z, ls_f;
   };
 
   /** \brief  \pluginbrief{Nlpsol,sqpmethod}
@@ -90,6 +100,11 @@ namespace casadi {
     /// Get all statistics
     Dict get_stats(void* mem) const override;
 
+    /// Iteration count of the last solve
+    casadi_int get_iter_count(void* mem) const override {
+      return static_cast<SqpmethodMemory*>(mem)->iter_count;
+    }
+
     // Initialize the solver
     void init(const Dict& opts) override;
 
@@ -150,6 +165,7 @@ namespace casadi {
     double c1_;
     double beta_;
     casadi_int max_iter_ls_;
+    casadi_int max_batch_ls_;
     casadi_int merit_memsize_;
     ///@}
 
@@ -171,6 +187,16 @@ namespace casadi {
     // Second order corrections
     bool so_corr_;
 
+    /// Real-time iteration mode
+    bool rti_;
+
+    /// One phase of a real-time iteration per call
+    bool rti_split_;
+
+    /// Real-time iterations: sparsity of the Jacobian of g and of the mixed Hessian
+    /// of the Lagrangian with respect to the parameters
+    Sparsity Jpsp_, Hxpsp_;
+
     /** \brief Generate code for the function body */
     void codegen_body(CodeGenerator& g) const override;
 
@@ -228,6 +254,16 @@ namespace casadi {
     // Calculate gamma_1
     double calc_gamma_1(SqpmethodMemory* m) const;
 
+    // Backtracking line-search, evaluating max_batch_ls step lengths at once
+    void linesearch_batch(SqpmethodMemory* m, double l1, double tl1, double& t,
+      casadi_int& ls_iter, bool& ls_success, double& l1_infeas) const;
+
+    // Real-time iteration: linearize at the initial guess
+    int rti_preparation(SqpmethodMemory* m) const;
+
+    // Real-time iteration: solve the QP of the stored linearization, take a full step
+    int rti_feedback(SqpmethodMemory* m) const;
+
     /// A documentation string
     static const std::string meta_doc;
 
@@ -0,0 +1,66 @@
+from casadi import *
+import time
+
+# Closed-loop MPC of a chain of masses with input and state bounds,
+# solved directly and after full or partial condensing.
+# The state bounds and the initial state are chosen such that the QPs are
+# feasible at every horizon length; failed solves are counted and reported
+nm = 4
+dt = 0.1
+A = DM.zeros(2 * nm, 2 * nm)
+for i in range(nm):
+    A[i, nm + i] = 1
+    A[nm + i, i] = -2
+    if i > 0: A[nm + i, i - 1] = 1
+    if i < nm - 1: A[nm + i, i + 1] = 1
+A = DM.eye(2 * nm) + dt * A
+B = DM.zeros(2 * nm, 1)
+B[2 * nm - 1] = dt
+
+variants = [("qrqp", "qrqp", {}),
+            ("full+qrqp", "condensing", {"qpsol": "qrqp"}),
+            ("block5+qrqp", "condensing", {"qpsol": "qrqp", "block_size": 5})]
+if has_conic("qpoases"):
+    variants.append(("full+qpoases", "condensing",
+                     {"qpsol": "qpoases", "qpsol_options": {"printLevel": "none"}}))
+if has_conic("hpipm"):
+    variants.append(("hpipm", "hpipm", {}))
+    variants.append(("block5+hpipm", "condensing", {"qpsol": "hpipm", "block_size": 5}))
+
+nsim = 20
+for N in [10, 20, 40, 80]:
+    # Variables and constraints in stage-wise order
+    X = [MX.sym("X%d" % k, 2 * nm) for k in range(N + 1)]
+    U = [MX.sym("U%d" % k) for k in range(N)]
+    x_init = MX.sym("x_init", 2 * nm)
+    w = []
+    g = [X[0] - x_init]
+    for k in range(N):
+        w += [X[k], U[k]]
+        g.append(X[k + 1] - mtimes(A, X[k]) - mtimes(B, U[k]))
+    w.append(X[N])
+    w = vcat(w)
+    qp = {"x": w, "p": x_init, "f": sumsqr(w), "g": vcat(g)}
+    # |x| <= 1, |u| <= 1
+    lbw = -DM.ones(w.numel())
+    ubw = -lbw
+    for label, plugin, opts in variants:
+        opts = dict(opts, error_on_fail=False)
+        if plugin == "qrqp":
+            opts.update(print_header=False, print_iter=False)
+        elif "qpsol" in opts and opts["qpsol"] == "qrqp":
+            opts["qpsol_options"] = {"print_header": False, "print_iter": False}
+        t0 = time.time()
+        solver = qpsol("solver", plugin, qp, opts)
+        t_init = time.time() - t0
+        x = DM([0.4] + [0] * (2 * nm - 1))
+        nfail = 0
+        t0 = time.time()
+        for k in range(nsim):
+            sol = solver(p=x, lbx=lbw, ubx=ubw, lbg=0, ubg=0)
+            if not solver.stats()["success"]:
+                nfail += 1
+            x = mtimes(A, x) + mtimes(B, sol["x"][2 * nm])
+        t1 = time.time()
+        print("N = %3d  %-14s init: %7.3f s, time per solve: %8.3f ms, f = %g, failed: %d" % (
+              N, label, t_init, 1000 * (t1 - t0) / nsim, float(sol["f"]), nfail))
@@ -0,0 +1,63 @@
+from casadi import *
+import time
+
+# Sequence of nearby QPs: closed-loop MPC of a chain of masses with input bounds
+nm = 4
+N = 40
+dt = 0.1
+A = DM.zeros(2 * nm, 2 * nm)
+for i in range(nm):
+    A[i, nm + i] = 1
+    A[nm + i, i] = -2
+    if i > 0: A[nm + i, i - 1] = 1
+    if i < nm - 1: A[nm + i, i + 1] = 1
+A = DM.eye(2 * nm) + dt * A
+B = DM.zeros(2 * nm, 1)
+B[2 * nm - 1] = dt
+
+X = MX.sym("X", 2 * nm, N + 1)
+U = MX.sym("U", 1, N)
+x_init = MX.sym("x_init", 2 * nm)
+f = sumsqr(X) + 0.1 * sumsqr(U)
+g = [X[:, 0] - x_init]
+for k in range(N):
+    g.append(X[:, k + 1] - mtimes(A, X[:, k]) - mtimes(B, U[:, k]))
+w = veccat(X, U)
+qp = {"x": w, "p": x_init, "f": f, "g": vcat(g)}
+nw = w.numel()
+lbw = vertcat(-0.5 * DM.ones(X.numel()), -1 * DM.ones(U.numel()))
+ubw = -lbw
+
+variants = [("cold", {}), ("mcc", {"max_mcc": 3}),
+            ("warm", {"warm_start": True}),
+            ("warm+mcc", {"warm_start": True, "max_mcc": 3})]
+nsim = 50
+for label, opts in variants:
+    opts = dict(opts, print_header=False, print_iter=False)
+    solver = qpsol("solver", "ipqp", qp, opts)
+    x = DM([0.4] + [0] * (2 * nm - 1))
+    sol = {"x": DM.zeros(nw), "lam_x": DM.zeros(nw), "lam_g": DM.zeros(qp["g"].numel())}
+    n_iter = 0
+    t0 = time.time()
+    for k in range(nsim):
+        sol = solver(x0=sol["x"], lam_x0=sol["lam_x"], lam_g0=sol["lam_g"],
+                     p=x, lbx=lbw, ubx=ubw, lbg=0, ubg=0)
+        n_iter += solver.stats()["iter_count"]
+        x = mtimes(A, x) + mtimes(B, sol["x"][X.numel()])
+    t1 = time.time()
+    print("MPC   %-10s iterations: %5d, time: %8.3f ms" % (label, n_iter, 1000 * (t1 - t0)))
+
+# QP sequence of an SQP method: chained Rosenbrock problem
+n = 100
+x = MX.sym("x", n)
+f = sum1((1 - x[:-1])**2 + 100 * (x[1:] - x[:-1]**2)**2)
+nlp = {"x": x, "f": f, "g": x[1:]**2 - x[:-1]}
+for label, opts in variants:
+    opts = dict(opts, print_header=False, print_iter=False)
+    solver = nlpsol("solver", "sqpmethod", nlp, {"qpsol": "ipqp", "qpsol_options": opts,
+                    "print_header": False, "print_iteration": False, "print_time": False})
+    t0 = time.time()
+    sol = solver(x0=0.5, lbx=-2, ubx=2, lbg=-1, ubg=0.1)
+    t1 = time.time()
+    print("SQP   %-10s iterations: %5d, time: %8.3f ms, f = %g" % (
+          label, solver.stats()["iter_count"], 1000 * (t1 - t0), float(sol["f"])))
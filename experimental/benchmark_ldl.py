@@ -0,0 +1,63 @@
+from casadi import *
+import time
+
+# Compare sparse LDL^T variants on KKT systems of increasing size:
+# a banded Hessian coupled to a dense block of constraints
+def kkt(n, m):
+    sp = Sparsity.banded(n, 3)
+    H = DM(sp, 1)
+    H = H + H.T + 10 * DM.eye(n)
+    J = sparsify(DM.rand(m, n) > 0.5)
+    return blockcat([[H, J.T], [J, -DM.eye(m)]])
+
+solvers = [("ldl", {}), ("ldl", {"supernodal": True})]
+for plugin in ["ma27", "mumps"]:
+    if has_linsol(plugin):
+        solvers.append((plugin, {}))
+
+nrep = 10
+for n, m in [(500, 20), (2000, 50), (5000, 200)]:
+    A = kkt(n, m)
+    b = DM.rand(A.size1())
+    print("n = %d, m = %d, nnz(A) = %d" % (n, m, A.nnz()))
+    for plugin, opts in solvers:
+        s = Linsol("s", plugin, A.sparsity(), opts)
+        s.sfact(A)
+        t0 = time.time()
+        for i in range(nrep):
+            s.nfact(A)
+        t1 = time.time()
+        x = s.solve(A, b)
+        print("  %-6s %-22s nfact: %8.3f ms, residual: %.2e" % (plugin, str(opts),
+              1000 * (t1 - t0) / nrep, float(norm_inf(mtimes(A, x) - b))))
+
+# Fill-reducing orderings on 2D and 3D grid Laplacians
+def laplacian(N, dim):
+    L1 = Sparsity.banded(N, 1)
+    I = Sparsity.diag(N)
+    if dim == 2:
+        sp = kron(L1, I) + kron(I, L1)
+    else:
+        sp = kron(kron(L1, I), I) + kron(kron(I, L1), I) + kron(kron(I, I), L1)
+    return DM(sp, -1) + (2 * dim + 1) * DM.eye(sp.size1())
+
+for N, dim in [(30, 2), (100, 2), (12, 3), (20, 3)]:
+    A = laplacian(N, dim)
+    b = DM.rand(A.size1())
+    print("%dD grid, n = %d, nnz(A) = %d" % (dim, A.size1(), A.nnz()))
+    for ordering in ["amd", "nd"]:
+        t0 = time.time()
+        s = Linsol("s", "ldl", A.sparsity(), {"ordering": ordering})
+        t1 = time.time()
+        s.sfact(A)
+        t2 = time.time()
+        for i in range(nrep):
+            s.nfact(A)
+        t3 = time.time()
+        x = s.solve(A, b)
+        sp = A.sparsity()
+        p = sp.amd() if ordering == "amd" else sp.nested_dissection()
+        fill = sp.sub(p, p)[0].ldl(False)[0].nnz()
+        print("  %-4s nnz(L): %8d, symbolic: %8.3f ms, nfact: %8.3f ms, residual: %.2e" % (
+              ordering, fill, 1000 * (t1 - t0), 1000 * (t3 - t2) / nrep,
+              float(norm_inf(mtimes(A, x) - b))))
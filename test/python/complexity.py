@@ -241,6 +241,30 @@ class ComplexityTests(casadiTestCase):
       return {'f':f}
     self.complexity(setupfun,fun, 2)  # 1
 
+  def test_SX_graph(self):
+    self.message("SX graph construction and destruction")
+    def setupfun(self,N):
+      return {'x': SX.sym("x"), 'y': SX.sym("y")}
+    def fun(self,N,setup):
+      x = setup['x']
+      e = setup['y']
+      for i in range(N):
+        e = sin(e*x)+e
+    self.complexity(setupfun,fun, 1)
+
+    self.message("SXFunction construction and destruction")
+    def setupfun(self,N):
+      x = SX.sym("x")
+      y = SX.sym("y")
+      e = y
+      for i in range(N):
+        e = sin(e*x)+e
+      return {'x': x, 'y': y, 'e': e}
+    def fun(self,N,setup):
+      f = Function('f', [setup['x'],setup['y']],[setup['e']])
+      del f
+    self.complexity(setupfun,fun, 1)
+
   def test_DMdot(self):
     self.message("DM inner dot vectors")
     def setupfun(self,N):
@@ -946,6 +946,71 @@ class ConicTests(casadiTestCase):
         F,_ = self.check_codegen(solver,{},std="c99",opts={"verbose_runtime":True})
         #with self.assertOutput(["last_tau","Converged"],[]): # Printing, but not captured by python stdout
         #    F()
+
+  @requires_conic("qrqp")
+  def test_qrqp_reuse_factorization(self):
+    # Box-constrained least squares with a chain of coupling constraints
+    N = 20
+    x = MX.sym("x",N)
+    g = x[1:]-x[:-1]
+    qp = {"x":x,"f":sumsqr(x-DM(range(N))/4),"g":g}
+    opts = {"print_header":False,"print_iter":False}
+    ref = qpsol("ref","qrqp",qp,opts)
+    opts["reuse_factorization"] = True
+    solver = qpsol("solver","qrqp",qp,opts)
+
+    args = {"lbx":-1,"ubx":2,"lbg":-0.1,"ubg":0.1}
+    ref_out = ref(**args)
+    sol_out = solver(**args)
+    self.checkarray(sol_out["x"],ref_out["x"],digits=10)
+    self.checkarray(sol_out["lam_g"],ref_out["lam_g"],digits=10)
+    stats = solver.stats()
+    self.assertTrue(stats["success"])
+    self.assertEqual(stats["n_factorize"],1)
+    self.assertTrue(stats["n_update"]>0)
+
+    # Warm start from the previous solution with perturbed bounds
+    args.update(x0=sol_out["x"],lam_x0=sol_out["lam_x"],lam_g0=sol_out["lam_g"],ubx=2.1)
+    ref_out = ref(**args)
+    sol_out = solver(**args)
+    self.checkarray(sol_out["x"],ref_out["x"],digits=10)
+    self.assertEqual(solver.stats()["n_factorize"],0)
+
+    # Same result after serialization
+    solver2 = Function.deserialize(solver.serialize())
+    self.checkarray(solver2(**args)["x"],ref_out["x"],digits=10)
+
+  @requires_conic("ipqp")
+  def test_ipqp_warm_start(self):
+    N = 20
+    x = MX.sym("x",N)
+    p = MX.sym("p")
+    qp = {"x":x,"f":sumsqr(x-DM(range(N))/4),"g":x[1:]-x[:-1]}
+    opts = {"print_header":False,"print_iter":False}
+    ref = qpsol("ref","qrqp",qp,opts)
+    args = {"lbx":-1,"ubx":2,"lbg":-0.1,"ubg":0.1}
+    ref_out = ref(**args)
+
+    cold = qpsol("cold","ipqp",qp,opts)
+    cold_out = cold(**args)
+    self.checkarray(cold_out["x"],ref_out["x"],digits=6)
+    n_cold = cold.stats()["iter_count"]
+
+    # Multiple centrality correctors
+    mcc = qpsol("mcc","ipqp",qp,dict(opts,max_mcc=3))
+    self.checkarray(mcc(**args)["x"],ref_out["x"],digits=6)
+    self.assertTrue(mcc.stats()["iter_count"]<=n_cold)
+
+    # Warm start for a perturbed QP from the previous solution
+    warm = qpsol("warm","ipqp",qp,dict(opts,warm_start=True))
+    args.update(x0=cold_out["x"],lam_x0=cold_out["lam_x"],lam_g0=cold_out["lam_g"],ubx=2.1)
+    ref_out = ref(**args)
+    self.checkarray(cold(**args)["x"],ref_out["x"],digits=6)
+    self.checkarray(warm(**args)["x"],ref_out["x"],digits=6)
+    self.assertTrue(warm.stats()["iter_count"]<cold.stats()["iter_count"])
+
+    warm2 = Function.deserialize(warm.serialize())
+    self.checkarray(warm2(**args)["x"],ref_out["x"],digits=6)
     
     
 
@@ -1208,6 +1273,148 @@ class ConicTests(casadiTestCase):
     print("codegen starts here")   
     self.check_codegen(solver,dict(a=A,h=H,lba=lbg,uba=ubg,g=g,lbx=lbx,ubx=ubx,x0=sol["x"],lam_a0=sol["lam_a"],lam_x0=sol["lam_x"]),std="c99",extralibs=["hpipm","blasfeo"])
         
+  @requires_conic("hpipm")
+  def test_hpipm_permuted(self):
+    # Multiple shooting problem with variables ordered as [X(:);U(:)]
+    N, nx, nu = 5, 2, 1
+    X = MX.sym("X",nx,N+1)
+    U = MX.sym("U",nu,N)
+    Ad = DM([[1,0.1],[0.2,1]])
+    Bd = DM([[0.05],[0.1]])
+    g = [X[:,k+1]-mtimes(Ad,X[:,k])-mtimes(Bd,U[:,k]) for k in range(N)]
+    qp = {"x":vertcat(vec(X),vec(U)),"f":sumsqr(X)+0.1*sumsqr(U),"g":vcat(g[::-1]+[X[:,0]])}
+    lbg = vertcat(DM.zeros(N*nx),DM([1,0]))
+    options = {"hpipm":{"iter_max":100,"res_g_max":1e-10,"res_b_max":1e-10,"res_d_max":1e-10,"res_m_max":1e-10}}
+    solver = qpsol("solver","hpipm",qp,options)
+    solver_ref = qpsol("solver","qrqp",qp)
+    sol = solver(lbg=lbg,ubg=lbg,lbx=-0.8,ubx=0.8)
+    sol_ref = solver_ref(lbg=lbg,ubg=lbg,lbx=-0.8,ubx=0.8)
+    self.checkarray(sol_ref["x"], sol["x"],digits=7)
+    self.checkarray(sol_ref["lam_g"], sol["lam_g"],digits=7)
+    self.checkarray(sol_ref["lam_x"], sol["lam_x"],digits=7)
+    self.check_serialize(solver,dict(lbg=lbg,ubg=lbg,lbx=-0.8,ubx=0.8))
+
+  @requires_conic("condensing")
+  @requires_conic("qrqp")
+  def test_condensing(self):
+    N = 6
+    X = [MX.sym("X%d" % k,2) for k in range(N+1)]
+    U = [MX.sym("U%d" % k) for k in range(N)]
+    Ad = DM([[1,0.1],[0.2,1]])
+    Bd = DM([0.05,0.1])
+    g = [X[0]]
+    f = sumsqr(X[N])
+    for k in range(N):
+      g.append(X[k+1]-mtimes(Ad,X[k])-Bd*U[k])
+      g.append(X[k][0]+U[k])
+      f += sumsqr(X[k])+0.1*sumsqr(U[k])-2*X[k][1]
+    args = dict(lbg=vertcat(DM([0.5,0.3]),*[DM([0,0,-inf])]*N),ubg=vertcat(DM([0.5,0.3]),*[DM([0,0,0.9])]*N),lbx=-0.8,ubx=0.52)
+    qp_opts = {"print_header":False,"print_iter":False}
+    # Variables in stage-wise order and permuted
+    for w in [vcat(sum([[X[k],U[k]] for k in range(N)],[])+[X[N]]), vcat(X+U)]:
+      qp = {"x":w,"f":f,"g":vcat(g)}
+      sol_ref = qpsol("solver","qrqp",qp,qp_opts)(**args)
+      for block_size in [0, 1, 2, 4]:
+        solver = qpsol("solver","condensing",qp,{"qpsol":"qrqp","qpsol_options":qp_opts,"block_size":block_size})
+        sol = solver(**args)
+        self.checkarray(sol_ref["x"], sol["x"],digits=8)
+        self.checkarray(sol_ref["f"], sol["f"],digits=8)
+        self.checkarray(sol_ref["lam_g"], sol["lam_g"],digits=8)
+        self.checkarray(sol_ref["lam_x"], sol["lam_x"],digits=8)
+
+        # The condensed matrices are reused when only the vectors change
+        sol = solver(x0=sol["x"],lam_x0=sol["lam_x"],lam_g0=sol["lam_g"],**args)
+        self.checkarray(sol_ref["x"], sol["x"],digits=8)
+        self.assertEqual(solver.stats()["n_condense"],1)
+        self.assertEqual(solver.stats()["n_reuse"],1)
+        self.check_serialize(solver,args)
+
+      # The problem is printed in the original order
+      solver = qpsol("solver","condensing",qp,{"qpsol":"qrqp","qpsol_options":qp_opts,"print_problem":True})
+      solver_ref = qpsol("solver","qrqp",qp,dict(qp_opts,print_problem=True))
+      with capture_stdout() as out:
+        solver(**args)
+      with capture_stdout() as out_ref:
+        solver_ref(**args)
+      problem = lambda s: s[s.index("H:"):s.index("ubx:")]
+      self.assertEqual(problem(out[0]),problem(out_ref[0]))
+
+  def test_presolve(self):
+    x = MX.sym("x",5)
+    f = sumsqr(x-DM([1,2,3,4,5]))
+    # Duplicate (rows 0 and 1), singleton (row 2), empty once x[4] is fixed (row 3),
+    # redundant (row 4) and regular (row 5) constraints
+    g = vertcat(x[0]+x[1]+x[4], 2*x[0]+2*x[1], 3*x[2], 2*x[4], x[3]+x[2], x[0]-x[3])
+    args = dict(lbg=DM([-inf,-inf,-inf,0,-inf,-1]),ubg=DM([1,0.8,6,2,100,1]),
+                lbx=DM([-10,-10,-10,-10,0.5]),ubx=DM([10,10,10,10,0.5]))
+    qp = {"x":x,"f":f,"g":g}
+    for conic, qp_options, aux_options in conics:
+      if not aux_options["quadratic"] or not aux_options["dual"]: continue
+      print("test_presolve",conic,qp_options)
+      try:
+        less_digits=aux_options["less_digits"]
+      except:
+        less_digits=0
+      digits = max(1,6-less_digits)
+
+      sol_ref = qpsol("solver",conic,qp,qp_options)(**args)
+      solver = qpsol("solver",conic,qp,dict(qp_options,presolve=True))
+      sol = solver(**args)
+      self.checkarray(sol["x"],DM([0.8,-0.4,2,1.8,0.5]),conic,digits=digits)
+      for e in ["x","f","lam_g","lam_x"]:
+        self.checkarray(sol_ref[e],sol[e],conic,digits=digits)
+
+      stats = solver.stats()
+      self.assertTrue(stats["success"])
+      self.assertEqual(stats["presolve"]["n_fixed"],1)
+      self.assertEqual(stats["presolve"]["n_empty"],1)
+      self.assertEqual(stats["presolve"]["n_singleton"],1)
+      self.assertEqual(stats["presolve"]["n_duplicate"],1)
+      self.assertEqual(stats["presolve"]["n_redundant"],1)
+      self.assertEqual(stats["presolve"]["nx"],4)
+      self.assertEqual(stats["presolve"]["na"],2)
+      # Plugin statistics are those of the reduced problem
+      for k, v in stats["presolve"]["solver_stats"].items():
+        if not k.startswith(("n_call_","t_wall_","t_proc_")): self.assertEqual(stats[k],v)
+      self.check_serialize(solver,args)
+
+      # Alternate between two reductions with room for a single reduced solver
+      solver = qpsol("solver",conic,qp,dict(qp_options,presolve=True,presolve_max_solvers=1))
+      args2 = dict(args,lbx=DM([-10,-10,-10,1,0.5]),ubx=DM([10,10,10,1,0.5]))
+      sol2_ref = qpsol("solver",conic,qp,qp_options)(**args2)
+      for i in range(2):
+        self.checkarray(solver(**args)["x"],sol_ref["x"],conic,digits=digits)
+        self.checkarray(solver(**args2)["x"],sol2_ref["x"],conic,digits=digits)
+
+  @requires_conic("hpipm")
+  @requires_conic("qrqp")
+  def test_presolve_structure(self):
+    # Stage-wise problem with explicit structure and a duplicate constraint in stage 0
+    N = 4
+    X = [MX.sym("X%d" % k,2) for k in range(N+1)]
+    U = [MX.sym("U%d" % k) for k in range(N)]
+    Ad = DM([[1,0.1],[0.2,1]])
+    Bd = DM([0.05,0.1])
+    g = []
+    f = sumsqr(X[N]-1)
+    for k in range(N):
+      g.append(mtimes(Ad,X[k])+Bd*U[k]-X[k+1])
+      g.append(X[k][0]+U[k])
+      if k==0: g.append(2*X[k][0]+2*U[k])
+      f += sumsqr(X[k]-1)+0.1*sumsqr(U[k])
+    qp = {"x":vcat(sum([[X[k],U[k]] for k in range(N)],[])+[X[N]]),"f":f,"g":vcat(g)}
+    args = dict(lbg=vertcat(DM([0,0,-inf,-inf]),*[DM([0,0,-inf])]*(N-1)),
+                ubg=vertcat(DM([0,0,0.5,1.2]),*[DM([0,0,0.5])]*(N-1)),lbx=-2,ubx=2)
+    options = {"N":N,"nx":[2]*(N+1),"nu":[1]*N+[0],"ng":[2]+[1]*(N-1)+[0],
+               "hpipm":{"iter_max":100,"res_g_max":1e-10,"res_b_max":1e-10,"res_d_max":1e-10,"res_m_max":1e-10}}
+    sol_ref = qpsol("solver","qrqp",qp,{"print_iter":False,"print_header":False})(**args)
+    # The structure options do not match the reduced problem and are not passed on
+    solver = qpsol("solver","hpipm",qp,dict(options,presolve=True))
+    sol = solver(**args)
+    self.assertEqual(solver.stats()["presolve"]["n_duplicate"],1)
+    for e in ["x","f","lam_g","lam_x"]:
+      self.checkarray(sol_ref[e],sol[e],digits=7)
+
   @requires_nlpsol("ipopt")
   def test_SOCP(self):
 
@@ -2152,6 +2152,33 @@ class Functiontests(casadiTestCase):
         self.assertTrue("-1e-07," in out[0] or "-1e-007," in out[0] )
         self.assertTrue("1e-07," in out[0] or "1e-007," in out[0] )
 
+  def test_factory_hvp(self):
+    for X in [SX,MX]:
+      x = X.sym("x",3)
+      p = X.sym("p")
+      f = Function("f",[x,p],[p*sin(x[0])*x[1]**2+exp(x[2]*x[0])],["x","p"],["f"])
+      H = Function("H",[x,p],[hessian(f(x,p),x)[0]])
+      x0 = vertcat(1.1,0.7,-0.3)
+      v = DM([[1,0.3],[-2,0.5],[0.1,4]])
+
+      hvp = f.factory("hvp",["x","p","fwd:x"],["hvp:f:x"])
+      self.assertEqual(hvp.size_in(2),(3,1))
+      self.checkarray(hvp(x0,2,v[:,0]),mtimes(H(x0,2),v[:,0]))
+
+      hvp = f.factory("hvp",["x","p","fwd:x"],["hvp:f:x"],{"hvp_ndir":2})
+      self.assertEqual(hvp.size_in(2),(3,2))
+      self.checkarray(hvp(x0,2,v),mtimes(H(x0,2),v))
+
+      # Direction input added by the factory, or listed after other inputs
+      q = X.sym("q")
+      g = Function("g",[x,p,q],[p*q*dot(x,x)*x[0]],["x","p","q"],["f"])
+      hvp = g.factory("hvp",["x","p","q"],["hvp:f:x"])
+      self.assertEqual(hvp.n_in(),3)
+      self.checkarray(hvp(x0,2,3),DM.zeros(3))
+      Hg = Function("Hg",[x,p,q],[hessian(g(x,p,q),x)[0]])
+      hvp = g.factory("hvp",["fwd:x","q","x","p"],["hvp:f:x"])
+      self.checkarray(hvp(v[:,0],3,x0,2),mtimes(Hg(x0,2,3),v[:,0]))
+
   @requires_nlpsol("ipopt")
   @requiresPlugin(Importer,"shell")
   def test_inherit_jit_options(self):
@@ -303,6 +303,28 @@ class ImplicitFunctiontests(casadiTestCase):
       with self.assertInException("process"):
         solver(x0=0)
 
+  def test_tearing(self):
+    # Lower block triangular system: a scalar, a 2x2 block and another scalar
+    x = SX.sym("x",4)
+    p = SX.sym("p")
+    g = vertcat(x[0]**3+x[0]-p,
+                x[1]+sin(x[2])-x[0],
+                x[2]**3+x[1]-2*x[0],
+                exp(x[3])-x[2]-x[0]**2)
+    ref = rootfinder("ref","newton",{"x":x,"p":p,"g":g})
+    for Solver, options, features in solvers:
+      if Solver in ["kinsol","nlpsol"]: continue
+      opts = dict(options)
+      opts["tearing"] = True
+      solver = rootfinder("solver",Solver,{"x":x,"p":p,"g":g},opts)
+      self.checkfunction(solver,ref,inputs=[DM([0.1,0.1,0.1,0.1]),0.7],digits=8)
+      self.check_serialize(solver,inputs=[DM([0.1,0.1,0.1,0.1]),0.7])
+      solver(x0=0.1,p=0.7)
+      self.assertEqual(solver.stats()["n_call_tearing_aux"],1)
+    # Block linear solver
+    solver = rootfinder("solver","newton",{"x":x,"p":p,"g":g},{"linear_solver":"btf"})
+    self.checkfunction(solver,ref,inputs=[DM([0.1,0.1,0.1,0.1]),0.7],digits=8)
+
   def test_loop(self):
     x=SX.sym("x")
     for Solver, options, features in solvers:
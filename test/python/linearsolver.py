@@ -84,12 +84,24 @@ except:
 try:
   load_linsol("qr")
   lsolvers.append(("qr",{},set()))
+  lsolvers.append(("qr",{"max_threads":2,"subtree_cutoff":1},set()))
+  lsolvers.append(("qr",{"ordering":"nd"},set()))
+except:
+  pass
+
+try:
+  load_linsol("btf")
+  lsolvers.append(("btf",{},set()))
+  lsolvers.append(("btf",{"max_threads":2,"linear_solver":"lapacklu"},set()))
 except:
   pass
 
 try:
   load_linsol("ldl")
   lsolvers.append(("ldl",{},{"posdef","symmetry"}))
+  lsolvers.append(("ldl",{"supernodal":True},{"posdef","symmetry"}))
+  lsolvers.append(("ldl",{"max_threads":2,"subtree_cutoff":1},{"posdef","symmetry"}))
+  lsolvers.append(("ldl",{"ordering":"nd"},{"posdef","symmetry"}))
 except:
   pass
 
@@ -546,6 +558,227 @@ class LinearSolverTests(casadiTestCase):
         self.checkarray(A,B)
 
 
+  @requires_linsol("ldl")
+  def test_ldl_supernodal(self):
+    numpy.random.seed(0)
+    # KKT-like matrix: banded blocks coupled by a dense separator
+    n = 30
+    H = DM(Sparsity.banded(n,2),numpy.random.rand(Sparsity.banded(n,2).nnz()))
+    H = H+H.T+10*DM.eye(n)
+    J = DM.rand(4,n)
+    A = blockcat([[H,J.T],[J,-DM.eye(4)]])
+    b = DM.rand(n+4,3)
+    solver = Linsol("solver","ldl",A.sparsity(),{"supernodal":True})
+    solver.sfact(A)
+    solver.nfact(A)
+    self.checkarray(solver.solve(A,b),solve(A,b),digits=10)
+    self.assertEqual(solver.neig(A),4)
+    self.assertEqual(solver.rank(A),n+4)
+    Ab = MX.sym("A",A.sparsity())
+    bb = MX.sym("b",b.shape)
+    f = Function("f",[Ab,bb],[solve(Ab,bb,"ldl",{"supernodal":True})])
+    self.checkarray(f(A,b),solve(A,b),digits=10)
+    self.check_codegen(f,inputs=[A,b])
+    self.check_serialize(f,inputs=[A,b])
+
+  def test_btf(self):
+    numpy.random.seed(2)
+    # Block lower triangular matrix with scalar and 3x3 diagonal blocks, permuted
+    blocks = [DM.rand(1,1)+1, DM.rand(3,3)+3*DM.eye(3), DM.rand(1,1)+1, DM.rand(3,3)+3*DM.eye(3)]
+    A = diagcat(*blocks)
+    A[4:,0] = DM.rand(4,1)
+    A[7,2] = 1
+    p = [3,0,7,5,1,6,2,4]
+    A = A[p,p[::-1]]
+    b = DM.rand(8,2)
+    for opts in [{},{"max_threads":2}]:
+      solver = Linsol("solver","btf",A.sparsity(),opts)
+      solver.sfact(A)
+      solver.nfact(A)
+      self.checkarray(solver.solve(A,b),solve(A,b),digits=10)
+      self.checkarray(solver.solve(A,b,True),solve(A.T,b),digits=10)
+      self.assertEqual(solver.rank(A),8)
+      Ab = MX.sym("A",A.sparsity())
+      bb = MX.sym("b",b.shape)
+      f = Function("f",[Ab,bb],[solve(Ab,bb,"btf",opts),solve(Ab.T,bb,"btf",opts)])
+      self.checkfunction_light(f,Function("r",[Ab,bb],[solve(Ab,bb),solve(Ab.T,bb)]),inputs=[A,b],digits=10)
+      self.check_serialize(f,inputs=[A,b])
+
+  @requires_linsol("blocktridiag")
+  def test_blocktridiag(self):
+    numpy.random.seed(4)
+    # Stage blocks coupled to their neighbours, as in multiple shooting
+    nx, N = 3, 6
+    A = diagcat(*[DM.rand(nx,nx)+nx*DM.eye(nx) for i in range(N)])
+    for i in range(N-1):
+      A[(i+1)*nx:(i+2)*nx,i*nx:(i+1)*nx] = DM.rand(nx,nx)
+      A[i*nx:(i+1)*nx,(i+1)*nx:(i+2)*nx] = DM.rand(nx,nx)
+    b = DM.rand(N*nx,2)
+    for opts in [{},{"block_sizes":[nx]*N},{"block_sizes":[2*nx]*(N//2)}]:
+      solver = Linsol("solver","blocktridiag",A.sparsity(),opts)
+      solver.sfact(A)
+      solver.nfact(A)
+      self.checkarray(solver.solve(A,b),solve(A,b),digits=10)
+      self.checkarray(solver.solve(A,b,True),solve(A.T,b),digits=10)
+      Ab = MX.sym("A",A.sparsity())
+      bb = MX.sym("b",b.shape)
+      f = Function("f",[Ab,bb],[solve(Ab,bb,"blocktridiag",opts),solve(Ab.T,bb,"blocktridiag",opts)])
+      self.checkfunction_light(f,Function("r",[Ab,bb],[solve(Ab,bb),solve(Ab.T,bb)]),inputs=[A,b],digits=10)
+      self.check_codegen(f,inputs=[A,b])
+      self.check_serialize(f,inputs=[A,b])
+    with self.assertRaises(Exception):
+      Linsol("solver","blocktridiag",A.sparsity(),{"block_sizes":[1]*(N*nx)})
+
+    # Linear solver of a rootfinder
+    x = MX.sym("x",N*nx)
+    g = Function("g",[x],[mtimes(A,x)+0.1*sin(x)-b[:,0]])
+    rf = rootfinder("rf","newton",g,{"linear_solver":"blocktridiag"})
+    self.checkarray(g(rf(DM.zeros(N*nx))),DM.zeros(N*nx),digits=8)
+
+    # Linear solver of the interior point QP solver
+    x = SX.sym("x",6)
+    qp = {"x":x,"f":sumsqr(x-1)+dot(x[:-1],x[1:]),"g":x[1:]-x[:-1]}
+    ref = qpsol("ref","qrqp",qp,{"print_iter":False,"print_header":False})(lbg=-0.1,ubg=0.1)
+    opts = {"linear_solver":"blocktridiag","print_iter":False,"print_header":False,"print_info":False}
+    sol = qpsol("sol","ipqp",qp,opts)(lbg=-0.1,ubg=0.1)
+    self.checkarray(sol["x"],ref["x"],digits=6)
+
+  def test_map_batched(self):
+    numpy.random.seed(6)
+    n, N = 5, 100
+    A = MX.sym("A",n,n)
+    b = MX.sym("b",n,2)
+    As = [DM.rand(n,n)+n*DM.eye(n) for i in range(N)]
+    bs = [DM.rand(n,2) for i in range(N)]
+    for plugin in ["qr","ldl","lapacklu","csparsecholesky"]:
+      if not has_linsol(plugin): continue
+      Ai = [mtimes(e,e.T) for e in As] if plugin=="csparsecholesky" else As
+      f = Function("f",[A,b],[solve(A,b,plugin)])
+      F = f.map(N)
+      self.assertTrue(F.is_a("BatchSolveMap"))
+      self.checkarray(F(hcat(Ai),hcat(bs)),hcat([solve(e,r) for e,r in zip(Ai,bs)]),digits=10)
+      # Right-hand-side first
+      g = Function("g",[b,A],[solve(A,b,plugin)])
+      G = g.map(N)
+      self.assertTrue(G.is_a("BatchSolveMap"))
+      self.checkarray(G(hcat(bs),hcat(Ai)),F(hcat(Ai),hcat(bs)),digits=10)
+      self.check_serialize(F,inputs=[hcat(Ai),hcat(bs)])
+      # Derivatives go through the regular path
+      J = F.jacobian()
+      self.checkarray(J(hcat(Ai),hcat(bs),0)[1],f.map(N,"unroll").jacobian()(hcat(Ai),hcat(bs),0)[1],digits=8)
+    # Not a single solve on the inputs
+    h = Function("h",[A,b],[solve(A+DM.eye(n),b)])
+    self.assertFalse(h.map(N).is_a("BatchSolveMap"))
+    # Triangular patterns of symmetric solvers
+    A = MX.sym("A",Sparsity.upper(3))
+    b = MX.sym("b",3)
+    A0 = DM(Sparsity.upper(3),[4,1,5,1,1,6])
+    b0 = DM([1,2,3])
+    for plugin in ["csparsecholesky","qr"]:
+      if not has_linsol(plugin): continue
+      f = Function("f",[A,b],[solve(A,b,plugin)])
+      F = f.map(4)
+      self.assertTrue(F.is_a("BatchSolveMap"))
+      self.checkarray(F(repmat(A0,1,4),repmat(b0,1,4)),repmat(f(A0,b0),1,4),digits=10)
+      self.checkarray(F(repmat(A0,1,4),repmat(b0,1,4)),
+                      f.map(4,"unroll")(repmat(A0,1,4),repmat(b0,1,4)),digits=10)
+
+  def test_symbolic_cache(self):
+    numpy.random.seed(3)
+    A = DM(Sparsity.banded(40,2),numpy.random.rand(Sparsity.banded(40,2).nnz()))
+    A = A+A.T+10*DM.eye(40)
+    b = DM.rand(40)
+    for plugin in ["ldl","qr"]:
+      if not has_linsol(plugin): continue
+      for opts in [{},{"ordering":"nd"},{"symbolic_cache":False}]:
+        solvers = [Linsol("s%d" % i,plugin,A.sparsity(),opts) for i in range(3)]
+        for s in solvers:
+          self.checkarray(s.solve(A,b),solve(A,b),digits=10)
+      # Different pattern, same options
+      B = A[:30,:30]
+      self.checkarray(Linsol("s",plugin,B.sparsity()).solve(B,b[:30]),solve(B,b[:30]),digits=10)
+      # Deserialized solvers share the analysis as well
+      Ab = MX.sym("A",A.sparsity())
+      f = Function("f",[Ab],[solve(Ab,b,plugin)])
+      with capture_stdout() as out:
+        g = Function.deserialize(f.serialize())
+        Linsol("s",plugin,A.sparsity(),{"verbose":True})
+      self.assertTrue("Reusing symbolic analysis" in out[0])
+      self.checkarray(g(A),solve(A,b),digits=10)
+
+  def test_mixed_precision(self):
+    numpy.random.seed(5)
+    A = DM(Sparsity.banded(30,2),numpy.random.rand(Sparsity.banded(30,2).nnz()))
+    A = A+A.T+5*DM.eye(30)
+    b = DM.rand(30,2)
+    for plugin in ["ldl","qr","lapacklu"]:
+      if not has_linsol(plugin): continue
+      for opts in [{"mixed_precision":True},{"mixed_precision":True,"max_threads":2}]:
+        if plugin=="lapacklu" and "max_threads" in opts: continue
+        solver = Linsol("solver",plugin,A.sparsity(),opts)
+        solver.sfact(A)
+        solver.nfact(A)
+        for tr in [False,True]:
+          self.checkarray(solver.solve(A,b,tr),solve(A.T if tr else A,b),digits=12)
+        stats = solver.stats()
+        self.assertTrue(stats["refine_iter"]>=1)
+        self.assertTrue(stats["refine_residual"]<1e-12)
+        Ab = MX.sym("A",A.sparsity())
+        f = Function("f",[Ab],[solve(Ab,b,plugin,opts)])
+        self.checkarray(f(A),solve(A,b),digits=12)
+        self.check_serialize(f,inputs=[A])
+    with self.assertRaises(Exception):
+      Linsol("solver","symbolicqr",A.sparsity(),{"mixed_precision":True})
+
+  def test_etree_parallel(self):
+    numpy.random.seed(1)
+    # Block arrow matrix: independent diagonal blocks coupled through the last rows
+    B = [DM.rand(6,6)+6*DM.eye(6) for i in range(5)]
+    C = DM.rand(3,30)
+    A = blockcat([[diagcat(*[b+b.T for b in B]),C.T],[C,-DM.eye(3)]])
+    b = DM.rand(33,2)
+    for plugin in ["ldl","qr"]:
+      if not has_linsol(plugin): continue
+      for opts in [{"max_threads":4,"subtree_cutoff":1},{"max_threads":3,"subtree_cutoff":4}]:
+        solver = Linsol("solver",plugin,A.sparsity(),opts)
+        solver.sfact(A)
+        solver.nfact(A)
+        self.checkarray(solver.solve(A,b),solve(A,b),digits=10)
+        Ab = MX.sym("A",A.sparsity())
+        f = Function("f",[Ab],[solve(Ab,b,plugin,opts)])
+        self.checkarray(f(A),solve(A,b),digits=10)
+        self.check_serialize(f,inputs=[A])
+
+  def test_etree_tasks(self):
+    # Two subtrees of 10 columns and four of 2 columns
+    def tri(k):
+      return sparsify(DM(numpy.eye(k)*4+numpy.eye(k,k,1)+numpy.eye(k,k,-1)))
+    A = diagcat(tri(10),tri(10),tri(2),tri(2),tri(2),tri(2))
+    b = DM.ones(28,1)
+    for cutoff, serial in [(5,8),(1,0)]:
+      opts = {"ordering":"none","max_threads":2,"subtree_cutoff":cutoff,"verbose":True}
+      with capture_stdout() as out:
+        solver = Linsol("solver","ldl",A.sparsity(),opts)
+        x = solver.solve(A,b)
+      self.assertTrue("2 parallel tasks, %d of 28 columns factorized serially" % serial in out[0])
+      self.checkarray(x,solve(A,b),digits=10)
+
+  def test_reuse_factorization(self):
+    numpy.random.seed(7)
+    A = DM.rand(4,4)+4*DM.eye(4)
+    b = DM.rand(4,2)
+    solver = Linsol("solver","qr",A.sparsity(),{"reuse_factorization":True})
+    self.checkarray(solver.solve(A,b),solve(A,b),digits=10)
+    self.checkarray(solver.solve(A,b),solve(A,b),digits=10)
+    self.assertEqual(solver.stats(0)["n_reuse"],1)
+    # Changed nonzeros must trigger a new factorization
+    A[0,0] = 10
+    self.checkarray(solver.solve(A,b),solve(A,b),digits=10)
+    self.assertEqual(solver.stats(0)["n_reuse"],1)
+    Ab = MX.sym("A",A.sparsity())
+    f = Function("f",[Ab],[solve(Ab,b,"qr",{"reuse_factorization":True})])
+    self.check_serialize(f,inputs=[A])
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -1589,6 +1589,237 @@ class NLPtests(casadiTestCase):
 
       self.checkfunction_light(f,f2,[0,0.5],digits=6)
 
+  @requires_conic("qrqp")
+  def test_sqp_concurrent_oracle(self):
+    x = MX.sym("x",5)
+    nlp = {"x":x,"f":sum1((1-x[:-1])**2+100*(x[1:]-x[:-1]**2)**2),"g":x[1:]**2-x[:-1]}
+    opts = {"qpsol":"qrqp","qpsol_options":{"print_iter":False,"print_header":False},
+            "print_header":False,"print_iteration":False,"print_time":False}
+    for plugin in ["sqpmethod","feasiblesqpmethod"]:
+      ref = nlpsol("ref", plugin, nlp, opts)
+      res_ref = ref(x0=0.5,lbg=-1,ubg=0.1)
+      for nt in [2, 3, 8]:
+        solver = nlpsol("solver", plugin, nlp, dict(opts,max_num_threads=nt))
+        res = solver(x0=0.5,lbg=-1,ubg=0.1)
+        self.checkarray(res["x"],res_ref["x"],digits=10)
+        self.assertEqual(solver.stats()["iter_count"],ref.stats()["iter_count"])
+        self.assertEqual(solver.stats()["n_call_nlp_hess_l"]>0,True)
+    with self.assertInException("max_num_threads"):
+      nlpsol("solver", "sqpmethod", nlp, dict(opts,max_num_threads=0))
+
+  @requires_conic("qrqp")
+  def test_sqp_batch_linesearch(self):
+    x = MX.sym("x",5)
+    nlp = {"x":x,"f":sum1((1-x[:-1])**2+100*(x[1:]-x[:-1]**2)**2),"g":x[1:]**2-x[:-1]}
+    opts = {"qpsol":"qrqp","qpsol_options":{"print_iter":False,"print_header":False},
+            "print_header":False,"print_iteration":False,"print_time":False,"max_iter_ls":8}
+    for hess in ["exact","limited-memory"]:
+      ref = nlpsol("ref", "sqpmethod", nlp, dict(opts,hessian_approximation=hess))
+      res_ref = ref(x0=-1.2,lbg=-1,ubg=0.1)
+      for nt, nb in [(1, 3), (2, 3), (4, 8)]:
+        solver = nlpsol("solver", "sqpmethod", nlp,
+          dict(opts,hessian_approximation=hess,max_num_threads=nt,max_batch_ls=nb))
+        res = solver(x0=-1.2,lbg=-1,ubg=0.1)
+        self.checkarray(res["x"],res_ref["x"],digits=10)
+        self.assertEqual(solver.stats()["iter_count"],ref.stats()["iter_count"])
+    with self.assertInException("max_batch_ls"):
+      nlpsol("solver", "sqpmethod", nlp, dict(opts,max_batch_ls=0))
+
+  def test_sqp_rti(self):
+    x = MX.sym("x",5)
+    nlp = {"x":x,"f":sum1((1-x[:-1])**2+100*(x[1:]-x[:-1]**2)**2),"g":x[1:]**2-x[:-1]}
+    opts = {"qpsol":"qrqp","qpsol_options":{"print_iter":False,"print_header":False},
+            "print_header":False,"print_iteration":False,"print_time":False,"calc_lam_p":False}
+    # One real-time iteration is a full SQP step
+    ref = nlpsol("ref", "sqpmethod", nlp, dict(opts,max_iter=1,max_iter_ls=0))
+    res_ref = ref(x0=0.5,lbx=[0.7,-2,-2,-2,-2],ubx=[0.7,2,2,2,2],lbg=-1,ubg=0.1)
+    solver = nlpsol("solver", "sqpmethod", nlp, dict(opts,rti=True))
+    res = solver(x0=0.5,lbx=[0.7,-2,-2,-2,-2],ubx=[0.7,2,2,2,2],lbg=-1,ubg=0.1)
+    self.checkarray(res["x"],res_ref["x"],digits=10)
+    self.checkarray(res["lam_g"],res_ref["lam_g"],digits=10)
+
+    # Split in preparation and feedback, new bounds only known at feedback
+    solver = nlpsol("solver", "sqpmethod", nlp, dict(opts,rti=True,rti_split=True))
+    res_prep = solver(x0=0.5,lam_x0=0,lam_g0=0)
+    self.checkarray(res_prep["x"],0.5*DM.ones(5))
+    self.assertEqual(solver.stats()["return_status"],"Preparation_Finished")
+    res = solver(lbx=[0.7,-2,-2,-2,-2],ubx=[0.7,2,2,2,2],lbg=-1,ubg=0.1)
+    self.checkarray(res["x"],res_ref["x"],digits=10)
+    stats = solver.stats()
+    self.assertEqual(stats["n_call_feedback"],1)
+    self.assertEqual(stats["n_call_preparation"],0)
+    self.assertEqual(stats["n_call_nlp_jac_fg"],0)
+
+    # Repeated real-time iterations converge to the solution
+    ref = nlpsol("ref", "sqpmethod", nlp, opts)
+    res_ref = ref(x0=0.5,lbx=[0.7,-2,-2,-2,-2],ubx=[0.7,2,2,2,2],lbg=-1,ubg=0.1)
+    res = {"x":0.5,"lam_x":0,"lam_g":0}
+    for i in range(30):
+      solver(x0=res["x"],lam_x0=res["lam_x"],lam_g0=res["lam_g"])
+      res = solver(lbx=[0.7,-2,-2,-2,-2],ubx=[0.7,2,2,2,2],lbg=-1,ubg=0.1)
+    self.checkarray(res["x"],res_ref["x"],digits=6)
+
+    # A parameter change since the preparation phase enters to first order,
+    # exact for derivatives affine in p
+    x = MX.sym("x",2)
+    p = MX.sym("p")
+    nlp = {"x":x,"p":p,"f":sumsqr(x)+p*x[0]+x[0]**4,"g":vertcat(x[0]+x[1]+p,x[0]*x[1])}
+    solver = nlpsol("solver", "sqpmethod", nlp, dict(opts,rti=True))
+    solver_split = nlpsol("solver", "sqpmethod", nlp, dict(opts,rti=True,rti_split=True))
+    res_ref = solver(x0=[0.5,0.2],p=1.7,lbg=[-10,-1],ubg=1)
+    solver_split(x0=[0.5,0.2],p=1)
+    res = solver_split(p=1.7,lbg=[-10,-1],ubg=1)
+    for k in ["x","f","g","lam_g"]:
+      self.checkarray(res[k],res_ref[k],digits=10)
+    self.check_serialize(solver_split,inputs={"x0":[0.5,0.2],"p":1.7,"lbg":[-10,-1],"ubg":1})
+
+    with self.assertInException("exact"):
+      nlpsol("solver", "sqpmethod", nlp, dict(opts,rti=True,hessian_approximation="limited-memory"))
+
+  @requires_conic("condensing")
+  @requires_conic("qrqp")
+  def test_sqp_rti_condensing(self):
+    N = 5
+    X = [MX.sym("X%d" % k,2) for k in range(N+1)]
+    U = [MX.sym("U%d" % k) for k in range(N)]
+    p = MX.sym("p",2)
+    f = sumsqr(X[N])
+    g = [X[0]-p]
+    for k in range(N):
+      g.append(X[k+1]-X[k]-0.1*vertcat(X[k][1],sin(X[k][0])+U[k]))
+      f += sumsqr(X[k])+0.1*sumsqr(U[k])
+    nlp = {"x":vcat(sum([[X[k],U[k]] for k in range(N)],[])+[X[N]]),"p":p,"f":f,"g":vcat(g)}
+    qp_opts = {"print_iter":False,"print_header":False}
+    opts = {"rti":True,"rti_split":True,"print_header":False,"print_iteration":False,"print_time":False}
+    solver = nlpsol("solver","sqpmethod",nlp,dict(opts,qpsol="condensing",qpsol_options={"qpsol":"qrqp","qpsol_options":qp_opts}))
+    ref = nlpsol("ref","sqpmethod",nlp,dict(opts,qpsol="qrqp",qpsol_options=qp_opts))
+    args = dict(x0=0.1,p=[0.5,0.2],lbg=0,ubg=0,lbx=-1,ubx=1)
+    # The matrices are condensed in the preparation phase, the feedback phase reuses them
+    for s in [solver, ref]: s(**args)
+    self.assertEqual(solver.stats()["qpsol_stats"]["n_condense"],1)
+    self.assertEqual(solver.stats()["qpsol_stats"]["n_reuse"],0)
+    args["p"] = [0.6,0.1]
+    sol, sol_ref = solver(**args), ref(**args)
+    self.checkarray(sol["x"],sol_ref["x"],digits=8)
+    self.assertEqual(solver.stats()["qpsol_stats"]["n_condense"],1)
+    self.assertEqual(solver.stats()["qpsol_stats"]["n_reuse"],1)
+
+  def test_warm_start_cache(self):
+    x = MX.sym("x",2)
+    p = MX.sym("p")
+    nlp = {"x":x,"p":p,"f":(x[0]-p)**2+100*(x[1]-x[0]**2)**2,"g":x[0]+x[1]}
+    opts = {"qpsol":"qrqp","qpsol_options":{"print_iter":False,"print_header":False},
+            "print_header":False,"print_iteration":False,"print_time":False}
+    ref = nlpsol("ref", "sqpmethod", nlp, opts)
+    solver = nlpsol("solver", "sqpmethod", nlp, dict(opts,warm_start_cache=3))
+    ps = [1.0, 1.3, 0.8, 1.05, 0.95, 1.25]
+    for i, pv in enumerate(ps):
+      res = solver(x0=0,p=pv,lbg=-10,ubg=10)
+      res_ref = ref(x0=0,p=pv,lbg=-10,ubg=10)
+      self.checkarray(res["x"],res_ref["x"],digits=6)
+      self.assertEqual(solver.stats()["warm_start_cache"]["hit"],i>0)
+    stats = solver.stats()["warm_start_cache"]
+    self.assertEqual(stats["n_entries"],3)
+    self.assertEqual(stats["n_lookup"],len(ps))
+    self.assertEqual(stats["n_hit"],len(ps)-1)
+    self.assertTrue(stats["iter_count_hit"]<stats["iter_count_miss"])
+    self.assertTrue(stats["iter_saved"]>0)
+
+    # Nothing cached close enough
+    solver = nlpsol("solver", "sqpmethod", nlp, dict(opts,warm_start_cache=3,warm_start_cache_radius=0.1))
+    solver(x0=0,p=1,lbg=-10,ubg=10)
+    solver(x0=0,p=2,lbg=-10,ubg=10)
+    self.assertFalse(solver.stats()["warm_start_cache"]["hit"])
+    solver(x0=0,p=1.05,lbg=-10,ubg=10)
+    self.assertTrue(solver.stats()["warm_start_cache"]["hit"])
+
+    # On-disk store
+    import tempfile
+    fname = os.path.join(tempfile.mkdtemp(), "cache.txt")
+    solver = nlpsol("solver", "sqpmethod", nlp, dict(opts,warm_start_cache=3,warm_start_cache_file=fname))
+    solver(x0=0,p=1,lbg=-10,ubg=10)
+    solver = nlpsol("solver", "sqpmethod", nlp, dict(opts,warm_start_cache=3,warm_start_cache_file=fname))
+    res = solver(x0=0,p=1.1,lbg=-10,ubg=10)
+    self.assertTrue(solver.stats()["warm_start_cache"]["hit"])
+    self.checkarray(res["x"],ref(x0=0,p=1.1,lbg=-10,ubg=10)["x"],digits=6)
+    # The file holds at most twice the number of entries in memory
+    for pv in [1.2, 1.3, 1.4, 1.5, 1.6]:
+      solver(x0=0,p=pv,lbg=-10,ubg=10)
+    with open(fname) as f:
+      self.assertTrue(len(f.readlines())<=6)
+
+  def test_nlpsol_batch(self):
+    x = MX.sym("x")
+    p = MX.sym("p")
+    opts = {"qpsol":"qrqp","qpsol_options":{"print_iter":False,"print_header":False},
+            "print_header":False,"print_iteration":False,"print_time":False}
+    # Multi-start: two local minima, the global one near x=-1
+    solver = nlpsol("solver", "sqpmethod", {"x":x,"f":(x**2-1)**2+0.1*x}, opts)
+    X0 = DM([[2, -2, 1.5, -1.5]])
+    for nt in [1, 2, 4, 8]:
+      batch = nlpsol_batch("batch", solver, 4, {"max_num_threads":nt})
+      res = batch(x0=X0)
+      for k in range(4):
+        self.checkarray(res["x"][k],solver(x0=X0[k])["x"],digits=10)
+      stats = batch.stats()
+      self.assertEqual(len(stats["solves"]),4)
+      self.assertEqual(stats["n_success"],4)
+      self.assertTrue(stats["best"] in [1, 3])
+      best = nlpsol_batch("best", solver, 4, {"max_num_threads":nt,"best":True})
+      res_best = best(x0=X0)
+      self.checkarray(res_best["x"],res["x"][stats["best"]],digits=10)
+      self.assertTrue(float(res_best["x"])<0)
+
+    # Scenario sweep over parameters and bounds
+    solver = nlpsol("solver", "sqpmethod", {"x":x,"p":p,"f":(x-p)**2}, opts)
+    batch = nlpsol_batch("batch", solver, 3, {"max_num_threads":2})
+    res = batch(p=DM([[1,2,3]]),ubx=DM([[10,10,2.5]]))
+    self.checkarray(res["x"],DM([[1,2,2.5]]),digits=8)
+
+  def test_detect_ocp_structure(self):
+    # Multiple shooting problem with variables ordered as [X(:);U(:)]
+    # and the gap-closing constraints in reverse order
+    N, nx, nu = 4, 2, 1
+    X = MX.sym("X",nx,N+1)
+    U = MX.sym("U",nu,N)
+    Ad = DM([[1,0.1],[0.2,1]])
+    Bd = DM([[0.05],[0.1]])
+    g = [X[:,k+1]-mtimes(Ad,X[:,k])-mtimes(Bd,U[:,k]) for k in range(N)]
+    x = vertcat(vec(X),vec(U))
+    f = sumsqr(X)+sumsqr(U)
+    A = jacobian(vcat(g[::-1]),x).sparsity()
+    H = hessian(f,x)[0].sparsity()
+    [found,perm_x,perm_a,nxs,nus,ngs] = detect_ocp_structure(A,H)
+    self.assertTrue(found)
+    self.assertEqual(list(nxs),[3,2,2,2,2])
+    self.assertEqual(list(nus),[0,1,1,1,0])
+    self.assertEqual(list(ngs),[0]*5)
+    # Stage-wise ordered problem
+    x_ocp = vcat([vertcat(X[:,k],U[:,k]) for k in range(N)]+[X[:,N]])
+    self.assertTrue(A.sub(perm_a,perm_x)[0]==jacobian(vcat(g),x_ocp).sparsity())
+
+    # No stage structure: all variables coupled in the Hessian
+    x = MX.sym("x",3)
+    [found,perm_x,perm_a,nxs,nus,ngs] = detect_ocp_structure(jacobian(sum1(x),x).sparsity(),Sparsity.dense(3,3))
+    self.assertFalse(found)
+
+  def test_sens_reuse_factorization(self):
+    x = MX.sym("x",2)
+    p = MX.sym("p",2)
+    nlp = {"x":x,"p":p,"f":sumsqr(x-p)+x[0]*x[1],"g":x[0]+2*x[1]}
+    opts = {"qpsol":"qrqp","qpsol_options":{"print_iter":False,"print_header":False},
+            "print_header":False,"print_iteration":False,"print_time":False}
+    P = MX.sym("P",2)
+    F = []
+    for reuse in [False, True]:
+      solver = nlpsol("solver", "sqpmethod", nlp, dict(opts,sens_reuse_factorization=reuse))
+      sol = solver(x0=0,p=P,lbg=-inf,ubg=1)
+      F.append(Function("F",[P],[sol["x"],jacobian(sol["x"],P),jtimes(sol["x"],P,DM([1,-1]),True)]))
+    # Active and inactive constraint, repeated evaluations at the same solution
+    for pv in [[1,2],[1,2],[0.1,0.2],[1,2]]:
+      for r, r_ref in zip(F[1](pv),F[0](pv)):
+        self.checkarray(r,r_ref,digits=8)
+
   @requires_conic("qrqp")
   def test_regularize_sqpmethod(self):
 
@@ -2185,6 +2416,23 @@ class NLPtests(casadiTestCase):
       with self.assertInAnyOutput("Cuckoo"):
         solver_out = solver(**solver_in)
             
+  @requires_nlpsol("sqpmethod")
+  def test_nlp_hvp(self):
+    for X in [SX,MX]:
+      x = X.sym("x",2)
+      p = X.sym("p")
+      nlp = {"x":x,"p":p,"f":(1-x[0])**2+p*(x[1]-x[0]**2)**2,"g":sin(x[0]*x[1])}
+      solver = nlpsol("solver","sqpmethod",nlp,{"qpsol":"qrqp","hvp_ndir":3})
+      hvp = solver.get_function("nlp_hvp")
+      self.assertEqual(hvp.size_in(4),(2,3))
+
+      lam_f = X.sym("lam_f")
+      lam_g = X.sym("lam_g")
+      H = Function("H",[x,p,lam_f,lam_g],[hessian(lam_f*nlp["f"]+lam_g*nlp["g"],x)[0]])
+      v = DM([[1,0.3,0],[-2,0.5,1]])
+      args = [vertcat(0.3,1.7),100,0.5,2]
+      self.checkarray(hvp(*(args+[v])),mtimes(H(*args),v))
+
 if __name__ == '__main__':
     unittest.main()
     print(solvers)
@@ -939,6 +939,57 @@ class OptiStacktests(inherit_from):
       
       self.checkarray(sol2["x"],sol.value(opti.x))
       
+    def test_incremental_bake(self):
+      # All constraints at once
+      opti_ref = Opti()
+      x = opti_ref.variable()
+      y = opti_ref.variable()
+      w = opti_ref.variable()
+      z = opti_ref.variable()
+      p = opti_ref.parameter()
+      opti_ref.minimize((x-p)**2+(y-2)**2+w**2)
+      opti_ref.subject_to(x+y<=1)
+      opti_ref.subject_to(w>=y+1)
+      opti_ref.subject_to(z==x)
+      opti_ref.solver('ipopt')
+      opti_ref.set_value(p, 3)
+      sol_ref = opti_ref.solve()
+      ref = [sol_ref.value(e) for e in [x, y, w, z, opti_ref.lam_g]]
+
+      opti = Opti()
+      x = opti.variable()
+      y = opti.variable()
+      w = opti.variable()
+      p = opti.parameter()
+      opti.minimize((x-p)**2+(y-2)**2+w**2)
+      opti.subject_to(x+y<=1)
+      opti.solver('ipopt')
+      opti.set_value(p, 3)
+      sol = opti.solve()
+      stats = opti.stats()
+      self.assertIn("t_wall_opti_bake",stats)
+      self.assertIn("t_wall_opti_construct",stats)
+      self.assertIn("t_wall_opti_solve",stats)
+
+      # Parameter changes and identical calls keep the baked problem and the solver
+      opti.set_value(p, 2)
+      opti.minimize(opti.f)
+      opti.solver('ipopt')
+      sol = opti.solve()
+      stats = opti.stats()
+      self.assertNotIn("t_wall_opti_bake",stats)
+      self.assertNotIn("t_wall_opti_construct",stats)
+      opti.set_value(p, 3)
+
+      # Appended constraints, activating a new variable
+      opti.subject_to(w>=y+1)
+      z = opti.variable()
+      opti.subject_to(z==x)
+      sol = opti.solve()
+      self.assertEqual(opti.nx,4)
+      for e, r in zip([x, y, w, z, opti.lam_g], ref):
+        self.checkarray(sol.value(e),r,digits=7)
+
     def test_max_iter(self):
       opti = Opti()
       x = opti.variable()
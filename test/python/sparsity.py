@@ -567,6 +567,23 @@ class Sparsitytests(casadiTestCase):
         self.assertTrue(L.is_subset(R))
         self.assertFalse(R.is_subset(L))
 
+  def test_nested_dissection(self):
+      # 2D grid Laplacian
+      N = 30
+      L1 = Sparsity.banded(N,1)
+      I = Sparsity.diag(N)
+      A = kron(L1,I)+kron(I,L1)
+      for sp in [A, diagcat(A,Sparsity.diag(5),A), Sparsity.diag(4), Sparsity.dense(3,3)]:
+        p = sp.nested_dissection()
+        self.assertEqual(sorted(p),list(range(sp.size1())))
+      # Less fill-in than AMD on a mesh
+      Lt_amd = A.ldl(True)[0]
+      p = A.nested_dissection()
+      Lt_nd = A.sub(p,p)[0].ldl(False)[0]
+      self.assertTrue(Lt_nd.nnz()<=Lt_amd.nnz())
+      with self.assertRaises(Exception):
+        Sparsity.banded(4,1)[:,:3].nested_dissection()
+
 
 
 if __name__ == '__main__':
@@ -1539,6 +1539,79 @@ class SXtests(casadiTestCase):
 
     self.checkarray(logsumexp(vertcat(100,1000,10000)),f(vertcat(100,1000,10000)))
 
+  def test_numeric_reverse(self):
+    x = SX.sym("x",3)
+    p = SX.sym("p",2)
+    e = vertcat(sin(x[0])*x[1]**2+p[0],exp(x[2])/x[0],if_else(x[1]>0,x[2]*p[1],x[0]),fmax(x[0],x[2]))
+
+    f_ref = Function("f",[x,p],[e,sumsqr(x)])
+    f = Function("f",[x,p],[e,sumsqr(x)],{"numeric_reverse":True})
+
+    fr = f.reverse(2)
+    self.assertTrue(fr.is_a("SXReverse"))
+    self.assertEqual(fr.name(),"adj2_f")
+
+    inputs = [vertcat(1.1,-1.3,0.7),vertcat(0.3,2)]
+    self.checkfunction(f,f_ref,inputs=inputs)
+    for i in [vertcat(1.1,1.3,0.7),vertcat(0.7,-1.3,1.1)]:
+      self.checkfunction(f.reverse(3),f_ref.reverse(3),inputs=[i,inputs[1],DM.zeros(4,1),0,DM.rand(4,3),DM.rand(1,3)],hessian=False)
+
+  def test_taylor(self):
+    x = SX.sym("x",2)
+    ops = [lambda x: sin(x[0])*x[1]**2, lambda x: exp(x[0]*x[1]), lambda x: log(x[0])/x[1],
+           lambda x: sqrt(x[0])+tan(x[1]), lambda x: atan2(x[0],x[1]), lambda x: x[0]**x[1],
+           lambda x: x[0]**3.5+x[1]**2, lambda x: cosh(x[0])*tanh(x[1]), lambda x: erf(x[0])+asin(x[1]/3),
+           lambda x: acos(x[1]/3)*atan(x[0])+asinh(x[0])+atanh(x[1]/3), lambda x: hypot(x[0],x[1])+fmax(x[0],x[1])]
+    x0 = vertcat(0.7,1.3)
+    v = vertcat(0.3,-0.4)
+    order = 4
+    for op in ops:
+      f = Function("f",[x],[op(x)])
+      ft = f.taylor(order)
+      self.assertTrue(ft.is_a("SXTaylor"))
+      self.assertEqual(ft.size_in(0),(2,order+1))
+
+      # Reference: derivatives along the line x0 + t*v
+      t = SX.sym("t")
+      e = op(x0+t*v)
+      ref = []
+      fact = 1
+      for k in range(order+1):
+        ref.append(substitute(e,t,0)/fact)
+        e = jacobian(e,t)
+        fact *= k+1
+      ref = evalf(horzcat(*ref))
+
+      self.checkarray(ft(horzcat(x0,v,DM.zeros(2,order-1))),ref,digits=8)
+
+    # MX functions are expanded
+    f = Function("f",[x],[ops[0](x)])
+    self.assertEqual(f.taylor(3).name(),"taylor3_f")
+    xm = MX.sym("x",2)
+    fm = Function("fm",[xm],[f(xm)])
+    c = horzcat(x0,v,DM.zeros(2,2))
+    self.checkarray(fm.taylor(3)(c),f.taylor(3)(c))
+
+  def test_hash_consing(self):
+    x = SX.sym("x")
+    y = SX.sym("y")
+    GlobalOptions.setHashConsing(True)
+    try:
+      a = sin(x)*y
+      b = y*sin(x)
+      # Identical nodes, not just equal expressions
+      self.assertTrue(is_equal(a,b,0))
+      self.assertTrue(is_equal(cos(a)+1,cos(b)+1,0))
+      e = 0
+      for i in range(10):
+        e += sin(x*y)**2
+      f = Function("f",[x,y],[e])
+      self.assertTrue(f.n_instructions()<20)
+      self.checkarray(f(0.3,0.7),10*sin(0.21)**2)
+    finally:
+      GlobalOptions.setHashConsing(False)
+    self.assertFalse(is_equal(sin(x)*y,sin(x)*y,0))
+
 
 if __name__ == '__main__':
     unittest.main()